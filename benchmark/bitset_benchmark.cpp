@@ -0,0 +1,236 @@
+/*
+ * Copyright (C) 2023 Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "../include/mimir/formalism/bitset.hpp"
+#include "../include/mimir/formalism/fixed_bitset.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Micro-benchmarks of the operations used by apply and is_applicable, comparing Bitset with FixedBitset.
+
+namespace
+{
+    constexpr std::size_t pool_size = 1024;
+
+    std::size_t checksum = 0;
+
+    template<typename Function>
+    double measure(std::size_t iterations, Function&& function)
+    {
+        const auto start_time = std::chrono::high_resolution_clock::now();
+
+        for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            checksum += function(iteration % pool_size);
+        }
+
+        const auto end_time = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::nano>(end_time - start_time).count() / static_cast<double>(iterations);
+    }
+
+    void report(const std::string& operation, std::size_t num_words, double bitset_time, double fixed_bitset_time)
+    {
+        std::cout << std::left << std::setw(12) << operation << std::right << std::setw(8) << num_words << std::setw(14) << std::fixed << std::setprecision(2)
+                  << bitset_time << std::setw(14) << fixed_bitset_time << std::setw(10) << (bitset_time / fixed_bitset_time) << "x" << std::endl;
+    }
+
+    void run(std::size_t num_words, std::size_t iterations, std::mt19937_64& random)
+    {
+        const auto num_bits = num_words * mimir::formalism::FixedBitset::block_size;
+        std::bernoulli_distribution sparse(0.05);
+        std::bernoulli_distribution dense(0.5);
+
+        std::vector<mimir::formalism::Bitset> states, preconditions, negative_preconditions, add_effects, delete_effects;
+        std::vector<mimir::formalism::FixedBitset> fixed_states, fixed_preconditions, fixed_negative_preconditions, fixed_add_effects, fixed_delete_effects;
+
+        for (std::size_t index = 0; index < pool_size; ++index)
+        {
+            mimir::formalism::Bitset state(num_bits - 1), precondition(num_bits - 1), negative_precondition(num_bits - 1, true), add_effect(num_bits - 1),
+                delete_effect(num_bits - 1, true);
+            mimir::formalism::FixedBitset fixed_state(num_bits), fixed_precondition(num_bits), fixed_negative_precondition(num_bits), fixed_add_effect(num_bits),
+                fixed_delete_effect(num_bits);
+
+            for (std::size_t position = 0; position < num_bits; ++position)
+            {
+                if (dense(random))
+                {
+                    state.set(position);
+                    fixed_state.set(position);
+                }
+
+                // Make half of the preconditions hold so that the comparisons do not always exit early
+                if (sparse(random) && (state.get(position) || (index % 2)))
+                {
+                    precondition.set(position);
+                    fixed_precondition.set(position);
+                }
+
+                if (sparse(random) && !state.get(position))
+                {
+                    negative_precondition.unset(position);
+                    fixed_negative_precondition.set(position);
+                }
+
+                if (sparse(random))
+                {
+                    add_effect.set(position);
+                    fixed_add_effect.set(position);
+                }
+
+                if (sparse(random))
+                {
+                    delete_effect.unset(position);
+                    fixed_delete_effect.set(position);
+                }
+            }
+
+            states.emplace_back(std::move(state));
+            preconditions.emplace_back(std::move(precondition));
+            negative_preconditions.emplace_back(std::move(negative_precondition));
+            add_effects.emplace_back(std::move(add_effect));
+            delete_effects.emplace_back(std::move(delete_effect));
+            fixed_states.emplace_back(std::move(fixed_state));
+            fixed_preconditions.emplace_back(std::move(fixed_precondition));
+            fixed_negative_preconditions.emplace_back(std::move(fixed_negative_precondition));
+            fixed_add_effects.emplace_back(std::move(fixed_add_effect));
+            fixed_delete_effects.emplace_back(std::move(fixed_delete_effect));
+        }
+
+        auto scratch = states.front();
+        auto fixed_scratch = fixed_states.front();
+
+        report("or",
+               num_words,
+               measure(iterations,
+                       [&](std::size_t index)
+                       {
+                           scratch |= add_effects[index];
+                           return scratch.get(0);
+                       }),
+               measure(iterations,
+                       [&](std::size_t index)
+                       {
+                           fixed_scratch |= fixed_add_effects[index];
+                           return fixed_scratch.get(0);
+                       }));
+
+        report("delete",
+               num_words,
+               measure(iterations,
+                       [&](std::size_t index)
+                       {
+                           scratch &= delete_effects[index];
+                           return scratch.get(0);
+                       }),
+               measure(iterations,
+                       [&](std::size_t index)
+                       {
+                           fixed_scratch.andnot(fixed_delete_effects[index]);
+                           return fixed_scratch.get(0);
+                       }));
+
+        report("equal",
+               num_words,
+               measure(iterations, [&](std::size_t index) { return states[index] == states[(index + 1) % pool_size]; }),
+               measure(iterations, [&](std::size_t index) { return fixed_states[index] == fixed_states[(index + 1) % pool_size]; }));
+
+        report("subset",
+               num_words,
+               measure(iterations, [&](std::size_t index) { return states[index] == (states[index] | preconditions[index]); }),
+               measure(iterations, [&](std::size_t index) { return fixed_preconditions[index].is_subset_of(fixed_states[index]); }));
+
+        report("applicable",
+               num_words,
+               measure(iterations,
+                       [&](std::size_t index)
+                       {
+                           auto bitset = states[index];
+                           bitset |= preconditions[index];
+                           bitset &= negative_preconditions[index];
+                           return states[index] == bitset;
+                       }),
+               measure(iterations,
+                       [&](std::size_t index)
+                       {
+                           return fixed_preconditions[index].is_subset_of(fixed_states[index])
+                                  && !fixed_negative_preconditions[index].intersects(fixed_states[index]);
+                       }));
+
+        report("popcount",
+               num_words,
+               measure(iterations,
+                       [&](std::size_t index)
+                       {
+                           std::size_t count = 0;
+
+                           for (auto position = states[index].next_set_bit(0); position != mimir::formalism::Bitset::no_position;
+                                position = states[index].next_set_bit(position + 1))
+                           {
+                               ++count;
+                           }
+
+                           return count;
+                       }),
+               measure(iterations, [&](std::size_t index) { return fixed_states[index].count(); }));
+
+        report("apply",
+               num_words,
+               measure(iterations,
+                       [&](std::size_t index)
+                       {
+                           auto bitset = states[index];
+                           bitset &= delete_effects[index];
+                           bitset |= add_effects[index];
+                           return bitset.get(0);
+                       }),
+               measure(iterations,
+                       [&](std::size_t index)
+                       {
+                           mimir::formalism::kernels::apply_effect(fixed_states[index].data(),
+                                                                   fixed_delete_effects[index].data(),
+                                                                   fixed_add_effects[index].data(),
+                                                                   fixed_scratch.data(),
+                                                                   num_words);
+                           return fixed_scratch.get(0);
+                       }));
+    }
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    const std::size_t iterations = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+    std::mt19937_64 random(0);
+
+    std::cout << "Kernels: " << mimir::formalism::kernels::instruction_set() << std::endl;
+    std::cout << std::left << std::setw(12) << "operation" << std::right << std::setw(8) << "words" << std::setw(14) << "Bitset [ns]" << std::setw(14)
+              << "Fixed [ns]" << std::setw(11) << "speedup" << std::endl;
+
+    for (const auto num_words : { 1, 2, 4, 8, 16, 64 })
+    {
+        run(num_words, iterations, random);
+    }
+
+    std::cout << "Checksum: " << checksum << std::endl;
+    return 0;
+}
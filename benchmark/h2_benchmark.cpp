@@ -0,0 +1,357 @@
+/*
+ * Copyright (C) 2023 Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "../include/mimir/generators/grounded_successor_generator.hpp"
+#include "../include/mimir/generators/successor_generator_factory.hpp"
+#include "../include/mimir/pddl/parsers.hpp"
+#include "../include/mimir/search/heuristics/h2_heuristic.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <unordered_set>
+#include <vector>
+
+// Compares the memory usage and the evaluation time of the h^2 heuristic with the previous implementation, which kept a dense table of doubles
+// and the complement of the delete effects of every action. The states are the first states found by a breadth-first search from the initial
+// state, so that the heuristic with pruned mutex pairs is defined for them.
+
+namespace
+{
+    class LegacyH2Heuristic
+    {
+      private:
+        using InternalAction = std::tuple<std::vector<int32_t>, std::vector<int32_t>, std::vector<int32_t>, double>;
+
+        mimir::formalism::ProblemDescription problem_;
+        std::vector<InternalAction> actions_;
+        std::vector<int32_t> goal_;
+        mutable std::vector<double> h1_table_;
+        mutable std::vector<std::vector<double>> h2_table_;
+
+        double eval(const std::vector<int32_t>& ranks) const
+        {
+            double v = 0;
+
+            for (std::size_t i = 0; i < ranks.size(); i++)
+            {
+                v = std::max(v, h1_table_[ranks[i]]);
+
+                for (std::size_t j = i + 1; j < ranks.size(); j++)
+                {
+                    v = std::max(v, h2_table_[ranks[i]][ranks[j]]);
+                }
+
+                if (std::isinf(v))
+                {
+                    return v;
+                }
+            }
+
+            return v;
+        }
+
+        double eval(const std::vector<int32_t>& ranks, int32_t rank) const
+        {
+            double v = h1_table_[rank];
+
+            for (std::size_t i = 0; (i < ranks.size()) && !std::isinf(v); i++)
+            {
+                if (rank != ranks[i])
+                {
+                    v = std::max(v, h2_table_[rank][ranks[i]]);
+                }
+            }
+
+            return v;
+        }
+
+        void update(int32_t rank, double value, bool& changed) const
+        {
+            if (h1_table_[rank] > value)
+            {
+                h1_table_[rank] = value;
+                changed = true;
+            }
+        }
+
+        void update(int32_t rank1, int32_t rank2, double value, bool& changed) const
+        {
+            if (h2_table_[rank1][rank2] > value)
+            {
+                h2_table_[rank1][rank2] = value;
+                h2_table_[rank2][rank1] = value;
+                changed = true;
+            }
+        }
+
+      public:
+        LegacyH2Heuristic(const mimir::formalism::ProblemDescription& problem, const mimir::formalism::ActionList& actions) :
+            problem_(problem),
+            actions_(),
+            goal_(),
+            h1_table_(problem->num_ranks()),
+            h2_table_(problem->num_ranks(), std::vector<double>(problem->num_ranks()))
+        {
+            const auto num_ranks = static_cast<int32_t>(problem->num_ranks());
+
+            for (const auto& literal : problem->goal)
+            {
+                goal_.push_back(problem->get_rank(literal->atom));
+            }
+
+            for (const auto& action : actions)
+            {
+                std::vector<int32_t> precondition;
+                std::vector<int32_t> add_effect;
+                std::vector<int32_t> delete_effect;
+                std::vector<int32_t> delete_effect_complement;
+
+                for (const auto& literal : action->get_precondition())
+                {
+                    if (!literal->negated)
+                    {
+                        precondition.emplace_back(problem->get_rank(literal->atom));
+                    }
+                }
+
+                auto effects = action->get_unconditional_effect();
+
+                for (const auto& [antecedent, consequence] : action->get_conditional_effect())
+                {
+                    effects.insert(effects.end(), consequence.begin(), consequence.end());
+                }
+
+                for (const auto& literal : effects)
+                {
+                    (literal->negated ? delete_effect : add_effect).emplace_back(problem->get_rank(literal->atom));
+                }
+
+                for (int32_t rank = 0; rank < num_ranks; ++rank)
+                {
+                    if (std::find(delete_effect.begin(), delete_effect.end(), rank) == delete_effect.end())
+                    {
+                        delete_effect_complement.emplace_back(rank);
+                    }
+                }
+
+                actions_.emplace_back(precondition, add_effect, delete_effect_complement, action->cost);
+            }
+        }
+
+        double evaluate(const mimir::formalism::State& state) const
+        {
+            const auto infinity = std::numeric_limits<double>::infinity();
+            std::fill(h1_table_.begin(), h1_table_.end(), infinity);
+
+            for (auto& row : h2_table_)
+            {
+                std::fill(row.begin(), row.end(), infinity);
+            }
+
+            std::vector<int32_t> state_ids;
+
+            for (const auto& atom : state->get_atoms())
+            {
+                state_ids.emplace_back(problem_->get_rank(atom));
+            }
+
+            for (const auto rank1 : state_ids)
+            {
+                h1_table_[rank1] = 0;
+
+                for (const auto rank2 : state_ids)
+                {
+                    h2_table_[rank1][rank2] = 0;
+                }
+            }
+
+            bool changed;
+
+            do
+            {
+                changed = false;
+
+                for (const auto& [precondition, add_effect, delete_effect_complement, cost] : actions_)
+                {
+                    const auto cost1 = eval(precondition);
+
+                    if (std::isinf(cost1))
+                    {
+                        continue;
+                    }
+
+                    for (std::size_t i = 0; i < add_effect.size(); i++)
+                    {
+                        const auto rank1 = add_effect[i];
+                        update(rank1, cost1 + cost, changed);
+
+                        for (std::size_t j = i + 1; j < add_effect.size(); j++)
+                        {
+                            if (rank1 != add_effect[j])
+                            {
+                                update(rank1, add_effect[j], cost1 + cost, changed);
+                            }
+                        }
+
+                        for (const auto rank2 : delete_effect_complement)
+                        {
+                            const auto cost2 = std::max(cost1, eval(precondition, rank2));
+
+                            if (!std::isinf(cost2))
+                            {
+                                update(rank1, rank2, cost2 + cost, changed);
+                            }
+                        }
+                    }
+                }
+            } while (changed);
+
+            return eval(goal_);
+        }
+
+        std::size_t get_memory_usage() const
+        {
+            std::size_t bytes = h1_table_.capacity() * sizeof(double) + h2_table_.capacity() * sizeof(std::vector<double>);
+
+            for (const auto& row : h2_table_)
+            {
+                bytes += row.capacity() * sizeof(double);
+            }
+
+            for (const auto& [precondition, add_effect, delete_effect_complement, cost] : actions_)
+            {
+                bytes += sizeof(InternalAction)
+                         + (precondition.capacity() + add_effect.capacity() + delete_effect_complement.capacity()) * sizeof(int32_t);
+            }
+
+            return bytes;
+        }
+    };
+
+    std::vector<mimir::formalism::State> get_states(const mimir::formalism::ProblemDescription& problem,
+                                                    const mimir::planners::SuccessorGenerator& successor_generator,
+                                                    std::size_t num_states)
+    {
+        const auto initial_state = mimir::formalism::create_state(problem->initial, problem);
+        std::vector<mimir::formalism::State> states { initial_state };
+        std::unordered_set<mimir::formalism::State> closed { initial_state };
+
+        for (std::size_t index = 0; (index < states.size()) && (states.size() < num_states); ++index)
+        {
+            for (const auto& action : successor_generator->get_applicable_actions(states[index]))
+            {
+                const auto successor_state = mimir::formalism::apply(action, states[index]);
+
+                if ((states.size() < num_states) && closed.insert(successor_state).second)
+                {
+                    states.emplace_back(successor_state);
+                }
+            }
+        }
+
+        return states;
+    }
+
+    template<typename Heuristic>
+    double measure(const Heuristic& heuristic, const std::vector<mimir::formalism::State>& states, std::vector<double>& out_values)
+    {
+        out_values.clear();
+        const auto start_time = std::chrono::high_resolution_clock::now();
+
+        for (const auto& state : states)
+        {
+            out_values.emplace_back(heuristic.evaluate(state));
+        }
+
+        const auto end_time = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::micro>(end_time - start_time).count() / states.size();
+    }
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3)
+    {
+        std::cout << "h2_benchmark <Domain> <Problem> [<Number of states>]" << std::endl;
+        return 1;
+    }
+
+    const std::size_t num_states = (argc > 3) ? std::strtoull(argv[3], nullptr, 10) : 100;
+
+    mimir::parsers::DomainParser domain_parser(argv[1]);
+    const auto domain = domain_parser.parse();
+    mimir::parsers::ProblemParser problem_parser(argv[2]);
+    const auto problem = problem_parser.parse(domain);
+
+    const auto successor_generator = mimir::planners::create_sucessor_generator(problem, mimir::planners::SuccessorGeneratorType::GROUNDED);
+    const auto& actions = std::static_pointer_cast<mimir::planners::GroundedSuccessorGenerator>(successor_generator)->get_actions();
+    const auto states = get_states(problem, successor_generator, num_states);
+
+    std::cout << "Number of ground actions: " << actions.size() << std::endl;
+    std::cout << "Number of atoms: " << problem->num_ranks() << std::endl;
+    std::cout << "Number of static atoms: " << problem->get_static_atoms().size() << std::endl;
+    std::cout << "Number of states: " << states.size() << std::endl << std::endl;
+
+    const LegacyH2Heuristic legacy_h2(problem, actions);
+    const auto h2 = mimir::planners::create_h2_heuristic(problem, successor_generator);
+    const auto pruned_h2 = mimir::planners::create_h2_heuristic(problem, successor_generator, true);
+
+    std::vector<double> legacy_values;
+    std::vector<double> values;
+    std::vector<double> pruned_values;
+    const auto legacy_time = measure(legacy_h2, states, legacy_values);
+    const auto time = measure(*h2, states, values);
+    const auto pruned_time = measure(*pruned_h2, states, pruned_values);
+
+    for (std::size_t index = 0; index < states.size(); ++index)
+    {
+        // The tables of the new implementation hold floats, so non-integer costs may differ in the last bits
+
+        if ((std::abs(legacy_values[index] - values[index]) > 1e-4 * std::max(1.0, std::abs(legacy_values[index])))
+            && !(std::isinf(legacy_values[index]) && std::isinf(values[index])))
+        {
+            std::cerr << "Error: the implementations computed different values" << std::endl;
+            return 1;
+        }
+
+        if (pruned_values[index] < values[index])
+        {
+            std::cerr << "Error: pruning the mutex pairs decreased a value" << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << std::setw(10) << "variant" << std::setw(14) << "table size" << std::setw(14) << "memory [kB]" << std::setw(14) << "eval [us]"
+              << std::setw(10) << "speedup" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::setw(10) << "legacy" << std::setw(14) << (static_cast<std::size_t>(problem->num_ranks()) * problem->num_ranks()) << std::setw(14)
+              << (legacy_h2.get_memory_usage() / 1024.0) << std::setw(14) << legacy_time << std::setw(9) << 1.0 << "x" << std::endl;
+    std::cout << std::setw(10) << "packed" << std::setw(14) << h2->get_table_size() << std::setw(14) << (h2->get_memory_usage() / 1024.0) << std::setw(14)
+              << time << std::setw(9) << (legacy_time / time) << "x" << std::endl;
+    std::cout << std::setw(10) << "pruned" << std::setw(14) << pruned_h2->get_table_size() << std::setw(14) << (pruned_h2->get_memory_usage() / 1024.0)
+              << std::setw(14) << pruned_time << std::setw(9) << (legacy_time / pruned_time) << "x" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,300 @@
+/*
+ * Copyright (C) 2023 Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "../include/mimir/algorithms/kpkc.hpp"
+
+#include <algorithm>
+#include <boost/dynamic_bitset.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+// Compares the k-partite clique enumerator with the previous implementation. The graphs mimic the general case of the lifted successor generator: one
+// partition per action parameter, one vertex per type-compatible object, and sparse edges between assignments that are consistent with the state.
+
+namespace
+{
+    // The previous implementation, which was part of the library until the enumerator replaced it
+
+    bool find_all_k_cliques_in_k_partite_graph_helper(const std::chrono::high_resolution_clock::time_point end_time,
+                                                      const std::vector<boost::dynamic_bitset<>>& adjacency_matrix,
+                                                      const std::vector<std::vector<size_t>>& partitions,
+                                                      std::vector<boost::dynamic_bitset<>>& compatible_vertices,
+                                                      boost::dynamic_bitset<>& partition_bits,
+                                                      boost::dynamic_bitset<>& not_partition_bits,  // TODO: Check if !partition_bits[i] is better...
+                                                      std::vector<size_t>& partial_solution,
+                                                      std::vector<std::vector<std::size_t>>& out_cliques)
+    {
+        if (std::chrono::high_resolution_clock::now() > end_time)
+        {
+            return false;
+        }
+
+        size_t k = partitions.size();
+        size_t best_set_bits = std::numeric_limits<size_t>::max();
+        size_t best_partition = std::numeric_limits<size_t>::max();
+
+        // Find the best partition to work with
+        for (size_t partition = 0; partition < k; ++partition)
+        {
+            const auto num_set_bits = compatible_vertices[partition].count();
+
+            if (not_partition_bits[partition] && (num_set_bits < best_set_bits))
+            {
+                best_set_bits = num_set_bits;
+                best_partition = partition;
+            }
+        }
+
+        size_t adjacent_index = compatible_vertices[best_partition].find_first();
+
+        // Iterate through compatible vertices in the best partition
+        while (adjacent_index < compatible_vertices[best_partition].size())
+        {
+            if (std::chrono::high_resolution_clock::now() > end_time)
+            {
+                return false;
+            }
+
+            size_t vertex = partitions[best_partition][adjacent_index];
+            compatible_vertices[best_partition][adjacent_index] = 0;
+            partial_solution.push_back(vertex);
+
+            if (partial_solution.size() == k)
+            {
+                out_cliques.push_back(partial_solution);
+            }
+            else
+            {
+                // Update compatible vertices for the next recursion
+                std::vector<boost::dynamic_bitset<>> compatible_vertices_next = compatible_vertices;
+                size_t offset = 0;
+                for (size_t partition = 0; partition < k; ++partition)
+                {
+                    const auto partition_size = compatible_vertices_next[partition].size();
+                    if (not_partition_bits[partition])
+                    {
+                        for (size_t index = 0; index < partition_size; ++index)
+                        {
+                            compatible_vertices_next[partition][index] &= adjacency_matrix[vertex][index + offset];
+                        }
+                    }
+                    offset += partition_size;
+                }
+
+                partition_bits[best_partition] = 1;
+                not_partition_bits[best_partition] = 0;
+
+                size_t possible_additions = 0;
+                for (size_t partition = 0; partition < k; ++partition)
+                {
+                    if (not_partition_bits[partition] && compatible_vertices[partition].any())
+                    {
+                        ++possible_additions;
+                    }
+                }
+
+                if ((partial_solution.size() + possible_additions) == k)
+                {
+                    if (!find_all_k_cliques_in_k_partite_graph_helper(end_time,
+                                                                      adjacency_matrix,
+                                                                      partitions,
+                                                                      compatible_vertices_next,
+                                                                      partition_bits,
+                                                                      not_partition_bits,
+                                                                      partial_solution,
+                                                                      out_cliques))
+                    {
+                        return false;
+                    }
+                }
+
+                partition_bits[best_partition] = 0;
+                not_partition_bits[best_partition] = 1;
+            }
+
+            partial_solution.pop_back();
+            adjacent_index = compatible_vertices[best_partition].find_next(adjacent_index);
+        }
+
+        return true;
+    }
+
+    bool find_all_k_cliques_in_k_partite_graph(const std::chrono::high_resolution_clock::time_point end_time,
+                                               const std::vector<boost::dynamic_bitset<>>& adjacency_matrix,
+                                               const std::vector<std::vector<size_t>>& partitions,
+                                               std::vector<std::vector<std::size_t>>& out_cliques)
+    {
+        std::vector<boost::dynamic_bitset<>> compatible_vertices;
+
+        for (std::size_t index = 0; index < partitions.size(); ++index)
+        {
+            boost::dynamic_bitset<> bitset(partitions[index].size());
+            bitset.set();
+            compatible_vertices.push_back(std::move(bitset));
+        }
+
+        const size_t k = partitions.size();
+        boost::dynamic_bitset<> partition_bits(k);
+        boost::dynamic_bitset<> not_partition_bits(k);
+        partition_bits.reset();
+        not_partition_bits.set();
+        std::vector<size_t> partial_solution;
+
+        const auto finished = find_all_k_cliques_in_k_partite_graph_helper(end_time,
+                                                                           adjacency_matrix,
+                                                                           partitions,
+                                                                           compatible_vertices,
+                                                                           partition_bits,
+                                                                           not_partition_bits,
+                                                                           partial_solution,
+                                                                           out_cliques);
+
+        return finished;
+    }
+
+    struct Workload
+    {
+        std::size_t num_parameters;
+        std::size_t num_objects;
+        double edge_probability;
+    };
+
+    std::vector<std::vector<std::size_t>> sort_cliques(std::vector<std::vector<std::size_t>> cliques)
+    {
+        for (auto& clique : cliques)
+        {
+            std::sort(clique.begin(), clique.end());
+        }
+
+        std::sort(cliques.begin(), cliques.end());
+        return cliques;
+    }
+
+    void run(const Workload& workload, std::size_t num_graphs, std::mt19937_64& random)
+    {
+        std::vector<std::vector<std::size_t>> partitions;
+        std::size_t num_vertices = 0;
+
+        for (std::size_t parameter = 0; parameter < workload.num_parameters; ++parameter)
+        {
+            std::vector<std::size_t> partition;
+
+            for (std::size_t object = 0; object < workload.num_objects; ++object)
+            {
+                partition.push_back(num_vertices++);
+            }
+
+            partitions.push_back(std::move(partition));
+        }
+
+        std::bernoulli_distribution has_edge(workload.edge_probability);
+        const auto no_time_limit = std::chrono::high_resolution_clock::time_point::max();
+        mimir::algorithms::KPartiteCliqueEnumerator enumerator(partitions);
+        mimir::algorithms::FlatAdjacencyMatrix flat_matrix(num_vertices);
+        double old_time = 0.0;
+        double new_time = 0.0;
+        std::size_t num_cliques = 0;
+
+        for (std::size_t graph = 0; graph < num_graphs; ++graph)
+        {
+            std::vector<std::pair<std::size_t, std::size_t>> edges;
+
+            for (std::size_t first_vertex = 0; first_vertex < num_vertices; ++first_vertex)
+            {
+                for (std::size_t second_vertex = first_vertex + 1; second_vertex < num_vertices; ++second_vertex)
+                {
+                    if (((first_vertex / workload.num_objects) != (second_vertex / workload.num_objects)) && has_edge(random))
+                    {
+                        edges.emplace_back(first_vertex, second_vertex);
+                    }
+                }
+            }
+
+            // Both implementations include building the adjacency matrix, as in the general case
+
+            std::vector<std::vector<std::size_t>> old_cliques;
+            auto start_time = std::chrono::high_resolution_clock::now();
+            std::vector<boost::dynamic_bitset<>> adjacency_matrix(num_vertices, boost::dynamic_bitset<>(num_vertices));
+
+            for (const auto& [first_vertex, second_vertex] : edges)
+            {
+                adjacency_matrix[first_vertex][second_vertex] = 1;
+                adjacency_matrix[second_vertex][first_vertex] = 1;
+            }
+
+            find_all_k_cliques_in_k_partite_graph(no_time_limit, adjacency_matrix, partitions, old_cliques);
+            auto end_time = std::chrono::high_resolution_clock::now();
+            old_time += std::chrono::duration<double, std::micro>(end_time - start_time).count();
+
+            std::vector<std::vector<std::size_t>> new_cliques;
+            start_time = std::chrono::high_resolution_clock::now();
+            flat_matrix.clear();
+
+            for (const auto& [first_vertex, second_vertex] : edges)
+            {
+                flat_matrix.add_edge(first_vertex, second_vertex);
+            }
+
+            enumerator.enumerate(no_time_limit,
+                                 flat_matrix,
+                                 [&new_cliques](const std::vector<std::size_t>& clique)
+                                 {
+                                     new_cliques.push_back(clique);
+                                     return true;
+                                 });
+            end_time = std::chrono::high_resolution_clock::now();
+            new_time += std::chrono::duration<double, std::micro>(end_time - start_time).count();
+
+            if (sort_cliques(old_cliques) != sort_cliques(new_cliques))
+            {
+                std::cerr << "Error: the implementations found different cliques" << std::endl;
+                std::exit(1);
+            }
+
+            num_cliques += new_cliques.size();
+        }
+
+        std::cout << std::setw(6) << workload.num_parameters << std::setw(9) << workload.num_objects << std::setw(9) << std::fixed << std::setprecision(3)
+                  << workload.edge_probability << std::setw(10) << (num_cliques / num_graphs) << std::setw(14) << std::setprecision(2) << (old_time / num_graphs)
+                  << std::setw(14) << (new_time / num_graphs) << std::setw(10) << (old_time / new_time) << "x" << std::endl;
+    }
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    const std::size_t num_graphs = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 20;
+    std::mt19937_64 random(0);
+
+    const std::vector<Workload> workloads = { { 2, 20, 0.1 },  { 2, 100, 0.02 }, { 2, 300, 0.01 }, { 3, 20, 0.2 },
+                                              { 3, 100, 0.05 }, { 3, 300, 0.01 }, { 4, 30, 0.2 },   { 4, 100, 0.05 } };
+
+    std::cout << std::setw(6) << "k" << std::setw(9) << "objects" << std::setw(9) << "density" << std::setw(10) << "cliques" << std::setw(14) << "old [us]"
+              << std::setw(14) << "new [us]" << std::setw(11) << "speedup" << std::endl;
+
+    for (const auto& workload : workloads)
+    {
+        run(workload, num_graphs, random);
+    }
+
+    return 0;
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2023 Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "../include/mimir/formalism/atom.hpp"
+#include "../include/mimir/formalism/domain.hpp"
+#include "../include/mimir/formalism/object.hpp"
+#include "../include/mimir/formalism/predicate.hpp"
+#include "../include/mimir/formalism/problem.hpp"
+#include "../include/mimir/formalism/type.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Measures the throughput of the atom rank registry of a problem when several threads rank atoms at once: inserting atoms that were not seen
+// before, looking up atoms that are not created by the problem (so they have to be hashed) before and after freezing the ranks, and creating
+// atoms through the problem.
+
+namespace
+{
+    mimir::formalism::ProblemDescription create_benchmark_problem(std::size_t num_objects, mimir::formalism::Predicate& out_predicate)
+    {
+        const auto type = mimir::formalism::create_type("object");
+        const auto first_parameter = mimir::formalism::create_object(0, "?x", type);
+        const auto second_parameter = mimir::formalism::create_object(1, "?y", type);
+        out_predicate = mimir::formalism::create_predicate(0, "edge", { first_parameter, second_parameter });
+        const auto domain = mimir::formalism::create_domain("benchmark", {}, { type }, {}, { out_predicate }, {}, {});
+        mimir::formalism::ObjectList objects;
+
+        for (std::size_t object_id = 0; object_id < num_objects; ++object_id)
+        {
+            objects.emplace_back(mimir::formalism::create_object(static_cast<uint32_t>(object_id), "o" + std::to_string(object_id), type));
+        }
+
+        return mimir::formalism::create_problem("benchmark", domain, objects, {}, {}, {});
+    }
+
+    // Runs the function on every thread with its own shuffled order of the atoms and returns the number of operations per microsecond
+
+    double run_threads(std::size_t num_threads, std::size_t num_atoms, const std::function<void(std::size_t)>& function)
+    {
+        std::vector<std::vector<std::size_t>> orders(num_threads, std::vector<std::size_t>(num_atoms));
+
+        for (std::size_t thread_index = 0; thread_index < num_threads; ++thread_index)
+        {
+            std::iota(orders[thread_index].begin(), orders[thread_index].end(), 0);
+            std::shuffle(orders[thread_index].begin(), orders[thread_index].end(), std::mt19937_64(thread_index));
+        }
+
+        std::vector<std::thread> threads;
+        const auto start_time = std::chrono::high_resolution_clock::now();
+
+        for (std::size_t thread_index = 0; thread_index < num_threads; ++thread_index)
+        {
+            threads.emplace_back(
+                [&function, &orders, thread_index]()
+                {
+                    for (const auto atom_index : orders[thread_index])
+                    {
+                        function(atom_index);
+                    }
+                });
+        }
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        const auto end_time = std::chrono::high_resolution_clock::now();
+        return (num_threads * num_atoms) / std::chrono::duration<double, std::micro>(end_time - start_time).count();
+    }
+
+    void run(std::size_t num_objects, std::size_t num_threads)
+    {
+        mimir::formalism::Predicate predicate;
+        const auto problem = create_benchmark_problem(num_objects, predicate);
+
+        // Atoms that are not created by the problem carry no rank, so every lookup hashes them
+
+        const auto create_atoms = [&problem, &predicate]()
+        {
+            mimir::formalism::AtomList atoms;
+
+            for (const auto& first_object : problem->objects)
+            {
+                for (const auto& second_object : problem->objects)
+                {
+                    atoms.emplace_back(mimir::formalism::create_atom(predicate, { first_object, second_object }));
+                }
+            }
+
+            return atoms;
+        };
+
+        const auto atoms = create_atoms();
+        const auto insert = run_threads(num_threads, atoms.size(), [&problem, &atoms](std::size_t index) { problem->get_rank(atoms[index]); });
+
+        if (problem->num_ranks() != atoms.size())
+        {
+            std::cerr << "Error: the number of ranks differs from the number of atoms" << std::endl;
+            std::exit(1);
+        }
+
+        // Getting the rank of an atom stores it in the atom, so every lookup uses fresh atoms
+
+        const auto lookup_atoms = create_atoms();
+        const auto lookup =
+            run_threads(num_threads, atoms.size(), [&problem, &lookup_atoms](std::size_t index) { problem->get_rank(lookup_atoms[index]); });
+        const auto create = run_threads(num_threads,
+                                        atoms.size(),
+                                        [&problem, &atoms](std::size_t index)
+                                        { problem->create_atom(atoms[index]->predicate, mimir::formalism::ObjectList(atoms[index]->arguments)); });
+
+        problem->freeze_ranks();
+        const auto frozen_lookup_atoms = create_atoms();
+        const auto frozen_lookup =
+            run_threads(num_threads, atoms.size(), [&problem, &frozen_lookup_atoms](std::size_t index) { problem->get_rank(frozen_lookup_atoms[index]); });
+        const auto frozen_create = run_threads(num_threads,
+                                               atoms.size(),
+                                               [&problem, &atoms](std::size_t index)
+                                               { problem->create_atom(atoms[index]->predicate, mimir::formalism::ObjectList(atoms[index]->arguments)); });
+
+        std::cout << std::setw(8) << atoms.size() << std::setw(9) << num_threads << std::fixed << std::setprecision(2) << std::setw(10) << insert
+                  << std::setw(10) << lookup << std::setw(10) << create << std::setw(10) << frozen_lookup << std::setw(10) << frozen_create << std::endl;
+    }
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    const std::size_t num_objects = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 300;
+    const std::size_t max_num_threads = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : std::max(1u, std::thread::hardware_concurrency());
+
+    std::cout << "Throughput in operations per microsecond, summed over all threads" << std::endl;
+    std::cout << std::setw(8) << "atoms" << std::setw(9) << "threads" << std::setw(10) << "insert" << std::setw(10) << "lookup" << std::setw(10) << "create"
+              << std::setw(10) << "f-lookup" << std::setw(10) << "f-create" << std::endl;
+
+    for (std::size_t num_threads = 1; num_threads <= max_num_threads; num_threads *= 2)
+    {
+        run(num_objects, num_threads);
+    }
+
+    return 0;
+}
@@ -1,19 +1,91 @@
 #ifndef MIMIR_ALGORITHMS_KPKC_HPP_
 #define MIMIR_ALGORITHMS_KPKC_HPP_
 
-#include <boost/dynamic_bitset.hpp>
 #include <chrono>
-#include <iostream>
+#include <cstdint>
+#include <functional>
 #include <limits>
 #include <vector>
 
 namespace mimir::algorithms
 {
-    // Find all cliques of size k in a k-partite graph
-    bool find_all_k_cliques_in_k_partite_graph(const std::chrono::high_resolution_clock::time_point end_time,
-                                               const std::vector<boost::dynamic_bitset<>>& adjacency_matrix,
-                                               const std::vector<std::vector<size_t>>& partitions,
-                                               std::vector<std::vector<std::size_t>>& out_cliques);
+    /// @brief A symmetric adjacency matrix stored as a single array of words, one row of words per vertex.
+    class FlatAdjacencyMatrix
+    {
+      private:
+        std::size_t num_vertices_;
+        std::size_t num_words_per_row_;
+        std::vector<std::size_t> data_;
+
+      public:
+        static constexpr std::size_t block_size = sizeof(std::size_t) * 8;
+
+        FlatAdjacencyMatrix();
+
+        explicit FlatAdjacencyMatrix(std::size_t num_vertices);
+
+        /// @brief Change the number of vertices and remove all edges. Does not allocate if the matrix was at least as large before.
+        void reset(std::size_t num_vertices);
+
+        /// @brief Remove all edges.
+        void clear();
+
+        void add_edge(std::size_t first_vertex, std::size_t second_vertex)
+        {
+            data_[first_vertex * num_words_per_row_ + second_vertex / block_size] |= (static_cast<std::size_t>(1) << (second_vertex % block_size));
+            data_[second_vertex * num_words_per_row_ + first_vertex / block_size] |= (static_cast<std::size_t>(1) << (first_vertex % block_size));
+        }
+
+        bool has_edge(std::size_t first_vertex, std::size_t second_vertex) const
+        {
+            return (data_[first_vertex * num_words_per_row_ + second_vertex / block_size] & (static_cast<std::size_t>(1) << (second_vertex % block_size))) != 0;
+        }
+
+        const std::size_t* get_row(std::size_t vertex) const { return data_.data() + vertex * num_words_per_row_; }
+
+        std::size_t num_vertices() const;
+
+        std::size_t num_words_per_row() const;
+    };
+
+    /// @brief Enumerates all cliques of size k in a k-partite graph. The vertices of every partition must be consecutive, and the partitions must be
+    /// ordered by their vertices. All scratch memory is allocated once, so the enumerator should be reused across graphs with the same partitions.
+    class KPartiteCliqueEnumerator
+    {
+      public:
+        /// @brief Called for every clique, the vertices are not sorted. Return false to stop the enumeration.
+        using CliqueCallback = std::function<bool(const std::vector<std::size_t>& clique)>;
+
+        /// @brief The number of search steps between two checks of the time limit.
+        static constexpr uint32_t time_check_interval = 1024;
+
+      private:
+        std::vector<std::size_t> partition_begin_;
+        std::vector<std::size_t> partition_end_;
+        std::size_t num_vertices_;
+        std::size_t num_words_;
+        std::vector<std::size_t> compatible_vertices_stack_;
+        std::vector<uint8_t> partition_done_;
+        std::vector<std::size_t> partial_solution_;
+        uint32_t steps_until_time_check_;
+        bool stopped_;
+
+        bool enumerate_helper(std::size_t depth,
+                              const std::chrono::high_resolution_clock::time_point end_time,
+                              const FlatAdjacencyMatrix& adjacency_matrix,
+                              const CliqueCallback& callback);
+
+      public:
+        KPartiteCliqueEnumerator();
+
+        explicit KPartiteCliqueEnumerator(const std::vector<std::vector<std::size_t>>& partitions);
+
+        /// @brief Stream all cliques of size k to the callback.
+        /// @return False if the time limit was reached or the callback stopped the enumeration.
+        bool enumerate(const std::chrono::high_resolution_clock::time_point end_time,
+                       const FlatAdjacencyMatrix& adjacency_matrix,
+                       const CliqueCallback& callback);
+    };
 }  // namespace algorithms
 
 #endif  // MIMIR_ALGORITHMS_KPKC_HPP_
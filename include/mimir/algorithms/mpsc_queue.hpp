@@ -0,0 +1,69 @@
+#ifndef MIMIR_ALGORITHMS_MPSC_QUEUE_HPP_
+#define MIMIR_ALGORITHMS_MPSC_QUEUE_HPP_
+
+#include <atomic>
+#include <utility>
+
+namespace mimir::algorithms
+{
+    /// @brief An unbounded lock-free queue with any number of producers and a single consumer. It is a linked list of nodes with a dummy node at the
+    /// front: a producer appends its node with one atomic exchange of the back, and the consumer takes the value of the node after the dummy, which
+    /// then becomes the new dummy. A pop can miss a value whose push has not completed yet, so the consumer has to poll again until it is visible.
+    template<typename T>
+    class MpscQueue
+    {
+      private:
+        struct Node
+        {
+            std::atomic<Node*> next;
+            T value;
+        };
+
+        std::atomic<Node*> back_;  // The last node, written by the producers
+        Node* front_;              // The dummy node, only accessed by the consumer
+
+      public:
+        MpscQueue() : back_(nullptr), front_(new Node { nullptr, T() }) { back_.store(front_, std::memory_order_relaxed); }
+
+        MpscQueue(const MpscQueue& other) = delete;
+
+        MpscQueue& operator=(const MpscQueue& other) = delete;
+
+        ~MpscQueue()
+        {
+            while (front_ != nullptr)
+            {
+                const auto next = front_->next.load(std::memory_order_relaxed);
+                delete front_;
+                front_ = next;
+            }
+        }
+
+        /// @brief Append a value to the queue. Safe to call from any number of threads at once.
+        void push(T&& value)
+        {
+            const auto node = new Node { nullptr, std::move(value) };
+            const auto previous = back_.exchange(node, std::memory_order_acq_rel);
+            previous->next.store(node, std::memory_order_release);
+        }
+
+        /// @brief Take the value at the front of the queue. Must only be called from the consumer thread.
+        /// @return False if no completed push is pending.
+        bool pop(T& out_value)
+        {
+            const auto next = front_->next.load(std::memory_order_acquire);
+
+            if (next == nullptr)
+            {
+                return false;
+            }
+
+            out_value = std::move(next->value);
+            delete front_;
+            front_ = next;
+            return true;
+        }
+    };
+}  // namespace algorithms
+
+#endif  // MIMIR_ALGORITHMS_MPSC_QUEUE_HPP_
@@ -0,0 +1,54 @@
+#ifndef MIMIR_ALGORITHMS_THREAD_POOL_HPP_
+#define MIMIR_ALGORITHMS_THREAD_POOL_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mimir::algorithms
+{
+    /// @brief A fixed set of worker threads that run batches of indexed tasks. The calling thread takes part in every batch and returns once all
+    /// tasks of the batch are done, so a batch behaves like a parallel for loop. Batches of one pool must not be started concurrently.
+    class ThreadPool
+    {
+      private:
+        std::vector<std::thread> workers_;
+        std::mutex mutex_;
+        std::condition_variable batch_started_;
+        std::condition_variable batch_finished_;
+        const std::function<void(std::size_t)>* task_;
+        std::size_t num_tasks_;
+        std::atomic<std::size_t> next_task_;
+        std::size_t num_busy_workers_;
+        std::exception_ptr exception_;
+        uint64_t batch_;
+        bool stopping_;
+
+        void run_tasks(const std::function<void(std::size_t)>& task, std::size_t num_tasks);
+
+        void worker_loop();
+
+      public:
+        /// @brief Create a pool that runs batches on the given number of threads, including the calling thread.
+        explicit ThreadPool(std::size_t num_threads);
+
+        ThreadPool(const ThreadPool& other) = delete;
+
+        ThreadPool& operator=(const ThreadPool& other) = delete;
+
+        ~ThreadPool();
+
+        /// @brief Run task(0), ..., task(num_tasks - 1) on the threads of the pool, and wait for all of them to finish. If a task throws, the first
+        /// exception is rethrown once the batch is done.
+        void run(std::size_t num_tasks, const std::function<void(std::size_t)>& task);
+
+        std::size_t num_threads() const;
+    };
+}  // namespace algorithms
+
+#endif  // MIMIR_ALGORITHMS_THREAD_POOL_HPP_
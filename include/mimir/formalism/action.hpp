@@ -2,8 +2,8 @@
 #define MIMIR_FORMALISM_ACTION_HPP_
 
 #include "action_schema.hpp"
-#include "bitset.hpp"
 #include "declarations.hpp"
+#include "fixed_bitset.hpp"
 #include "literal.hpp"
 #include "object.hpp"
 #include "problem.hpp"
@@ -16,14 +16,16 @@ namespace mimir::formalism
     class ActionImpl
     {
       private:
-        mimir::formalism::Bitset applicability_positive_precondition_bitset_;
-        mimir::formalism::Bitset applicability_negative_precondition_bitset_;
-        mimir::formalism::Bitset unconditional_positive_effect_bitset_;
-        mimir::formalism::Bitset unconditional_negative_effect_bitset_;
-        std::vector<mimir::formalism::Bitset> conditional_positive_precondition_bitsets_;
-        std::vector<mimir::formalism::Bitset> conditional_negative_precondition_bitsets_;
-        std::vector<mimir::formalism::Bitset> conditional_positive_effect_bitsets_;
-        std::vector<mimir::formalism::Bitset> conditional_negative_effect_bitsets_;
+        // All bitsets of an action have the same number of words, enough to hold the largest rank it mentions. The negative bitsets have the bits
+        // of the negated atoms set.
+        mimir::formalism::FixedBitset applicability_positive_precondition_bitset_;
+        mimir::formalism::FixedBitset applicability_negative_precondition_bitset_;
+        mimir::formalism::FixedBitset unconditional_positive_effect_bitset_;
+        mimir::formalism::FixedBitset unconditional_negative_effect_bitset_;
+        std::vector<mimir::formalism::FixedBitset> conditional_positive_precondition_bitsets_;
+        std::vector<mimir::formalism::FixedBitset> conditional_negative_precondition_bitsets_;
+        std::vector<mimir::formalism::FixedBitset> conditional_positive_effect_bitsets_;
+        std::vector<mimir::formalism::FixedBitset> conditional_negative_effect_bitsets_;
         mimir::formalism::ObjectList arguments_;
         mimir::formalism::LiteralList applicability_precondition_;
         mimir::formalism::LiteralList unconditional_effect_;
@@ -57,8 +59,15 @@ namespace mimir::formalism
 
         friend bool is_applicable(const mimir::formalism::Action& action, const mimir::formalism::State& state);
 
+        friend bool is_applicable(const mimir::formalism::Action& action, const std::size_t* words, std::size_t num_words);
+
         friend mimir::formalism::State apply(const mimir::formalism::Action& action, const mimir::formalism::State& state);
 
+        friend void apply_into(const mimir::formalism::Action& action,
+                               const std::size_t* parent_words,
+                               std::size_t num_parent_words,
+                               std::vector<std::size_t>& out_words);
+
         const mimir::formalism::ObjectList& get_arguments() const;
 
         const mimir::formalism::LiteralList& get_precondition() const;
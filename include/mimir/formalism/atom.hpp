@@ -5,6 +5,10 @@
 #include "object.hpp"
 #include "predicate.hpp"
 
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
 namespace mimir::formalism
 {
     class AtomImpl
@@ -12,6 +16,11 @@ namespace mimir::formalism
       private:
         std::size_t hash_;
 
+        // The id of the problem that ranked the atom first in the upper 32 bits and the rank in the lower 32 bits, so that looking the rank up again
+        // is a single load. Problem ids start at 1, 0 means that no problem has ranked the atom yet. Problems rank atoms concurrently, so the id and
+        // the rank are set together.
+        mutable std::atomic<uint64_t> rank_stamp_;
+
         void validate() const;
 
       public:
@@ -28,6 +37,10 @@ namespace mimir::formalism
 
         template<typename T>
         friend class std::hash;
+
+        friend struct std::equal_to<mimir::formalism::Atom>;
+
+        friend class ProblemImpl;
     };
 
     mimir::formalism::Atom ground_predicate(const mimir::formalism::Predicate& predicate, const mimir::formalism::ParameterAssignment& assignment);
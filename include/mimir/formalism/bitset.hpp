@@ -24,6 +24,12 @@ namespace mimir::formalism
 
         Bitset(std::size_t size, bool default_bit_value);
 
+        // Initialize the bitset from raw blocks, all bits beyond the blocks are unset
+        Bitset(const std::size_t* blocks, std::size_t num_blocks);
+
+        // Initialize the bitset by taking ownership of the blocks, all bits beyond the blocks are unset
+        Bitset(std::vector<std::size_t>&& blocks);
+
         Bitset(const Bitset& other);
 
         Bitset(Bitset&& other) noexcept;
@@ -58,6 +64,11 @@ namespace mimir::formalism
 
         bool operator==(const Bitset& other) const;
 
+        // Get the underlying blocks, bits beyond the last block have the default bit value
+        const std::vector<std::size_t>& get_blocks() const;
+
+        bool get_default_bit_value() const;
+
         static constexpr std::size_t no_position = std::size_t(-1);
 
         template<typename T>
@@ -4,6 +4,7 @@
 #include "../datastructures/robin_map.hpp"
 #include "../datastructures/robin_set.hpp"
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -61,6 +62,11 @@ namespace mimir::formalism
     using StateTransitionsVector = std::vector<StateTransitions>;
     using StateProblem = std::pair<State, ProblemDescription>;
     using StateProblemList = std::vector<StateProblem>;
+    using StateId = uint32_t;
+    using StateIdList = std::vector<StateId>;
+
+    class StateRepositoryImpl;
+    using StateRepository = std::shared_ptr<StateRepositoryImpl>;
 
     class TransitionImpl;
     using Transition = std::shared_ptr<TransitionImpl>;
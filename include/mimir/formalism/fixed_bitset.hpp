@@ -0,0 +1,406 @@
+#ifndef MIMIR_FORMALISM_FIXED_BITSET_HPP_
+#define MIMIR_FORMALISM_FIXED_BITSET_HPP_
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define MIMIR_KERNELS_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define MIMIR_KERNELS_SSE2
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+static_assert(sizeof(std::size_t) == 8, "the kernels assume 64-bit words");
+
+namespace mimir::formalism
+{
+    /// @brief Word-parallel kernels over raw bitset blocks. The pointers do not have to be aligned, and the output may alias any of the inputs.
+    /// Depending on the instruction set the library is compiled for, the kernels use AVX2, SSE2 or scalar code. They are defined inline since
+    /// states typically consist of a few words only, where the cost of a call would dominate.
+    namespace kernels
+    {
+        inline std::size_t popcount_word(std::size_t word)
+        {
+#if defined(_MSC_VER)
+            return static_cast<std::size_t>(__popcnt64(word));
+#else
+            return static_cast<std::size_t>(__builtin_popcountll(word));
+#endif
+        }
+
+#if defined(MIMIR_KERNELS_AVX2)
+        constexpr std::size_t words_per_vector = 4;
+
+        inline __m256i load(const std::size_t* words) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words)); }
+
+        inline void store(std::size_t* words, __m256i value) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(words), value); }
+
+        inline __m256i vector_and(__m256i left, __m256i right) { return _mm256_and_si256(left, right); }
+
+        inline __m256i vector_or(__m256i left, __m256i right) { return _mm256_or_si256(left, right); }
+
+        // Note that the intrinsic negates its first argument
+        inline __m256i vector_andnot(__m256i left, __m256i right) { return _mm256_andnot_si256(right, left); }
+
+        inline __m256i vector_xor(__m256i left, __m256i right) { return _mm256_xor_si256(left, right); }
+
+        inline bool vector_is_zero(__m256i value) { return _mm256_testz_si256(value, value) != 0; }
+#elif defined(MIMIR_KERNELS_SSE2)
+        constexpr std::size_t words_per_vector = 2;
+
+        inline __m128i load(const std::size_t* words) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(words)); }
+
+        inline void store(std::size_t* words, __m128i value) { _mm_storeu_si128(reinterpret_cast<__m128i*>(words), value); }
+
+        inline __m128i vector_and(__m128i left, __m128i right) { return _mm_and_si128(left, right); }
+
+        inline __m128i vector_or(__m128i left, __m128i right) { return _mm_or_si128(left, right); }
+
+        // Note that the intrinsic negates its first argument
+        inline __m128i vector_andnot(__m128i left, __m128i right) { return _mm_andnot_si128(right, left); }
+
+        inline __m128i vector_xor(__m128i left, __m128i right) { return _mm_xor_si128(left, right); }
+
+        inline bool vector_is_zero(__m128i value) { return _mm_movemask_epi8(_mm_cmpeq_epi8(value, _mm_setzero_si128())) == 0xFFFF; }
+#endif
+
+        /// @brief Get the name of the instruction set used by the kernels: "avx2", "sse2" or "scalar".
+        inline const char* instruction_set()
+        {
+#if defined(MIMIR_KERNELS_AVX2)
+            return "avx2";
+#elif defined(MIMIR_KERNELS_SSE2)
+            return "sse2";
+#else
+            return "scalar";
+#endif
+        }
+
+        // Every kernel processes as many full vectors as possible and handles the remaining words with scalar code.
+
+        /// @brief out = left & right
+        inline void bitwise_and(const std::size_t* left, const std::size_t* right, std::size_t* out, std::size_t num_words)
+        {
+            std::size_t index = 0;
+#if defined(MIMIR_KERNELS_AVX2) || defined(MIMIR_KERNELS_SSE2)
+            for (; index + words_per_vector <= num_words; index += words_per_vector)
+            {
+                store(out + index, vector_and(load(left + index), load(right + index)));
+            }
+#endif
+            for (; index < num_words; ++index)
+            {
+                out[index] = left[index] & right[index];
+            }
+        }
+
+        /// @brief out = left | right
+        inline void bitwise_or(const std::size_t* left, const std::size_t* right, std::size_t* out, std::size_t num_words)
+        {
+            std::size_t index = 0;
+#if defined(MIMIR_KERNELS_AVX2) || defined(MIMIR_KERNELS_SSE2)
+            for (; index + words_per_vector <= num_words; index += words_per_vector)
+            {
+                store(out + index, vector_or(load(left + index), load(right + index)));
+            }
+#endif
+            for (; index < num_words; ++index)
+            {
+                out[index] = left[index] | right[index];
+            }
+        }
+
+        /// @brief out = left & ~right
+        inline void bitwise_andnot(const std::size_t* left, const std::size_t* right, std::size_t* out, std::size_t num_words)
+        {
+            std::size_t index = 0;
+#if defined(MIMIR_KERNELS_AVX2) || defined(MIMIR_KERNELS_SSE2)
+            for (; index + words_per_vector <= num_words; index += words_per_vector)
+            {
+                store(out + index, vector_andnot(load(left + index), load(right + index)));
+            }
+#endif
+            for (; index < num_words; ++index)
+            {
+                out[index] = left[index] & ~right[index];
+            }
+        }
+
+        /// @brief Check whether left == right.
+        inline bool equal(const std::size_t* left, const std::size_t* right, std::size_t num_words)
+        {
+            std::size_t index = 0;
+#if defined(MIMIR_KERNELS_AVX2) || defined(MIMIR_KERNELS_SSE2)
+            for (; index + words_per_vector <= num_words; index += words_per_vector)
+            {
+                if (!vector_is_zero(vector_xor(load(left + index), load(right + index))))
+                {
+                    return false;
+                }
+            }
+#endif
+            for (; index < num_words; ++index)
+            {
+                if (left[index] != right[index])
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        /// @brief Check whether every bit of left is also set in right.
+        inline bool is_subset(const std::size_t* left, const std::size_t* right, std::size_t num_words)
+        {
+            std::size_t index = 0;
+#if defined(MIMIR_KERNELS_AVX2) || defined(MIMIR_KERNELS_SSE2)
+            for (; index + words_per_vector <= num_words; index += words_per_vector)
+            {
+                if (!vector_is_zero(vector_andnot(load(left + index), load(right + index))))
+                {
+                    return false;
+                }
+            }
+#endif
+            for (; index < num_words; ++index)
+            {
+                if ((left[index] & ~right[index]) != 0)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        /// @brief Check whether left and right have a bit in common.
+        inline bool intersects(const std::size_t* left, const std::size_t* right, std::size_t num_words)
+        {
+            std::size_t index = 0;
+#if defined(MIMIR_KERNELS_AVX2) || defined(MIMIR_KERNELS_SSE2)
+            for (; index + words_per_vector <= num_words; index += words_per_vector)
+            {
+                if (!vector_is_zero(vector_and(load(left + index), load(right + index))))
+                {
+                    return true;
+                }
+            }
+#endif
+            for (; index < num_words; ++index)
+            {
+                if ((left[index] & right[index]) != 0)
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        /// @brief Check whether no bit is set.
+        inline bool is_zero(const std::size_t* words, std::size_t num_words)
+        {
+            std::size_t index = 0;
+#if defined(MIMIR_KERNELS_AVX2) || defined(MIMIR_KERNELS_SSE2)
+            for (; index + words_per_vector <= num_words; index += words_per_vector)
+            {
+                if (!vector_is_zero(load(words + index)))
+                {
+                    return false;
+                }
+            }
+#endif
+            for (; index < num_words; ++index)
+            {
+                if (words[index] != 0)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        /// @brief Count the number of set bits.
+        inline std::size_t popcount(const std::size_t* words, std::size_t num_words)
+        {
+            // Neither AVX2 nor SSE2 has a vector population count, the scalar instruction is used instead.
+
+            std::size_t count = 0;
+
+            for (std::size_t index = 0; index < num_words; ++index)
+            {
+                count += popcount_word(words[index]);
+            }
+
+            return count;
+        }
+
+        /// @brief out = (state & ~delete_effect) | add_effect, i.e., apply the delete list followed by the add list in a single pass.
+        inline void apply_effect(const std::size_t* state, const std::size_t* delete_effect, const std::size_t* add_effect, std::size_t* out, std::size_t num_words)
+        {
+            std::size_t index = 0;
+#if defined(MIMIR_KERNELS_AVX2) || defined(MIMIR_KERNELS_SSE2)
+            for (; index + words_per_vector <= num_words; index += words_per_vector)
+            {
+                store(out + index, vector_or(vector_andnot(load(state + index), load(delete_effect + index)), load(add_effect + index)));
+            }
+#endif
+            for (; index < num_words; ++index)
+            {
+                out[index] = (state[index] & ~delete_effect[index]) | add_effect[index];
+            }
+        }
+    }  // namespace kernels
+
+    template<typename T, std::size_t Alignment>
+    class AlignedAllocator
+    {
+      public:
+        using value_type = T;
+
+        template<typename U>
+        struct rebind
+        {
+            using other = AlignedAllocator<U, Alignment>;
+        };
+
+        AlignedAllocator() noexcept = default;
+
+        template<typename U>
+        AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept
+        {
+        }
+
+        T* allocate(std::size_t size) { return static_cast<T*>(::operator new(size * sizeof(T), std::align_val_t(Alignment))); }
+
+        void deallocate(T* pointer, std::size_t) noexcept { ::operator delete(pointer, std::align_val_t(Alignment)); }
+
+        template<typename U>
+        bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept
+        {
+            return true;
+        }
+
+        template<typename U>
+        bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept
+        {
+            return false;
+        }
+    };
+
+    /// @brief A bitset whose number of words is fixed at construction. Unlike Bitset, it has no default bit value and never resizes, so binary
+    /// operations require both operands to have the same number of words. The storage is aligned to a cache line for the SIMD kernels.
+    class FixedBitset
+    {
+      public:
+        static constexpr std::size_t block_size = sizeof(std::size_t) * 8;
+        static constexpr std::size_t alignment = 64;
+
+        using BlockList = std::vector<std::size_t, AlignedAllocator<std::size_t, alignment>>;
+
+      private:
+        BlockList data_;
+
+      public:
+        FixedBitset();
+
+        // Initialize the bitset with enough words to hold the given number of bits, all bits are unset
+        explicit FixedBitset(std::size_t num_bits);
+
+        // Initialize the bitset from raw blocks
+        FixedBitset(const std::size_t* blocks, std::size_t num_blocks);
+
+        static std::size_t num_words_for(std::size_t num_bits);
+
+        void set(std::size_t position)
+        {
+            assert(position / block_size < data_.size());
+            data_[position / block_size] |= (static_cast<std::size_t>(1) << (position % block_size));
+        }
+
+        void unset(std::size_t position)
+        {
+            assert(position / block_size < data_.size());
+            data_[position / block_size] &= ~(static_cast<std::size_t>(1) << (position % block_size));
+        }
+
+        bool get(std::size_t position) const
+        {
+            assert(position / block_size < data_.size());
+            return (data_[position / block_size] & (static_cast<std::size_t>(1) << (position % block_size))) != 0;
+        }
+
+        void reset();
+
+        std::size_t num_words() const { return data_.size(); }
+
+        const std::size_t* data() const { return data_.data(); }
+
+        std::size_t* data() { return data_.data(); }
+
+        FixedBitset& operator&=(const FixedBitset& other)
+        {
+            assert(num_words() == other.num_words());
+            kernels::bitwise_and(data(), other.data(), data(), num_words());
+            return *this;
+        }
+
+        FixedBitset& operator|=(const FixedBitset& other)
+        {
+            assert(num_words() == other.num_words());
+            kernels::bitwise_or(data(), other.data(), data(), num_words());
+            return *this;
+        }
+
+        // Unset every bit that is set in the other bitset
+        FixedBitset& andnot(const FixedBitset& other)
+        {
+            assert(num_words() == other.num_words());
+            kernels::bitwise_andnot(data(), other.data(), data(), num_words());
+            return *this;
+        }
+
+        // Unset every bit in the delete effect, then set every bit in the add effect
+        FixedBitset& apply_effect(const FixedBitset& delete_effect, const FixedBitset& add_effect)
+        {
+            assert(num_words() == delete_effect.num_words());
+            assert(num_words() == add_effect.num_words());
+            kernels::apply_effect(data(), delete_effect.data(), add_effect.data(), data(), num_words());
+            return *this;
+        }
+
+        bool operator==(const FixedBitset& other) const { return (num_words() == other.num_words()) && kernels::equal(data(), other.data(), num_words()); }
+
+        bool operator!=(const FixedBitset& other) const { return !(this->operator==(other)); }
+
+        bool is_subset_of(const FixedBitset& other) const
+        {
+            assert(num_words() == other.num_words());
+            return kernels::is_subset(data(), other.data(), num_words());
+        }
+
+        bool intersects(const FixedBitset& other) const
+        {
+            assert(num_words() == other.num_words());
+            return kernels::intersects(data(), other.data(), num_words());
+        }
+
+        bool none() const { return kernels::is_zero(data(), num_words()); }
+
+        std::size_t count() const { return kernels::popcount(data(), num_words()); }
+    };
+
+}  // namespace mimir::formalism
+
+#endif  // MIMIR_FORMALISM_FIXED_BITSET_HPP_
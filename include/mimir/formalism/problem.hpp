@@ -5,12 +5,16 @@
 #include "action_schema.hpp"
 #include "atom.hpp"
 #include "domain.hpp"
+#include "literal.hpp"
 #include "object.hpp"
 #include "predicate.hpp"
 #include "state.hpp"
 #include "type.hpp"
 
+#include <array>
+#include <atomic>
 #include <memory>
+#include <shared_mutex>
 #include <string>
 #include <vector>
 
@@ -28,14 +32,78 @@ namespace mimir::formalism
     class ProblemImpl
     {
       private:
+        // An atom that is not created yet, used to look up atoms without allocating them
+        struct AtomView
+        {
+            const mimir::formalism::Predicate& predicate;
+            const mimir::formalism::ObjectList& arguments;
+        };
+
+        struct AtomRankHash
+        {
+            using is_transparent = void;
+
+            std::size_t operator()(const mimir::formalism::Atom& atom) const;
+
+            std::size_t operator()(const AtomView& view) const;
+        };
+
+        struct AtomRankEqual
+        {
+            using is_transparent = void;
+
+            bool operator()(const mimir::formalism::Atom& left_atom, const mimir::formalism::Atom& right_atom) const;
+
+            bool operator()(const mimir::formalism::Atom& atom, const AtomView& view) const;
+
+            bool operator()(const AtomView& view, const mimir::formalism::Atom& atom) const;
+        };
+
+        // Everything that is looked up by a rank. Records are written once, before their rank is handed out, and never move afterwards, so they are
+        // read without locks.
+        struct RankRecord
+        {
+            mimir::formalism::Atom atom;
+            std::array<mimir::formalism::Literal, 2> literals;
+            uint32_t predicate_id;
+            uint32_t arity;
+            std::vector<uint32_t> argument_ids;
+            std::atomic<bool> published;
+        };
+
+        using RankMap = mimir::tsl::robin_map<mimir::formalism::Atom, uint32_t, AtomRankHash, AtomRankEqual>;
+
+        // The atoms ranked since the ranks were last frozen, spread over shards by their hash so that concurrent lookups rarely contend
+        struct alignas(64) RankShard
+        {
+            std::shared_mutex mutex;
+            RankMap ranks;
+        };
+
+        // The records are stored in segments of doubling size, segment k holds first_segment_size * 2^k records
+        static constexpr std::size_t num_rank_shards = 64;
+        static constexpr std::size_t first_segment_size = 1024;
+        static constexpr std::size_t max_num_segments = 23;
+
+        uint32_t id_;
         mimir::formalism::AtomSet static_atoms_;
         std::vector<bool> predicate_id_to_static_;
         fs::path path_;
-        mutable mimir::tsl::robin_map<mimir::formalism::Atom, uint32_t> atom_ranks_;
-        mutable mimir::formalism::AtomList rank_to_atom_;
-        mutable std::vector<uint32_t> rank_to_predicate_id_;
-        mutable std::vector<uint32_t> rank_to_arity_;
-        mutable std::vector<std::vector<uint32_t>> rank_to_argument_ids_;
+        mutable RankMap frozen_ranks_;
+        mutable std::array<RankShard, num_rank_shards> rank_shards_;
+        mutable std::array<std::atomic<RankRecord*>, max_num_segments> rank_segments_;
+        mutable std::atomic<uint32_t> next_rank_;
+        mutable std::atomic<uint32_t> num_ranks_;
+
+        RankShard& get_rank_shard(std::size_t hash) const;
+
+        const RankRecord& get_rank_record(uint32_t rank) const;
+
+        RankRecord& allocate_rank_record(uint32_t rank) const;
+
+        void publish_rank(RankRecord& record) const;
+
+        uint32_t add_rank(const mimir::formalism::Atom& atom, std::size_t hash) const;
 
         ProblemImpl(const std::string& name,
                     const mimir::formalism::DomainDescription& domain,
@@ -45,6 +113,12 @@ namespace mimir::formalism
                     const std::unordered_map<mimir::formalism::Atom, double>& atom_costs);
 
       public:
+        ~ProblemImpl();
+
+        ProblemImpl(const ProblemImpl& other) = delete;
+
+        ProblemImpl& operator=(const ProblemImpl& other) = delete;
+
         std::string name;
         mimir::formalism::DomainDescription domain;
         mimir::formalism::ObjectList objects;
@@ -60,10 +134,27 @@ namespace mimir::formalism
 
         fs::path get_path() const;
 
+        /// @brief Get the rank of the given atom, atoms that were not seen before get the next free rank. All functions that rank atoms or look
+        /// them up by rank can be called concurrently, but the order in which concurrently seen atoms are ranked is unspecified.
         uint32_t get_rank(const mimir::formalism::Atom& atom) const;
 
+        /// @brief Move all ranks assigned so far into an index that is only read afterwards, so looking them up does not take any locks. Atoms that
+        /// are seen for the first time afterwards are still ranked, in the concurrent index. Must not be called concurrently with any other function
+        /// of the problem.
+        void freeze_ranks() const;
+
+        uint32_t num_frozen_ranks() const;
+
+        /// @brief Get the unique atom of the problem with the given predicate and arguments. Atoms created by the problem are ranked, so getting their
+        /// rank or comparing them with other atoms of the problem does not need to hash them.
+        mimir::formalism::Atom create_atom(const mimir::formalism::Predicate& predicate, mimir::formalism::ObjectList&& arguments) const;
+
+        /// @brief Get the unique literal of the problem with the given atom and polarity.
+        mimir::formalism::Literal create_literal(const mimir::formalism::Atom& atom, bool negated) const;
+
         std::vector<uint32_t> to_ranks(const mimir::formalism::AtomList& atoms) const;
 
+        /// @brief Get the number of ranks, the records of all ranks below it are complete even while other threads add ranks.
         uint32_t num_ranks() const;
 
         bool is_static(uint32_t rank) const;
@@ -57,6 +57,9 @@ namespace mimir::formalism
 
         mimir::formalism::ProblemDescription get_problem() const;
 
+        /// @brief Get the blocks of the bitset of the state, bit i of the blocks is set if the atom with rank i is in the state.
+        const std::vector<std::size_t>& get_blocks() const;
+
         std::map<mimir::formalism::Predicate, mimir::formalism::AtomList> get_atoms_grouped_by_predicate() const;
 
         std::pair<std::map<uint32_t, std::vector<uint32_t>>, std::map<uint32_t, std::pair<std::string, uint32_t>>>
@@ -68,6 +71,11 @@ namespace mimir::formalism
 
         friend mimir::formalism::State apply(const mimir::formalism::Action& action, const mimir::formalism::State& state);
 
+        friend void apply_into(const mimir::formalism::Action& action,
+                               const std::size_t* parent_words,
+                               std::size_t num_parent_words,
+                               std::vector<std::size_t>& out_words);
+
         friend bool is_in_state(uint32_t rank, const mimir::formalism::State& state);
 
         friend bool is_in_state(const mimir::formalism::Atom& atom, const mimir::formalism::State& state);
@@ -79,12 +87,21 @@ namespace mimir::formalism
 
         template<typename T>
         friend class std::equal_to;
+
+        friend class StateRepositoryImpl;
     };
 
     // friend functions
 
     mimir::formalism::State apply(const mimir::formalism::Action& action, const mimir::formalism::State& state);
 
+    /// @brief Apply the action to the state given by its bitset blocks and write the blocks of the successor into the buffer. The buffer is
+    /// resized to fit the successor, so no allocation happens once it has grown large enough. The buffer must not hold the parent blocks.
+    void apply_into(const mimir::formalism::Action& action,
+                    const std::size_t* parent_words,
+                    std::size_t num_parent_words,
+                    std::vector<std::size_t>& out_words);
+
     bool is_in_state(uint32_t rank, const mimir::formalism::State& state);
 
     bool is_in_state(const mimir::formalism::Atom& atom, const mimir::formalism::State& state);
@@ -103,6 +120,9 @@ namespace mimir::formalism
 
     bool is_applicable(const mimir::formalism::Action& action, const mimir::formalism::State& state);
 
+    /// @brief Check whether the action is applicable in the state given by its bitset blocks. Blocks beyond the given ones are treated as unset.
+    bool is_applicable(const mimir::formalism::Action& action, const std::size_t* words, std::size_t num_words);
+
     bool atoms_hold(const AtomList& atoms, const mimir::formalism::State& state);
 
     bool literal_holds(const mimir::formalism::Literal& literal, const mimir::formalism::State& state);
@@ -0,0 +1,113 @@
+#ifndef MIMIR_FORMALISM_STATE_REPOSITORY_HPP_
+#define MIMIR_FORMALISM_STATE_REPOSITORY_HPP_
+
+#include "../datastructures/robin_set.hpp"
+#include "declarations.hpp"
+#include "state.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace mimir::formalism
+{
+    /// @brief Interns the states of a single problem. The bitsets of the states are stored contiguously in an arena of fixed-size chunks, and every
+    /// distinct state is identified by a dense 32-bit id, assigned in order of insertion.
+    class StateRepositoryImpl
+    {
+      private:
+        struct BlockView
+        {
+            const std::size_t* blocks;
+            std::size_t num_blocks;
+        };
+
+        struct StateIdHash
+        {
+            const StateRepositoryImpl* repository;
+
+            std::size_t operator()(const BlockView& view) const;
+
+            std::size_t operator()(StateId id) const;
+        };
+
+        struct StateIdEqual
+        {
+            using is_transparent = void;
+
+            const StateRepositoryImpl* repository;
+
+            bool operator()(StateId left_id, StateId right_id) const;
+
+            bool operator()(StateId id, const BlockView& view) const;
+
+            bool operator()(const BlockView& view, StateId id) const;
+        };
+
+        mimir::formalism::ProblemDescription problem_;
+        std::vector<std::unique_ptr<std::size_t[]>> chunks_;
+        std::size_t chunk_size_;
+        std::size_t chunk_capacity_;
+        std::size_t chunk_used_;
+        std::size_t num_chunk_blocks_;  // The sum of the capacities of the chunks, which can be larger than the chunk size
+        std::vector<const std::size_t*> state_blocks_;
+        std::vector<uint32_t> state_num_blocks_;
+        mimir::tsl::robin_set<StateId, StateIdHash, StateIdEqual, std::allocator<StateId>, true> state_ids_;
+
+        BlockView get_view(StateId id) const;
+
+        std::size_t* allocate_blocks(std::size_t num_blocks);
+
+        static std::size_t trim(const std::size_t* blocks, std::size_t num_blocks);
+
+      public:
+        static constexpr std::size_t default_chunk_size = 1 << 16;
+
+        StateRepositoryImpl(const mimir::formalism::ProblemDescription& problem, std::size_t chunk_size = default_chunk_size);
+
+        StateRepositoryImpl(const StateRepositoryImpl& other) = delete;
+
+        StateRepositoryImpl& operator=(const StateRepositoryImpl& other) = delete;
+
+        /// @brief Intern the given blocks. Trailing zero blocks are ignored.
+        /// @param blocks The blocks of the bitset of a state
+        /// @param num_blocks The number of blocks
+        /// @param out_id The id of the (possibly already existing) state
+        /// @return True if the state was not in the repository before
+        bool insert(const std::size_t* blocks, std::size_t num_blocks, StateId& out_id);
+
+        /// @brief Intern the given state.
+        /// @param state A state of the problem associated with the repository
+        /// @param out_id The id of the (possibly already existing) state
+        /// @return True if the state was not in the repository before
+        bool insert(const mimir::formalism::State& state, StateId& out_id);
+
+        /// @brief Look up the id of the given state without inserting it.
+        /// @return True if the state is in the repository
+        bool find(const mimir::formalism::State& state, StateId& out_id) const;
+
+        /// @brief Create a state object from the stored bitset.
+        mimir::formalism::State get_state(StateId id) const;
+
+        const std::size_t* get_blocks(StateId id) const;
+
+        std::size_t get_num_blocks(StateId id) const;
+
+        /// @brief Get the hash of the state with the given blocks, which is equal to StateImpl::hash() of the state. Trailing zero blocks are ignored.
+        static std::size_t hash(const std::size_t* blocks, std::size_t num_blocks);
+
+        mimir::formalism::ProblemDescription get_problem() const;
+
+        std::size_t size() const;
+
+        /// @brief Get the number of bytes allocated by the arena and the indices.
+        std::size_t memory_usage() const;
+
+        void clear();
+    };
+
+    StateRepository create_state_repository(const mimir::formalism::ProblemDescription& problem);
+}  // namespace mimir::formalism
+
+#endif  // MIMIR_FORMALISM_STATE_REPOSITORY_HPP_
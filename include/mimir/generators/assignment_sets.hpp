@@ -0,0 +1,65 @@
+#ifndef MIMIR_PLANNERS_ASSIGNMENT_SETS_HPP_
+#define MIMIR_PLANNERS_ASSIGNMENT_SETS_HPP_
+
+#include "../datastructures/robin_map.hpp"
+#include "../formalism/domain.hpp"
+#include "../formalism/fixed_bitset.hpp"
+#include "../formalism/problem.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace mimir::planners
+{
+    std::size_t
+    get_assignment_position(int32_t first_position, int32_t first_object, int32_t second_position, int32_t second_object, int32_t arity, int32_t num_objects);
+
+    std::size_t num_assignments(int32_t arity, int32_t num_objects);
+
+    /// @brief For every predicate, the set of (partial) assignments of at most two argument positions that are compatible with an atom in a set of atoms.
+    /// The sets of all predicates are stored in a single flat bitset. Every assignment in the sets also has a counter of the atoms supporting it, so the
+    /// sets can be moved from one set of atoms to another by only inserting and removing the atoms in which they differ. The counters are kept in an
+    /// open-addressing hash map, so they take memory for the assignments in the sets only, and updates do not allocate once the map has grown.
+    class AssignmentSets
+    {
+      private:
+        mimir::formalism::ProblemDescription problem_;
+        int32_t num_objects_;
+        std::vector<std::size_t> offsets_;
+        mimir::formalism::FixedBitset assignments_;
+        mimir::tsl::robin_map<std::size_t, uint32_t> supports_;
+        std::vector<uint32_t> ranks_;
+        bool is_fixed_;
+
+        template<typename Function>
+        void for_each_assignment(uint32_t rank, Function&& function) const;
+
+        void insert(uint32_t rank);
+
+        void erase(uint32_t rank);
+
+      public:
+        AssignmentSets(const mimir::formalism::DomainDescription& domain, const mimir::formalism::ProblemDescription& problem);
+
+        /// @brief Create the sets of atoms that never change, such as the static atoms. Only the bitset is stored, so the sets cannot be updated.
+        /// @param ranks The sorted ranks of the atoms
+        AssignmentSets(const mimir::formalism::DomainDescription& domain,
+                       const mimir::formalism::ProblemDescription& problem,
+                       const std::vector<uint32_t>& ranks);
+
+        /// @brief Move the sets to the given atoms, only the atoms that were not in the previous set of atoms, or that are no longer in it, are processed.
+        /// @param ranks The sorted ranks of the atoms
+        void update(const std::vector<uint32_t>& ranks);
+
+        bool contains(uint32_t predicate_id, int32_t first_position, int32_t first_object, int32_t second_position, int32_t second_object, int32_t arity) const
+        {
+            return assignments_.get(offsets_[predicate_id]
+                                    + get_assignment_position(first_position, first_object, second_position, second_object, arity, num_objects_));
+        }
+
+        /// @brief Get the sorted ranks of the atoms the sets currently describe.
+        const std::vector<uint32_t>& get_ranks() const;
+    };
+}  // namespace planners
+
+#endif  // MIMIR_PLANNERS_ASSIGNMENT_SETS_HPP_
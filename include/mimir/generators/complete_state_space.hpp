@@ -1,6 +1,7 @@
 #ifndef MIMIR_PLANNERS_COMPLETE_STATE_SPACE_HPP_
 #define MIMIR_PLANNERS_COMPLETE_STATE_SPACE_HPP_
 
+#include "../formalism/state_repository.hpp"
 #include "state_space.hpp"
 
 namespace mimir::planners
@@ -20,7 +21,7 @@ namespace mimir::planners
         std::vector<std::vector<mimir::formalism::State>> states_by_distance_;
         std::vector<std::vector<mimir::formalism::Transition>> forward_transitions_;
         std::vector<std::vector<mimir::formalism::Transition>> backward_transitions_;
-        mimir::tsl::robin_map<mimir::formalism::State, uint64_t> state_indices_;
+        mimir::formalism::StateRepository state_repository_;
         mutable std::vector<std::vector<int32_t>> state_distances_;
 
         // Since we return references of internal vectors, ensure that only create_statespaces can create this object.
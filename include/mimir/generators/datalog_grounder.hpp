@@ -0,0 +1,138 @@
+#ifndef MIMIR_PLANNERS_DATALOG_GROUNDER_HPP_
+#define MIMIR_PLANNERS_DATALOG_GROUNDER_HPP_
+
+#include "../datastructures/robin_map.hpp"
+#include "../formalism/action.hpp"
+#include "../formalism/problem.hpp"
+#include "flat_action_schema.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace mimir::planners
+{
+    /// @brief Computes the ground actions that are reachable in the delete relaxation of a problem. Every action schema is a Datalog rule whose body
+    /// is the positive part of its precondition and whose heads are its positive effects, including the consequences of conditional effects. The
+    /// rules are evaluated semi-naively: every round only evaluates the joins in which at least one atom was derived in the previous round, so each
+    /// ground action is derived exactly once.
+    class DatalogGrounder
+    {
+      private:
+        struct KeyHash
+        {
+            std::size_t operator()(const std::vector<uint32_t>& object_ids) const;
+        };
+
+        /// @brief The derived atoms of a predicate, in the order in which they were derived.
+        struct Relation
+        {
+            uint32_t arity;
+            std::vector<uint32_t> arguments;
+            mimir::tsl::robin_map<std::vector<uint32_t>, uint32_t, KeyHash> index_by_arguments;
+            // For every argument position and object, the ascending indices of the atoms with that object at that position
+            std::vector<std::vector<std::vector<uint32_t>>> indices_by_position;
+            // The atoms [0, delta_begin) were known before the current round, the atoms [delta_begin, delta_end) were derived in the previous round
+            uint32_t delta_begin;
+            uint32_t delta_end;
+
+            uint32_t size() const;
+
+            const uint32_t* get_arguments(uint32_t index) const;
+        };
+
+        /// @brief A body literal of a join, the argument position whose object is known when the literal is joined, or -1 if there is none, and the
+        /// parameters that the literal binds.
+        struct JoinStep
+        {
+            uint32_t literal_index;
+            int32_t index_position;
+            std::vector<uint32_t> bound_parameters;
+        };
+
+        struct Rule
+        {
+            FlatActionSchema schema;
+            std::vector<FlatLiteral> body;
+            std::vector<FlatLiteral> heads;
+            std::vector<FlatLiteral> negated_static_body;
+            // For every body literal, the order in which the body is joined when the atoms of that literal are restricted to the delta
+            std::vector<std::vector<JoinStep>> join_orders;
+            std::vector<uint32_t> unbound_parameters;
+            std::vector<std::vector<bool>> is_compatible_object;
+            std::vector<std::vector<uint32_t>> compatible_objects;
+            std::vector<uint32_t> ground_arguments;
+            std::size_t num_ground_actions;
+            // The indices of the ground actions, ordered by their arguments
+            std::vector<uint32_t> action_order;
+
+            Rule(const mimir::formalism::ProblemDescription& problem, const mimir::formalism::ActionSchema& action_schema);
+        };
+
+        /// @brief A range of the ordered ground actions of a rule, the unknown atoms that their literals mention and, once created, the actions.
+        struct Shard
+        {
+            uint32_t rule_index;
+            std::size_t begin;
+            std::size_t end;
+            std::vector<uint32_t> unranked_atoms;
+            mimir::formalism::ActionList actions;
+        };
+
+        static constexpr uint32_t unbound = std::numeric_limits<uint32_t>::max();
+        static constexpr std::size_t min_shard_size = 256;
+
+        mimir::formalism::ProblemDescription problem_;
+        std::size_t num_threads_;
+        mimir::formalism::PredicateList predicates_;
+        std::vector<Relation> relations_;
+        std::vector<Rule> rules_;
+        std::vector<uint32_t> assignment_;
+        std::vector<uint32_t> scratch_arguments_;
+        std::size_t num_rounds_;
+
+        bool insert_atom(uint32_t predicate_id, const std::vector<uint32_t>& arguments);
+
+        bool contains_atom(uint32_t predicate_id, const std::vector<uint32_t>& arguments) const;
+
+        void ground_literal(const FlatLiteral& literal, const uint32_t* assignment, std::vector<uint32_t>& out_arguments) const;
+
+        bool join(const std::chrono::high_resolution_clock::time_point end_time,
+                  Rule& rule,
+                  uint32_t delta_position,
+                  const std::vector<JoinStep>& join_order,
+                  std::size_t depth);
+
+        void assign_unbound_parameters(Rule& rule, std::size_t depth);
+
+        void fire(Rule& rule);
+
+        double get_cost(const Rule& rule, const mimir::formalism::ObjectList& arguments) const;
+
+        mimir::formalism::Atom create_atom(uint32_t predicate_id, const uint32_t* arguments) const;
+
+        bool collect_unranked_atoms(const std::chrono::high_resolution_clock::time_point end_time, Shard& shard) const;
+
+        bool create_actions(const std::chrono::high_resolution_clock::time_point end_time, Shard& shard) const;
+
+      public:
+        /// @brief Create a grounder for the given problem.
+        /// @param num_threads The number of threads that create the ground actions once the reachable atoms are known. The actions, and the ranks of
+        /// their atoms, do not depend on it.
+        explicit DatalogGrounder(const mimir::formalism::ProblemDescription& problem, std::size_t num_threads = 1);
+
+        /// @brief Compute the ground actions of the problem that are reachable when delete effects and negative preconditions are ignored, without the
+        /// actions that are inapplicable because of a static literal. The actions of every schema are ordered by their arguments.
+        /// @return False if the time limit was reached.
+        bool ground(const std::chrono::high_resolution_clock::time_point end_time, mimir::formalism::ActionList& out_actions);
+
+        /// @brief Get the number of rounds of the last call to ground.
+        std::size_t get_num_rounds() const;
+
+        /// @brief Get the number of atoms that are reachable in the delete relaxation.
+        std::size_t get_num_atoms() const;
+    };
+}  // namespace planners
+
+#endif  // MIMIR_PLANNERS_DATALOG_GROUNDER_HPP_
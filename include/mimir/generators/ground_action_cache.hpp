@@ -0,0 +1,56 @@
+#ifndef MIMIR_PLANNERS_GROUND_ACTION_CACHE_HPP_
+#define MIMIR_PLANNERS_GROUND_ACTION_CACHE_HPP_
+
+#include "../datastructures/robin_map.hpp"
+#include "../formalism/action.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace mimir::planners
+{
+    /// @brief Ground actions of a single action schema, keyed by the ids of their arguments. The number of cached actions is bounded by the capacity,
+    /// once it is reached, actions that were not used since the clock hand last passed them are evicted (second-chance replacement).
+    class GroundActionCache
+    {
+      private:
+        struct KeyHash
+        {
+            std::size_t operator()(const std::vector<uint32_t>& object_ids) const;
+        };
+
+        std::size_t capacity_;
+        mimir::tsl::robin_map<std::vector<uint32_t>, uint32_t, KeyHash> slot_by_key_;
+        std::vector<std::vector<uint32_t>> slot_keys_;
+        std::vector<mimir::formalism::Action> slot_actions_;
+        std::vector<uint8_t> slot_referenced_;
+        std::size_t clock_hand_;
+        std::size_t num_hits_;
+        std::size_t num_misses_;
+        std::size_t num_evictions_;
+
+      public:
+        /// @brief Create a cache that holds at most the given number of actions, a capacity of 0 disables caching.
+        explicit GroundActionCache(std::size_t capacity);
+
+        /// @brief Get the cached action with the given argument ids, or nullptr if there is none.
+        mimir::formalism::Action find(const std::vector<uint32_t>& object_ids);
+
+        /// @brief Cache an action that is not in the cache, evicting another action if the cache is full.
+        void insert(const std::vector<uint32_t>& object_ids, const mimir::formalism::Action& action);
+
+        void clear();
+
+        std::size_t size() const;
+
+        std::size_t capacity() const;
+
+        std::size_t get_num_hits() const;
+
+        std::size_t get_num_misses() const;
+
+        std::size_t get_num_evictions() const;
+    };
+}  // namespace planners
+
+#endif  // MIMIR_PLANNERS_GROUND_ACTION_CACHE_HPP_
@@ -8,57 +8,48 @@
 #include "successor_generator.hpp"
 
 #include <cstddef>
+#include <limits>
 #include <memory>
 #include <vector>
 
 namespace mimir::planners
 {
-    class DecisionNode
-    {
-      public:
-        virtual ~DecisionNode();
-
-        virtual void get_applicable_actions(const mimir::formalism::State& state, mimir::formalism::ActionList& applicable_actions) const = 0;
-
-        virtual std::size_t get_size() const = 0;
-    };
-
-    class BranchNode : public DecisionNode
+    class GroundedSuccessorGenerator : public SuccessorGeneratorBase
     {
-      public:
-        uint32_t rank_;
-        std::unique_ptr<DecisionNode> present_;
-        std::unique_ptr<DecisionNode> not_present_;
-        std::unique_ptr<DecisionNode> dont_care_;
-
-        BranchNode(uint32_t rank);
-
-        void get_applicable_actions(const mimir::formalism::State& state, mimir::formalism::ActionList& applicable_actions) const override;
-
-        std::size_t get_size() const override;
-    };
+      private:
+        // The decision tree is stored as a flat array of nodes, every subtree occupies a contiguous range in depth-first order. A branch node tests
+        // the atom with the given rank and holds the indices of its present, not present and dont care children, where 0 stands for a missing child
+        // since the root is never a child. A leaf node has the rank leaf_rank and holds the actions leaf_action_ids_[first, second), as indices into
+        // actions_.
+        struct FlatDecisionNode
+        {
+            uint32_t rank;
+            uint32_t first;
+            uint32_t second;
+            uint32_t third;
+        };
+
+        static constexpr uint32_t leaf_rank = std::numeric_limits<uint32_t>::max();
 
-    class LeafNode : public DecisionNode
-    {
-      public:
+        mimir::formalism::ProblemDescription problem_;
         mimir::formalism::ActionList actions_;
+        std::vector<FlatDecisionNode> nodes_;
+        std::vector<uint32_t> leaf_action_ids_;
+        std::size_t size_;
 
-        LeafNode(const mimir::formalism::ActionList& actions);
+        struct DecisionTreeBuilder;
 
-        void get_applicable_actions(const mimir::formalism::State& state, mimir::formalism::ActionList& applicable_actions) const override;
+        void build_decision_tree(std::size_t num_threads);
 
-        std::size_t get_size() const override;
-    };
-
-    class GroundedSuccessorGenerator : public SuccessorGeneratorBase
-    {
-      private:
-        mimir::formalism::ProblemDescription problem_;
-        mimir::formalism::ActionList actions_;
-        std::unique_ptr<DecisionNode> root_;
+        template<typename Function>
+        void for_each_applicable_action_id(const std::size_t* words, std::size_t num_words, Function&& function) const;
 
       public:
-        GroundedSuccessorGenerator(const mimir::formalism::ProblemDescription& problem, const mimir::formalism::ActionList& ground_actions);
+        /// @brief Create a successor generator for the given ground actions.
+        /// @param num_threads The number of threads that build independent subtrees of the decision tree concurrently.
+        GroundedSuccessorGenerator(const mimir::formalism::ProblemDescription& problem,
+                                   const mimir::formalism::ActionList& ground_actions,
+                                   std::size_t num_threads = 1);
 
         mimir::formalism::ProblemDescription get_problem() const override;
 
@@ -66,20 +57,14 @@ namespace mimir::planners
 
         mimir::formalism::ActionList get_applicable_actions(const mimir::formalism::State& state) const override;
 
-        std::size_t get_size() const;
-
-      private:
-        mimir::formalism::AtomList::const_iterator select_branching_atom(const mimir::formalism::ActionList& ground_actions,
-                                                                         const mimir::formalism::AtomList& atoms,
-                                                                         mimir::formalism::AtomList::const_iterator next_atom);
+        /// @brief The decision tree is immutable once built, so the generator is thread-safe.
+        bool is_thread_safe() const override;
 
-        std::unique_ptr<DecisionNode> build_decision_tree(const mimir::formalism::ProblemDescription& problem,
-                                                          const mimir::formalism::ActionList& ground_actions);
+        /// @brief Get the indices into get_actions() of the actions that are applicable in the state given by its bitset blocks.
+        /// @param out_action_ids The buffer for the indices, it is cleared first so it can be reused between calls.
+        void get_applicable_action_ids(const std::size_t* words, std::size_t num_words, std::vector<uint32_t>& out_action_ids) const;
 
-        std::unique_ptr<DecisionNode> build_decision_tree_recursive(const mimir::formalism::ProblemDescription& problem,
-                                                                    const mimir::formalism::ActionList& ground_actions,
-                                                                    const mimir::formalism::AtomList& atoms,
-                                                                    mimir::formalism::AtomList::const_iterator next_atom);
+        std::size_t get_size() const;
     };
 }  // namespace planners
 
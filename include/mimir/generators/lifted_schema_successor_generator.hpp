@@ -1,12 +1,15 @@
 #ifndef MIMIR_PLANNERS_LIFTED_SCHEMA_SUCCESSOR_GENERATOR_HPP_
 #define MIMIR_PLANNERS_LIFTED_SCHEMA_SUCCESSOR_GENERATOR_HPP_
 
+#include "../algorithms/kpkc.hpp"
 #include "../datastructures/robin_map.hpp"
 #include "../formalism/action.hpp"
 #include "../formalism/action_schema.hpp"
 #include "../formalism/problem.hpp"
 #include "../formalism/state.hpp"
+#include "assignment_sets.hpp"
 #include "flat_action_schema.hpp"
+#include "ground_action_cache.hpp"
 #include "successor_generator.hpp"
 
 #include <algorithm>
@@ -52,11 +55,15 @@ namespace mimir::planners
         std::vector<AssignmentPair> statically_consistent_assignments;
         std::vector<std::vector<std::size_t>> partitions_;
 
-        static std::vector<std::vector<bool>> build_assignment_sets(const mimir::formalism::DomainDescription& domain,
-                                                                    const mimir::formalism::ProblemDescription& problem,
-                                                                    const std::vector<uint32_t>& ranks);
+        // Scratch memory of the general case, reused between calls
+        mutable mimir::algorithms::FlatAdjacencyMatrix adjacency_matrix_;
+        mutable mimir::algorithms::KPartiteCliqueEnumerator clique_enumerator_;
 
-        bool literal_all_consistent(const std::vector<std::vector<bool>>& assignment_sets,
+        // Ground actions that were created before, and the argument ids of the action that is currently considered
+        mutable GroundActionCache action_cache_;
+        mutable std::vector<uint32_t> action_arguments_;
+
+        bool literal_all_consistent(const AssignmentSets& assignment_sets,
                                     const std::vector<mimir::planners::FlatLiteral>& literals,
                                     const Assignment& first_assignment,
                                     const Assignment& second_assignment) const;
@@ -68,6 +75,9 @@ namespace mimir::planners
 
         mimir::formalism::Action create_action(mimir::formalism::ObjectList&& terms) const;
 
+        /// @brief Add the action with the arguments in action_arguments_ to the output if it is applicable in the given state.
+        void add_action_if_applicable(const mimir::formalism::State& state, mimir::formalism::ActionList& out_actions) const;
+
         bool nullary_preconditions_hold(const mimir::formalism::State& state) const;
 
         bool has_consistent_effect(const mimir::formalism::Action& action) const;
@@ -82,21 +92,32 @@ namespace mimir::planners
 
         bool general_case(const std::chrono::high_resolution_clock::time_point end_time,
                           const mimir::formalism::State& state,
-                          const std::vector<std::vector<bool>>& assignment_sets,
+                          const AssignmentSets& assignment_sets,
                           mimir::formalism::ActionList& out_actions) const;
 
         mimir::formalism::ActionList nullary_case(const mimir::formalism::State& state) const;
 
         mimir::formalism::ActionList unary_case(const mimir::formalism::State& state) const;
 
-        mimir::formalism::ActionList general_case(const mimir::formalism::State& state, const std::vector<std::vector<bool>>& assignment_sets) const;
+        mimir::formalism::ActionList general_case(const mimir::formalism::State& state, const AssignmentSets& assignment_sets) const;
 
-        mimir::formalism::ActionList get_applicable_actions(const mimir::formalism::State& state, const std::vector<std::vector<bool>>& assignment_sets) const;
+        mimir::formalism::ActionList get_applicable_actions(const mimir::formalism::State& state, const AssignmentSets& assignment_sets) const;
+
+        bool get_applicable_actions(const std::chrono::high_resolution_clock::time_point end_time,
+                                    const mimir::formalism::State& state,
+                                    const AssignmentSets& assignment_sets,
+                                    mimir::formalism::ActionList& out_actions) const;
 
         friend class LiftedSuccessorGenerator;
 
       public:
-        LiftedSchemaSuccessorGenerator(const mimir::formalism::ActionSchema& action_schema, const mimir::formalism::ProblemDescription& problem);
+        static constexpr std::size_t default_action_cache_capacity = 250'000;
+
+        /// @brief Create a successor generator for a single action schema.
+        /// @param action_cache_capacity The maximum number of ground actions that are kept for reuse, 0 disables the cache.
+        LiftedSchemaSuccessorGenerator(const mimir::formalism::ActionSchema& action_schema,
+                                       const mimir::formalism::ProblemDescription& problem,
+                                       std::size_t action_cache_capacity = default_action_cache_capacity);
 
         mimir::formalism::ActionList get_applicable_actions(const mimir::formalism::State& state) const;
 
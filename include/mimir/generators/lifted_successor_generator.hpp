@@ -1,6 +1,7 @@
 #ifndef MIMIR_PLANNERS_LIFTED_SUCCESSOR_GENERATOR_HPP_
 #define MIMIR_PLANNERS_LIFTED_SUCCESSOR_GENERATOR_HPP_
 
+#include "../algorithms/thread_pool.hpp"
 #include "../formalism/action.hpp"
 #include "../formalism/action_schema.hpp"
 #include "../formalism/domain.hpp"
@@ -10,6 +11,8 @@
 #include "successor_generator.hpp"
 
 #include <map>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 namespace mimir::planners
@@ -20,8 +23,37 @@ namespace mimir::planners
         mimir::formalism::ProblemDescription problem_;
         std::map<mimir::formalism::ActionSchema, LiftedSchemaSuccessorGenerator> generators_;
 
+        // The assignment sets persist between calls, so that they only have to be updated with the atoms in which consecutive states differ. The mutex
+        // guards them while they are updated and used.
+        mutable std::mutex assignment_sets_mutex_;
+        mutable AssignmentSets assignment_sets_;
+
+        // Only used when the schemas are processed in parallel. Every schema collects its actions in its own buffer, and the buffers are appended in
+        // the order of generators_, so the result is the same as the one of the sequential loop.
+        std::unique_ptr<mimir::algorithms::ThreadPool> thread_pool_;
+        std::vector<const LiftedSchemaSuccessorGenerator*> ordered_generators_;
+        mutable std::vector<mimir::formalism::ActionList> schema_actions_;
+        mutable std::vector<uint8_t> schema_completed_;
+
+        bool get_applicable_actions_in_parallel(const std::chrono::high_resolution_clock::time_point end_time,
+                                                const mimir::formalism::State& state,
+                                                mimir::formalism::ActionList& out_actions) const;
+
       public:
-        LiftedSuccessorGenerator(const mimir::formalism::ProblemDescription& problem);
+        static constexpr std::size_t default_action_cache_capacity = 250'000;
+
+        /// @brief Create a lifted successor generator.
+        /// @param problem The problem to generate successors for.
+        /// @param num_threads The number of threads that process the action schemas of a state concurrently, 1 processes them sequentially.
+        /// @param action_cache_capacity The maximum number of ground actions kept for reuse, split evenly between the action schemas. 0 disables the
+        /// cache.
+        LiftedSuccessorGenerator(const mimir::formalism::ProblemDescription& problem,
+                                 std::size_t num_threads = 1,
+                                 std::size_t action_cache_capacity = default_action_cache_capacity);
+
+        LiftedSuccessorGenerator(const LiftedSuccessorGenerator& other) = delete;
+
+        LiftedSuccessorGenerator& operator=(const LiftedSuccessorGenerator& other) = delete;
 
         mimir::formalism::ProblemDescription get_problem() const override;
 
@@ -30,6 +62,8 @@ namespace mimir::planners
         bool get_applicable_actions(const std::chrono::high_resolution_clock::time_point end_time,
                                     const mimir::formalism::State& state,
                                     mimir::formalism::ActionList& out_actions) const;
+
+        std::size_t get_num_threads() const;
     };
 }  // namespace planners
 
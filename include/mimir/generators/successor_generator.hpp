@@ -16,6 +16,9 @@ namespace mimir::planners
         virtual mimir::formalism::ProblemDescription get_problem() const = 0;
 
         virtual mimir::formalism::ActionList get_applicable_actions(const mimir::formalism::State& state) const = 0;
+
+        /// @return True if get_applicable_actions can be called from several threads at once.
+        virtual bool is_thread_safe() const { return false; }
     };
 
     using SuccessorGenerator = std::shared_ptr<SuccessorGeneratorBase>;
@@ -15,7 +15,10 @@ namespace mimir::planners
         GROUNDED
     };
 
-    SuccessorGenerator create_sucessor_generator(const mimir::formalism::ProblemDescription& problem, SuccessorGeneratorType type);
+    /// @brief Create a successor generator of the given type.
+    /// @param num_threads The number of threads a lifted successor generator uses to process the action schemas of a state concurrently, and a
+    /// grounded successor generator uses to create its ground actions and to build its decision tree.
+    SuccessorGenerator create_sucessor_generator(const mimir::formalism::ProblemDescription& problem, SuccessorGeneratorType type, std::size_t num_threads = 1);
 }  // namespace planners
 
 #endif  // MIMIR_PLANNERS_SUCCESSOR_GENERATOR_FACTORY_HPP_
@@ -7,10 +7,19 @@
 #include "openlists/open_list_base.hpp"
 #include "search_base.hpp"
 
+#include <cstddef>
 #include <memory>
 
 namespace mimir::planners
 {
+    /// @brief A* search that evaluates the heuristic on batches of states. By default, the batch is the new successors of one expansion.
+    ///
+    /// If a batch size is given, the search is pipelined: new successors are collected across expansions, and a batch is submitted to the heuristic
+    /// on a separate thread when it is full, when the previous batch is done and the oldest successor has waited for the maximum latency, or when
+    /// nothing else is left to expand. The search continues to expand other states while a batch is evaluated, and inserts its states into the open
+    /// list once the values are ready. The heuristic is evaluated on one batch at a time. States can be expanded before a cheaper path to them is
+    /// known, so closed states are reopened, and a goal state is only accepted once no evaluation is outstanding, which keeps the plan optimal for
+    /// admissible heuristics.
     class BatchedAStarSearchImpl : public SearchBase
     {
       private:
@@ -18,20 +27,28 @@ namespace mimir::planners
         mimir::planners::SuccessorGenerator successor_generator_;
         mimir::planners::Heuristic heuristic_;
         mimir::planners::OpenList open_list_;
+        std::size_t batch_size_;
+        double max_latency_;
         double max_g_value_;
         double max_f_value_;
         int32_t max_depth_;
         int32_t expanded_;
         int32_t generated_;
         int32_t evaluated_;
+        int32_t batches_;
 
         void reset_statistics();
 
       public:
+        /// @param batch_size The number of successors at which a batch is submitted, or zero to evaluate the successors of every expansion
+        /// synchronously.
+        /// @param max_latency The number of seconds after which a batch is submitted, even if it is not full, once the previous batch is done.
         BatchedAStarSearchImpl(const mimir::formalism::ProblemDescription& problem,
                                const mimir::planners::SuccessorGenerator& successor_generator,
                                const mimir::planners::Heuristic& heuristic,
-                               const mimir::planners::OpenList& open_list);
+                               const mimir::planners::OpenList& open_list,
+                               std::size_t batch_size = 0,
+                               double max_latency = 0.0);
 
         std::map<std::string, std::variant<int32_t, double>> get_statistics() const override;
 
@@ -43,7 +60,9 @@ namespace mimir::planners
     BatchedAStarSearch create_batched_astar(const mimir::formalism::ProblemDescription& problem,
                                             const mimir::planners::SuccessorGenerator& successor_generator,
                                             const mimir::planners::Heuristic& heuristic,
-                                            const mimir::planners::OpenList& open_list);
+                                            const mimir::planners::OpenList& open_list,
+                                            std::size_t batch_size = 0,
+                                            double max_latency = 0.0);
 }  // namespace mimir::planners
 
 #endif  // MIMIR_PLANNERS_BATCHED_ASTAR_SEARCH_HPP_
@@ -0,0 +1,87 @@
+#ifndef MIMIR_PLANNERS_HDA_STAR_SEARCH_HPP_
+#define MIMIR_PLANNERS_HDA_STAR_SEARCH_HPP_
+
+#include "../formalism/problem.hpp"
+#include "../formalism/state_repository.hpp"
+#include "../generators/successor_generator.hpp"
+#include "heuristics/heuristic_base.hpp"
+#include "search_base.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace mimir::planners
+{
+    /// @brief Hash-distributed A* search. Every state is owned by one worker thread, chosen by the hash of the state. A worker owns the state
+    /// repository, the search nodes and the open list of its states, and sends the successors it generates to their owners through lock-free queues,
+    /// in batches. The owner evaluates a state once, when it is first received, and reopens it whenever a cheaper path to it arrives.
+    ///
+    /// A goal state that is expanded becomes the incumbent plan if it is cheaper than the current one, and states whose f-value is not below the cost
+    /// of the incumbent are pruned. The search terminates once no worker has states left to expand and no batch is in transit, so the incumbent is an
+    /// optimal plan for admissible heuristics.
+    class HDAStarSearchImpl : public SearchBase
+    {
+      private:
+        struct Worker;
+
+        mimir::formalism::ProblemDescription problem_;
+        mimir::planners::SuccessorGenerator successor_generator_;
+        std::vector<mimir::planners::Heuristic> heuristics_;
+        std::mutex successor_generator_mutex_;  // Only locked if the successor generator is not thread-safe
+        std::atomic<float> incumbent_g_value_;
+        std::mutex incumbent_mutex_;
+        std::size_t incumbent_worker_;
+        mimir::formalism::StateId incumbent_id_;
+        std::atomic<int64_t> work_;  // The number of busy workers plus the number of batches in transit, it stays zero once it drops to zero
+        std::atomic<bool> stop_;
+        std::atomic<double> max_g_value_;
+        std::atomic<double> max_f_value_;
+        std::atomic<int32_t> max_depth_;
+        std::atomic<int32_t> expanded_;
+        std::atomic<int32_t> generated_;
+        std::atomic<int32_t> evaluated_;
+        std::atomic<int32_t> reopened_;
+        std::atomic<int32_t> sent_;
+
+        void reset_statistics();
+
+        std::size_t get_owner(const std::size_t* blocks, std::size_t num_blocks) const;
+
+        void insert_state(Worker& worker,
+                          const std::size_t* blocks,
+                          std::size_t num_blocks,
+                          std::size_t parent_worker,
+                          mimir::formalism::StateId parent_id,
+                          const mimir::formalism::Action& action,
+                          float g_value,
+                          uint32_t depth);
+
+        void flush_batches(Worker& worker, std::vector<std::unique_ptr<Worker>>& workers);
+
+        void publish_statistics(Worker& worker);
+
+        void run_worker(std::size_t worker_index, std::vector<std::unique_ptr<Worker>>& workers);
+
+      public:
+        /// @param heuristics One heuristic per worker, since heuristics are not thread-safe. The number of heuristics is the number of workers.
+        HDAStarSearchImpl(const mimir::formalism::ProblemDescription& problem,
+                          const mimir::planners::SuccessorGenerator& successor_generator,
+                          const std::vector<mimir::planners::Heuristic>& heuristics);
+
+        std::map<std::string, std::variant<int32_t, double>> get_statistics() const override;
+
+        SearchResult plan(mimir::formalism::ActionList& out_plan) override;
+    };
+
+    using HDAStarSearch = std::shared_ptr<HDAStarSearchImpl>;
+
+    HDAStarSearch create_hda_star(const mimir::formalism::ProblemDescription& problem,
+                                  const mimir::planners::SuccessorGenerator& successor_generator,
+                                  const std::vector<mimir::planners::Heuristic>& heuristics);
+}  // namespace mimir::planners
+
+#endif  // MIMIR_PLANNERS_HDA_STAR_SEARCH_HPP_
@@ -0,0 +1,135 @@
+#ifndef MIMIR_PLANNERS_HEURISTIC_COST_KERNELS_HPP_
+#define MIMIR_PLANNERS_HEURISTIC_COST_KERNELS_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define MIMIR_COST_KERNELS_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define MIMIR_COST_KERNELS_SSE2
+#endif
+
+namespace mimir::planners
+{
+    /// @brief Kernels over the costs of an atom, or a pair of atoms, in a batch of states. Cost tables of batched heuristics store the lanes of one
+    /// entry contiguously, so that one kernel call updates the entry for all states of the batch at once. Depending on the instruction set the
+    /// library is compiled for, the kernels use AVX, SSE2 or scalar code. The pointers do not have to be aligned.
+    namespace cost_kernels
+    {
+        constexpr std::size_t num_lanes = 8;
+
+        constexpr float infinity = std::numeric_limits<float>::infinity();
+
+#if defined(MIMIR_COST_KERNELS_AVX)
+        inline __m256 load(const float* lanes) { return _mm256_loadu_ps(lanes); }
+
+        inline void store(float* lanes, __m256 value) { _mm256_storeu_ps(lanes, value); }
+#endif
+
+        /// @brief out[i] = value
+        inline void fill(float* out, float value) { std::fill(out, out + num_lanes, value); }
+
+        /// @brief out[i] = max(out[i], values[i])
+        inline void max_into(float* out, const float* values)
+        {
+#if defined(MIMIR_COST_KERNELS_AVX)
+            store(out, _mm256_max_ps(load(out), load(values)));
+#elif defined(MIMIR_COST_KERNELS_SSE2)
+            _mm_storeu_ps(out, _mm_max_ps(_mm_loadu_ps(out), _mm_loadu_ps(values)));
+            _mm_storeu_ps(out + 4, _mm_max_ps(_mm_loadu_ps(out + 4), _mm_loadu_ps(values + 4)));
+#else
+            for (std::size_t lane = 0; lane < num_lanes; ++lane)
+            {
+                out[lane] = std::max(out[lane], values[lane]);
+            }
+#endif
+        }
+
+        /// @brief out[i] = out[i] + values[i]
+        inline void add_into(float* out, const float* values)
+        {
+#if defined(MIMIR_COST_KERNELS_AVX)
+            store(out, _mm256_add_ps(load(out), load(values)));
+#elif defined(MIMIR_COST_KERNELS_SSE2)
+            _mm_storeu_ps(out, _mm_add_ps(_mm_loadu_ps(out), _mm_loadu_ps(values)));
+            _mm_storeu_ps(out + 4, _mm_add_ps(_mm_loadu_ps(out + 4), _mm_loadu_ps(values + 4)));
+#else
+            for (std::size_t lane = 0; lane < num_lanes; ++lane)
+            {
+                out[lane] += values[lane];
+            }
+#endif
+        }
+
+        /// @brief out[i] = values[i] + value
+        inline void add_scalar(const float* values, float value, float* out)
+        {
+#if defined(MIMIR_COST_KERNELS_AVX)
+            store(out, _mm256_add_ps(load(values), _mm256_set1_ps(value)));
+#elif defined(MIMIR_COST_KERNELS_SSE2)
+            _mm_storeu_ps(out, _mm_add_ps(_mm_loadu_ps(values), _mm_set1_ps(value)));
+            _mm_storeu_ps(out + 4, _mm_add_ps(_mm_loadu_ps(values + 4), _mm_set1_ps(value)));
+#else
+            for (std::size_t lane = 0; lane < num_lanes; ++lane)
+            {
+                out[lane] = values[lane] + value;
+            }
+#endif
+        }
+
+        /// @brief out[i] = min(out[i], values[i])
+        /// @return True if any lane decreased.
+        inline bool min_into(float* out, const float* values)
+        {
+#if defined(MIMIR_COST_KERNELS_AVX)
+            const auto old_values = load(out);
+            const auto new_values = load(values);
+            const auto decreased = _mm256_movemask_ps(_mm256_cmp_ps(new_values, old_values, _CMP_LT_OQ));
+            store(out, _mm256_min_ps(old_values, new_values));
+            return decreased != 0;
+#elif defined(MIMIR_COST_KERNELS_SSE2)
+            int decreased = 0;
+
+            for (std::size_t offset = 0; offset < num_lanes; offset += 4)
+            {
+                const auto old_values = _mm_loadu_ps(out + offset);
+                const auto new_values = _mm_loadu_ps(values + offset);
+                decreased |= _mm_movemask_ps(_mm_cmplt_ps(new_values, old_values));
+                _mm_storeu_ps(out + offset, _mm_min_ps(old_values, new_values));
+            }
+
+            return decreased != 0;
+#else
+            bool decreased = false;
+
+            for (std::size_t lane = 0; lane < num_lanes; ++lane)
+            {
+                decreased |= values[lane] < out[lane];
+                out[lane] = std::min(out[lane], values[lane]);
+            }
+
+            return decreased;
+#endif
+        }
+
+        /// @return True if every lane is infinite.
+        inline bool all_infinite(const float* values)
+        {
+#if defined(MIMIR_COST_KERNELS_AVX)
+            return _mm256_movemask_ps(_mm256_cmp_ps(load(values), _mm256_set1_ps(infinity), _CMP_EQ_OQ)) == 0xFF;
+#elif defined(MIMIR_COST_KERNELS_SSE2)
+            const auto infinities = _mm_set1_ps(infinity);
+            return (_mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(values), infinities)) & _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(values + 4), infinities)))
+                   == 0xF;
+#else
+            return std::all_of(values, values + num_lanes, [](float value) { return value == infinity; });
+#endif
+        }
+    }  // namespace cost_kernels
+}  // namespace mimir::planners
+
+#endif  // MIMIR_PLANNERS_HEURISTIC_COST_KERNELS_HPP_
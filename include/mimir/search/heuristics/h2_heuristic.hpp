@@ -1,43 +1,91 @@
 #ifndef MIMIR_PLANNERS_HEURISTIC_H2_HPP_
 #define MIMIR_PLANNERS_HEURISTIC_H2_HPP_
 
-#include "../../formalism/atom.hpp"
 #include "../../formalism/problem.hpp"
 #include "../../formalism/state.hpp"
 #include "../../generators/successor_generator.hpp"
 #include "heuristic_base.hpp"
 
+#include <cstddef>
+#include <cstdint>
 #include <limits>
-#include <unordered_map>
 #include <vector>
 
 namespace mimir::planners
 {
+    /// @brief The h^2 heuristic, the cost of the most expensive pair of goal atoms. Static atoms are true in every state, so only the dynamic atoms
+    /// are indexed. The costs of single atoms and of pairs share one packed lower-triangular table of floats, the entry of an atom with itself holds
+    /// its h^1 cost. The ground actions are stored in compressed rows, with their delete effects as sorted lists whose complement is walked instead
+    /// of materialized.
+    ///
+    /// If mutex pairs are pruned, h^2 is computed once from the initial state and only the pairs that it can reach get an entry in the table. The
+    /// other pairs can never be reached from the initial state, so the heuristic stays admissible but is only defined for states that are reachable
+    /// from the initial state.
+    ///
+    /// Batches of up to eight states are evaluated together on a table that holds the cost of every pair in each state of the batch next to each
+    /// other, so that one pass over the actions updates all states with vector instructions. This table takes eight times the memory of the table
+    /// of a single state, so it is allocated for every call that evaluates a list of states and released before the call returns.
     class H2Heuristic : public HeuristicBase
     {
       private:
-        using InternalAction = std::tuple<std::vector<int32_t>, std::vector<int32_t>, std::vector<int32_t>, double>;
+        static constexpr std::size_t no_pair = std::numeric_limits<std::size_t>::max();
 
         mimir::formalism::ProblemDescription problem_;
-        std::vector<InternalAction> actions_;
-        std::vector<int32_t> goal_;
-        mutable std::vector<double> h1_table_;
-        mutable std::vector<std::vector<double>> h2_table_;
+        uint32_t num_static_ranks_;
+        uint32_t num_atoms_;
 
-        double eval(const std::vector<int32_t>& ranks) const;
-        double eval(const std::vector<int32_t>& ranks, int32_t rank) const;
-        void update(int32_t rank, double value, bool& changed) const;
-        void update(int32_t rank1, int32_t rank2, double value, bool& changed) const;
-        void fill_tables(const mimir::formalism::State& state) const;
+        // The actions in compressed rows: the preconditions of action i are [precondition_begin_[i], precondition_begin_[i + 1])
+        std::vector<uint32_t> precondition_begin_;
+        std::vector<uint32_t> preconditions_;
+        std::vector<uint32_t> add_effect_begin_;
+        std::vector<uint32_t> add_effects_;
+        std::vector<uint32_t> delete_effect_begin_;
+        std::vector<uint32_t> delete_effects_;
+        std::vector<float> action_costs_;
+        std::vector<uint32_t> goal_;
+
+        // Only used if mutex pairs are pruned: bit k of pair_words_ is set if the pair with the packed index k is not mutex, and its entry in the
+        // table is the number of set bits before it, counted per word in pair_word_ranks_
+        bool is_pruned_;
+        std::vector<std::size_t> pair_words_;
+        std::vector<std::size_t> pair_word_ranks_;
+
+        mutable std::vector<float> table_;
+        mutable std::vector<uint32_t> state_atoms_;
+        // The costs of the pair with table index i in a batch of states are at [i * num_lanes, (i + 1) * num_lanes)
+        mutable std::vector<float> batch_table_;
+
+        std::size_t get_index(uint32_t atom1, uint32_t atom2) const;
+        float eval(const uint32_t* first, const uint32_t* last) const;
+        float eval(const uint32_t* first, const uint32_t* last, uint32_t atom) const;
+        void update(uint32_t atom1, uint32_t atom2, float value, bool& changed) const;
+        void fill_table(const std::vector<uint32_t>& state_atoms) const;
+        void prune_mutex_pairs();
+
+        void eval_batch(const uint32_t* first, const uint32_t* last, float* out_values) const;
+        void eval_batch(const uint32_t* first, const uint32_t* last, uint32_t atom, float* out_values) const;
+        void update_batch(uint32_t atom1, uint32_t atom2, const float* values, bool& changed) const;
+        void fill_batch_table(const mimir::formalism::StateList& states, std::size_t first, std::size_t num_states) const;
 
       public:
-        H2Heuristic(const mimir::formalism::ProblemDescription& problem, const mimir::planners::SuccessorGenerator& successor_generator);
+        H2Heuristic(const mimir::formalism::ProblemDescription& problem,
+                    const mimir::planners::SuccessorGenerator& successor_generator,
+                    bool prune_mutex_pairs = false);
 
         double evaluate(const mimir::formalism::State& state) const override;
+
+        std::vector<double> evaluate(const mimir::formalism::StateList& states) const override;
+
+        /// @brief Get the number of entries of the table, one per pair of dynamic atoms, or per pair that is not mutex if mutex pairs are pruned.
+        std::size_t get_table_size() const;
+
+        /// @brief Get the number of bytes allocated for the tables and the compiled actions.
+        std::size_t get_memory_usage() const;
     };
 
     std::shared_ptr<H2Heuristic> create_h2_heuristic(const mimir::formalism::ProblemDescription& problem,
-                                                     const mimir::planners::SuccessorGenerator& successor_generator);
+                                                     const mimir::planners::SuccessorGenerator& successor_generator,
+                                                     bool prune_mutex_pairs = false);
 }  // namespace planners
 
 #endif  // MIMIR_PLANNERS_HEURISTIC_H2_HPP_
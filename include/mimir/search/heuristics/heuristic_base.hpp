@@ -32,6 +32,10 @@ namespace mimir::planners
 
             return values;
         }
+
+        /// @brief Get the preferred operators of a state, the applicable actions that the heuristic considers useful. Only valid right after the
+        /// state was evaluated on its own, heuristics that do not compute preferred operators return no actions.
+        virtual mimir::formalism::ActionList get_preferred_actions(const mimir::formalism::State& state) const { return {}; }
     };
 
     using Heuristic = std::shared_ptr<HeuristicBase>;
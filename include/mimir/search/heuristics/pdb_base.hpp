@@ -6,20 +6,42 @@
 #include "../../generators/successor_generator.hpp"
 #include "heuristic_base.hpp"
 
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
 namespace mimir::planners
 {
+    /// @brief Base class of heuristics that project the grounded task onto patterns, which are lists of atom ranks. An abstract state assigns a truth
+    /// value to every atom of a pattern and is ranked by the perfect hash that sets bit i if the i-th atom of the pattern is true, so a pattern of k
+    /// atoms has 2^k abstract states.
     class PDBBase : public HeuristicBase
     {
       private:
+        friend class PDBBuilder;
+
         mimir::formalism::ProblemDescription problem_;
+        mimir::planners::SuccessorGenerator successor_generator_;
         std::vector<mimir::formalism::ActionList> relevant_actions_;  // An action is in the list at index i if it affects the atom with rank i
 
       protected:
         PDBBase(const mimir::formalism::ProblemDescription& problem, const mimir::planners::SuccessorGenerator& successor_generator);
 
-        std::vector<double> compute_table(const std::vector<int32_t>& pattern);
+        /// @brief Compute the cost of reaching the goal from every abstract state of the pattern with a backward Dijkstra search through the projected
+        /// actions. Conditional effects that affect the pattern may or may not fire in the abstraction, so the distances are admissible.
+        /// @return The distances indexed by the rank of the abstract states, infinite if the goal is unreachable.
+        std::vector<double> compute_table(const std::vector<int32_t>& pattern) const;
+
+        std::size_t get_index(const mimir::formalism::State& state, const std::vector<int32_t>& pattern) const;
+
+        /// @brief Patterns are additive if no action affects atoms of both, then the sum of their distances is admissible.
+        bool are_additive(const std::vector<int32_t>& first_pattern, const std::vector<int32_t>& second_pattern) const;
+
+        const mimir::formalism::ActionList& get_relevant_actions(uint32_t rank) const;
+
+        const mimir::formalism::ProblemDescription& get_problem() const;
 
-        std::size_t get_index(const mimir::formalism::State& state, const std::vector<int32_t>& pattern);
+        const mimir::planners::SuccessorGenerator& get_successor_generator() const;
     };
 
 }  // namespace planners
@@ -0,0 +1,92 @@
+#ifndef MIMIR_PLANNERS_PDB_BUILDER_HPP_
+#define MIMIR_PLANNERS_PDB_BUILDER_HPP_
+
+#include "../../algorithms/thread_pool.hpp"
+#include "pdb_base.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace mimir::planners
+{
+    /// @brief The distances of the abstract states of a pattern, stored in the narrowest table that holds them exactly: one or two bytes per abstract
+    /// state if all distances are small integers, where the maximum value of the integer type marks unreachable abstract states.
+    class DistanceTable
+    {
+      private:
+        std::variant<std::vector<uint8_t>, std::vector<uint16_t>, std::vector<double>> distances_;
+
+      public:
+        DistanceTable();
+
+        explicit DistanceTable(const std::vector<double>& distances);
+
+        double get(std::size_t index) const;
+
+        std::size_t size() const;
+
+        /// @brief Get the number of bytes allocated for the distances.
+        std::size_t get_memory_usage() const;
+
+        void write(std::ostream& stream) const;
+
+        /// @return False if the stream does not hold a table.
+        bool read(std::istream& stream);
+    };
+
+    /// @brief Builds the distance tables of patterns on a thread pool, one pattern per task. The tables that are alive, that is built and not yet
+    /// released, share a memory budget with the working sets of the searches that are running, and patterns whose search or table would not fit are
+    /// rejected before any memory is allocated for them. Finished tables can be persisted to a directory, keyed by a hash of the problem and the
+    /// pattern, so that later runs load them instead of searching again. The registered handlers are notified on the calling thread whenever a batch
+    /// of patterns is done.
+    class PDBBuilder
+    {
+      private:
+        std::unique_ptr<mimir::algorithms::ThreadPool> thread_pool_;
+        std::size_t memory_budget_;
+        std::string cache_directory_;
+        std::vector<std::function<void()>> event_handlers_;
+        std::size_t memory_usage_;
+        int32_t num_scheduled_;
+        int32_t num_built_;
+        int32_t num_loaded_;
+        int32_t num_rejected_;
+
+        std::string get_cache_path(const std::string& problem_hash, const std::string& pattern_key) const;
+
+        void notify_handlers() const;
+
+      public:
+        PDBBuilder(std::size_t num_threads = 1,
+                   std::size_t memory_budget = std::numeric_limits<std::size_t>::max(),
+                   const std::string& cache_directory = "");
+
+        /// @brief Register an event handler
+        /// @param handler Event handler
+        void register_handler(const std::function<void()>& handler);
+
+        /// @brief Build the tables of the patterns, in parallel, and charge them to the memory budget in the order of the patterns.
+        /// @return The tables, or nothing for patterns that were rejected.
+        std::vector<std::optional<DistanceTable>> build(const PDBBase& pdb, const std::vector<std::vector<int32_t>>& patterns);
+
+        /// @brief Return the memory of a table that is no longer used to the budget.
+        void release(const DistanceTable& table);
+
+        std::size_t num_threads() const;
+
+        /// @brief Get statistics of the patterns built so far
+        /// @return A dictionary with statistics
+        std::map<std::string, std::variant<int32_t, double>> get_statistics() const;
+    };
+}  // namespace planners
+
+#endif  // MIMIR_PLANNERS_PDB_BUILDER_HPP_
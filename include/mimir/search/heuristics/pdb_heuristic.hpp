@@ -0,0 +1,94 @@
+#ifndef MIMIR_PLANNERS_HEURISTIC_PDB_HPP_
+#define MIMIR_PLANNERS_HEURISTIC_PDB_HPP_
+
+#include "../../formalism/problem.hpp"
+#include "../../formalism/state.hpp"
+#include "../../generators/successor_generator.hpp"
+#include "pdb_base.hpp"
+#include "pdb_builder.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mimir::planners
+{
+    /// @brief The canonical heuristic of a collection of pattern databases: the maximum, over all maximal sets of pairwise additive patterns, of the
+    /// sum of their distances. The tables are built by a PDBBuilder, and a lookup costs one bit test per atom of the pattern.
+    class PDBHeuristic : public PDBBase
+    {
+      private:
+        std::vector<std::vector<int32_t>> patterns_;
+        std::vector<DistanceTable> tables_;
+        std::vector<std::vector<std::size_t>> additive_subsets_;
+        std::size_t num_abstract_states_;
+
+        /// @brief Get the maximal sets of pairwise additive patterns of the collection.
+        std::vector<std::vector<std::size_t>> compute_additive_subsets() const;
+
+        void add_pattern(const std::vector<int32_t>& pattern, DistanceTable&& table);
+
+        /// @brief Extend the collection, starting from one pattern per goal atom, by the atom that increases the heuristic value of the most sampled
+        /// states, until no extension fits into the budget or improves any sample. The extensions of every iteration are built in one batch.
+        void hill_climb(std::size_t max_pattern_states, std::size_t max_collection_states, std::size_t num_samples, PDBBuilder& builder);
+
+      public:
+        PDBHeuristic(const mimir::formalism::ProblemDescription& problem,
+                     const mimir::planners::SuccessorGenerator& successor_generator,
+                     const std::vector<std::vector<int32_t>>& patterns);
+
+        /// @brief Build the tables of the patterns with the given builder, patterns that it rejects are left out of the collection.
+        PDBHeuristic(const mimir::formalism::ProblemDescription& problem,
+                     const mimir::planners::SuccessorGenerator& successor_generator,
+                     const std::vector<std::vector<int32_t>>& patterns,
+                     PDBBuilder& builder);
+
+        /// @brief Generate the patterns by hill climbing.
+        /// @param max_pattern_states The maximum number of abstract states of a single pattern.
+        /// @param max_collection_states The maximum number of abstract states of all patterns together.
+        /// @param num_samples The number of states, sampled by random walks from the initial state, on which extensions of the patterns are compared.
+        PDBHeuristic(const mimir::formalism::ProblemDescription& problem,
+                     const mimir::planners::SuccessorGenerator& successor_generator,
+                     std::size_t max_pattern_states,
+                     std::size_t max_collection_states,
+                     std::size_t num_samples);
+
+        PDBHeuristic(const mimir::formalism::ProblemDescription& problem,
+                     const mimir::planners::SuccessorGenerator& successor_generator,
+                     std::size_t max_pattern_states,
+                     std::size_t max_collection_states,
+                     std::size_t num_samples,
+                     PDBBuilder& builder);
+
+        double evaluate(const mimir::formalism::State& state) const override;
+
+        const std::vector<std::vector<int32_t>>& get_patterns() const;
+
+        /// @brief Get the number of bytes allocated for the distance tables.
+        std::size_t get_memory_usage() const;
+    };
+
+    std::shared_ptr<PDBHeuristic> create_pdb_heuristic(const mimir::formalism::ProblemDescription& problem,
+                                                       const mimir::planners::SuccessorGenerator& successor_generator,
+                                                       const std::vector<std::vector<int32_t>>& patterns);
+
+    std::shared_ptr<PDBHeuristic> create_pdb_heuristic(const mimir::formalism::ProblemDescription& problem,
+                                                       const mimir::planners::SuccessorGenerator& successor_generator,
+                                                       const std::vector<std::vector<int32_t>>& patterns,
+                                                       PDBBuilder& builder);
+
+    std::shared_ptr<PDBHeuristic> create_hill_climbing_pdb_heuristic(const mimir::formalism::ProblemDescription& problem,
+                                                                     const mimir::planners::SuccessorGenerator& successor_generator,
+                                                                     std::size_t max_pattern_states,
+                                                                     std::size_t max_collection_states,
+                                                                     std::size_t num_samples);
+
+    std::shared_ptr<PDBHeuristic> create_hill_climbing_pdb_heuristic(const mimir::formalism::ProblemDescription& problem,
+                                                                     const mimir::planners::SuccessorGenerator& successor_generator,
+                                                                     std::size_t max_pattern_states,
+                                                                     std::size_t max_collection_states,
+                                                                     std::size_t num_samples,
+                                                                     PDBBuilder& builder);
+}  // namespace planners
+
+#endif  // MIMIR_PLANNERS_HEURISTIC_PDB_HPP_
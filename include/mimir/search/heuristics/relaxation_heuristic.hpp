@@ -0,0 +1,113 @@
+#ifndef MIMIR_PLANNERS_HEURISTIC_RELAXATION_HPP_
+#define MIMIR_PLANNERS_HEURISTIC_RELAXATION_HPP_
+
+#include "../../formalism/problem.hpp"
+#include "../../formalism/state.hpp"
+#include "../../generators/successor_generator.hpp"
+#include "heuristic_base.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace mimir::planners
+{
+    enum class RelaxationType
+    {
+        MAX,
+        ADD,
+        FF
+    };
+
+    /// @brief Estimates the cost of the delete relaxation of a state. The ground actions are compiled into unary operators, one for the
+    /// unconditional effects of every action and one for each of its conditional effects, whose preconditions are counted down while the costs of
+    /// atoms are settled in a generalized Dijkstra search from the atoms of the state. The search stops as soon as all goal atoms are settled, so an
+    /// evaluation only visits the part of the relaxed planning graph that is cheaper than the goal. If all action costs are integers, the priority
+    /// queue is a bucket queue.
+    ///
+    /// h_max and h_add also evaluate batches of states together: the costs of an atom in up to eight states are stored next to each other, and the
+    /// operators are applied to all states at once, with vector instructions, until no cost decreases. The batched costs are single precision, so
+    /// they equal the costs of single evaluations if the action costs are integers.
+    class RelaxationHeuristic : public HeuristicBase
+    {
+      private:
+        static constexpr uint32_t no_operator = std::numeric_limits<uint32_t>::max();
+
+        RelaxationType type_;
+        mimir::formalism::ProblemDescription problem_;
+        mimir::formalism::ActionList actions_;
+        uint32_t num_static_ranks_;
+        uint32_t num_ranks_;
+
+        // The operators in compressed rows: the preconditions of operator i are [precondition_begin_[i], precondition_begin_[i + 1])
+        std::vector<uint32_t> precondition_begin_;
+        std::vector<uint32_t> preconditions_;
+        std::vector<uint32_t> effect_begin_;
+        std::vector<uint32_t> effects_;
+        std::vector<double> operator_costs_;
+        std::vector<uint32_t> operator_actions_;
+        std::vector<uint32_t> operators_without_precondition_;
+        // The operators with rank i in their precondition are [precondition_of_begin_[i], precondition_of_begin_[i + 1])
+        std::vector<uint32_t> precondition_of_begin_;
+        std::vector<uint32_t> precondition_of_;
+        std::vector<uint32_t> goal_;
+        std::vector<bool> is_goal_;
+        bool has_integer_costs_;
+
+        mutable std::vector<double> costs_;
+        mutable std::vector<uint32_t> supporters_;
+        mutable std::vector<uint32_t> num_unsatisfied_;
+        mutable std::vector<double> operator_values_;
+        mutable std::vector<std::pair<double, uint32_t>> queue_;
+        // Used instead of the binary heap if all action costs are integers, bucket i holds the atoms that were reached with cost i
+        mutable std::vector<std::vector<uint32_t>> buckets_;
+        mutable std::vector<bool> is_marked_rank_;
+        mutable std::vector<bool> is_marked_action_;
+        mutable std::vector<uint32_t> relaxed_plan_;
+        mutable std::vector<uint32_t> open_ranks_;
+        // The costs of rank i in a batch of states are at [i * num_lanes, (i + 1) * num_lanes)
+        mutable std::vector<float> batch_costs_;
+        // The sweep in which the cost of a rank last decreased, and in which an operator was last applied
+        mutable std::vector<uint32_t> rank_sweeps_;
+        mutable std::vector<uint32_t> operator_sweeps_;
+
+        void enqueue(uint32_t rank, double cost, uint32_t supporter) const;
+
+        /// @brief Settle the cost of the given atom and reach the effects of the operators whose last unsatisfied precondition it is.
+        void settle(uint32_t rank, double cost) const;
+
+        /// @return False if a goal atom is unreachable.
+        bool explore(const mimir::formalism::State& state) const;
+
+        double extract_relaxed_plan() const;
+
+        /// @brief Compute the costs of all atoms in the states [first, first + num_states), which must fit into the lanes of the batch table.
+        void explore_batch(const mimir::formalism::StateList& states, std::size_t first, std::size_t num_states) const;
+
+      public:
+        RelaxationHeuristic(const mimir::formalism::ProblemDescription& problem,
+                            const mimir::planners::SuccessorGenerator& successor_generator,
+                            RelaxationType type);
+
+        double evaluate(const mimir::formalism::State& state) const override;
+
+        std::vector<double> evaluate(const mimir::formalism::StateList& states) const override;
+
+        RelaxationType get_type() const;
+
+        /// @brief Get the indices, into the actions of the grounded successor generator, of the relaxed plan found by the last evaluation. Only
+        /// computed for h_FF.
+        const std::vector<uint32_t>& get_relaxed_plan() const;
+
+        /// @brief Get the actions of the relaxed plan that are applicable in the state, the helpful actions of FF. Only computed for h_FF.
+        mimir::formalism::ActionList get_preferred_actions(const mimir::formalism::State& state) const override;
+    };
+
+    std::shared_ptr<RelaxationHeuristic> create_relaxation_heuristic(const mimir::formalism::ProblemDescription& problem,
+                                                                     const mimir::planners::SuccessorGenerator& successor_generator,
+                                                                     RelaxationType type);
+}  // namespace planners
+
+#endif  // MIMIR_PLANNERS_HEURISTIC_RELAXATION_HPP_
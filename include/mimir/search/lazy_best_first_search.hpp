@@ -0,0 +1,70 @@
+#ifndef MIMIR_PLANNERS_LAZY_BEST_FIRST_SEARCH_HPP_
+#define MIMIR_PLANNERS_LAZY_BEST_FIRST_SEARCH_HPP_
+
+#include "../formalism/problem.hpp"
+#include "../generators/successor_generator.hpp"
+#include "heuristics/heuristic_base.hpp"
+#include "openlists/open_list_base.hpp"
+#include "search_base.hpp"
+
+#include <memory>
+
+namespace mimir::planners
+{
+    /// @brief Best-first search with deferred evaluation. The open list holds transitions instead of states: the successors of a state are inserted
+    /// with the heuristic value of the state, and a successor is only generated and evaluated when its transition is popped. States are closed when
+    /// they are evaluated, so every state is evaluated at most once.
+    ///
+    /// If a second open list is given, transitions by preferred operators of the heuristic are also inserted into it, and the search alternates
+    /// between both lists with an AlternationOpenList. After every evaluation that improves the best heuristic value, the preferred list is boosted
+    /// by the given number of pops. Since a transition is then popped from both lists, they must not support decrease_key. Without preferred
+    /// operators, any open list can be used.
+    class LazyBestFirstSearchImpl : public SearchBase
+    {
+      private:
+        mimir::formalism::ProblemDescription problem_;
+        mimir::planners::SuccessorGenerator successor_generator_;
+        mimir::planners::Heuristic heuristic_;
+        mimir::planners::OpenList open_list_;
+        mimir::planners::OpenList preferred_open_list_;
+        double g_weight_;
+        int32_t preferred_boost_;
+        double max_g_value_;
+        double min_h_value_;
+        int32_t max_depth_;
+        int32_t expanded_;
+        int32_t generated_;
+        int32_t evaluated_;
+        int32_t preferred_;
+
+        void reset_statistics();
+
+      public:
+        /// @param preferred_open_list The open list of transitions by preferred operators, or nullptr if preferred operators are not used.
+        /// @param g_weight The weight of the g-value in the priority of a transition, 0 for greedy best-first search.
+        /// @param preferred_boost The number of extra pops of the preferred list when the best heuristic value improves.
+        LazyBestFirstSearchImpl(const mimir::formalism::ProblemDescription& problem,
+                                const mimir::planners::SuccessorGenerator& successor_generator,
+                                const mimir::planners::Heuristic& heuristic,
+                                const mimir::planners::OpenList& open_list,
+                                const mimir::planners::OpenList& preferred_open_list = nullptr,
+                                double g_weight = 0.0,
+                                int32_t preferred_boost = 1000);
+
+        std::map<std::string, std::variant<int32_t, double>> get_statistics() const override;
+
+        SearchResult plan(mimir::formalism::ActionList& out_plan) override;
+    };
+
+    using LazyBestFirstSearch = std::shared_ptr<LazyBestFirstSearchImpl>;
+
+    LazyBestFirstSearch create_lazy_best_first_search(const mimir::formalism::ProblemDescription& problem,
+                                                      const mimir::planners::SuccessorGenerator& successor_generator,
+                                                      const mimir::planners::Heuristic& heuristic,
+                                                      const mimir::planners::OpenList& open_list,
+                                                      const mimir::planners::OpenList& preferred_open_list = nullptr,
+                                                      double g_weight = 0.0,
+                                                      int32_t preferred_boost = 1000);
+}  // namespace mimir::planners
+
+#endif  // MIMIR_PLANNERS_LAZY_BEST_FIRST_SEARCH_HPP_
@@ -0,0 +1,52 @@
+#ifndef MIMIR_PLANNERS_ALTERNATION_OPEN_LIST_HPP_
+#define MIMIR_PLANNERS_ALTERNATION_OPEN_LIST_HPP_
+
+#include "open_list_base.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mimir::planners
+{
+    /// @brief An open list that alternates between several sub-lists, for example one per heuristic or one for preferred operators. Every sub-list
+    /// has a counter of the times it was popped, and the non-empty sub-list with the lowest counter is popped next, the first one on ties. Boosting a
+    /// sub-list lowers its counter, so that it is popped that many more times before the others get their turn again. Items are inserted into every
+    /// sub-list, or into a single one, so an item can be popped more than once and the search has to skip duplicates. For the same reason, sub-lists
+    /// that support decrease_key are rejected.
+    template<typename T>
+    class AlternationOpenList : public OpenListBase<T>
+    {
+      private:
+        std::vector<std::shared_ptr<OpenListBase<T>>> open_lists_;
+        std::vector<int64_t> counters_;
+
+      public:
+        using OpenListBase<T>::insert;
+
+        explicit AlternationOpenList(const std::vector<std::shared_ptr<OpenListBase<T>>>& open_lists);
+
+        /// @brief Insert an item into every sub-list.
+        void insert(const T& item, double priority) override;
+
+        /// @brief Insert an item into every sub-list.
+        void insert(const T& item, double priority, double tie_breaker) override;
+
+        /// @brief Insert an item into the sub-list with the given index only.
+        void insert_into(std::size_t index, const T& item, double priority);
+
+        void insert_into(std::size_t index, const T& item, double priority, double tie_breaker);
+
+        /// @brief Let the sub-list with the given index be popped the given number of times before the others.
+        void boost(std::size_t index, int32_t amount);
+
+        T pop() override;
+
+        /// @brief Get the total number of items in the sub-lists, including duplicates.
+        std::size_t size() override;
+    };
+
+    std::shared_ptr<AlternationOpenList<int32_t>> create_alternation_open_list(const std::vector<OpenList>& open_lists);
+}  // namespace planners
+
+#endif  // MIMIR_PLANNERS_ALTERNATION_OPEN_LIST_HPP_
@@ -0,0 +1,49 @@
+#ifndef MIMIR_PLANNERS_BUCKET_OPEN_LIST_HPP_
+#define MIMIR_PLANNERS_BUCKET_OPEN_LIST_HPP_
+
+#include "open_list_base.hpp"
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+namespace mimir::planners
+{
+    /// @brief An open list for priorities that are non-negative integers, such as the f-values of a search with integer action costs. Items are kept
+    /// in one bucket per priority, from the lowest to the highest priority in the list, and every bucket is split in the same way by the tie-breaker,
+    /// which must be a non-negative integer as well. The memory depends on the ranges of the priorities and tie-breakers and not on their magnitude.
+    /// Insertion is amortized constant time, and so is popping while the priorities and tie-breakers are close together, as in A* with integer
+    /// costs. Items with equal priority and tie-breaker are popped last in, first out.
+    template<typename T>
+    class BucketOpenList : public OpenListBase<T>
+    {
+      private:
+        struct Bucket
+        {
+            std::deque<std::vector<T>> items;  // The first list is not empty, unless the bucket is
+            std::size_t min_tie_breaker;       // The tie-breaker of the first list
+        };
+
+        std::deque<Bucket> buckets_;  // The first bucket is not empty, unless the list is
+        std::size_t min_priority_;    // The priority of the first bucket
+        std::size_t size_;
+
+      public:
+        using OpenListBase<T>::insert;
+
+        BucketOpenList();
+
+        /// @brief Insert an item with a tie-breaker of 0.
+        void insert(const T& item, double priority) override;
+
+        void insert(const T& item, double priority, double tie_breaker) override;
+
+        T pop() override;
+
+        std::size_t size() override;
+    };
+
+    std::shared_ptr<BucketOpenList<int32_t>> create_bucket_open_list();
+}  // namespace planners
+
+#endif  // MIMIR_PLANNERS_BUCKET_OPEN_LIST_HPP_
@@ -0,0 +1,58 @@
+#ifndef MIMIR_PLANNERS_EPSILON_GREEDY_OPEN_LIST_HPP_
+#define MIMIR_PLANNERS_EPSILON_GREEDY_OPEN_LIST_HPP_
+
+#include "open_list_base.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace mimir::planners
+{
+    /// @brief An open list that pops an item of lowest priority and tie-breaker, or, with probability epsilon, an item chosen uniformly at random.
+    /// The random choices let a greedy search escape plateaus and misleading regions of the heuristic. The items are kept in a binary heap, so both
+    /// kinds of pops take logarithmic time.
+    template<typename T>
+    class EpsilonGreedyOpenList : public OpenListBase<T>
+    {
+      private:
+        struct Entry
+        {
+            double priority;
+            double tie_breaker;
+            uint64_t counter;
+            T item;
+        };
+
+        std::vector<Entry> heap_;
+        double epsilon_;
+        std::mt19937_64 random_;
+        uint64_t counter_;
+
+        static bool is_less(const Entry& lhs, const Entry& rhs);
+
+        void sift_up(std::size_t position);
+
+        void sift_down(std::size_t position);
+
+      public:
+        using OpenListBase<T>::insert;
+
+        /// @param epsilon The probability of popping a random item.
+        /// @param seed The seed of the random choices, so that searches are reproducible.
+        EpsilonGreedyOpenList(double epsilon = 0.2, uint64_t seed = 0);
+
+        void insert(const T& item, double priority) override;
+
+        void insert(const T& item, double priority, double tie_breaker) override;
+
+        T pop() override;
+
+        std::size_t size() override;
+    };
+
+    std::shared_ptr<EpsilonGreedyOpenList<int32_t>> create_epsilon_greedy_open_list(double epsilon = 0.2, uint64_t seed = 0);
+}  // namespace planners
+
+#endif  // MIMIR_PLANNERS_EPSILON_GREEDY_OPEN_LIST_HPP_
@@ -0,0 +1,68 @@
+#ifndef MIMIR_PLANNERS_INDEXED_HEAP_OPEN_LIST_HPP_
+#define MIMIR_PLANNERS_INDEXED_HEAP_OPEN_LIST_HPP_
+
+#include "open_list_base.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mimir::planners
+{
+    /// @brief A d-ary heap of items that are non-negative integers, such as state ids, which tracks the position of every item in the heap. Each item
+    /// is in the list at most once, and a cheaper path to an item lowers its priority in place with decrease_key, so the heap never holds more
+    /// entries than there are open items. Items are ordered by priority, then tie-breaker, then the item itself.
+    template<typename T>
+    class IndexedHeapOpenList : public OpenListBase<T>
+    {
+      private:
+        static constexpr uint32_t no_position = UINT32_MAX;
+
+        struct Entry
+        {
+            double priority;
+            double tie_breaker;
+            T item;
+        };
+
+        std::size_t arity_;
+        std::vector<Entry> heap_;
+        std::vector<uint32_t> positions_;  // The position of every item in the heap, or no_position if it is not in the list
+
+        static bool is_less(const Entry& lhs, const Entry& rhs);
+
+        void move_entry(std::size_t position, const Entry& entry);
+
+        void sift_up(std::size_t position, const Entry& entry);
+
+        void sift_down(std::size_t position, const Entry& entry);
+
+      public:
+        using OpenListBase<T>::insert;
+
+        /// @param arity The number of children of every node of the heap, at least 2. Wider heaps are shallower, which makes insertions and
+        /// decrease_key cheaper and pops more expensive.
+        explicit IndexedHeapOpenList(std::size_t arity = 4);
+
+        /// @brief Insert an item with a tie-breaker of 0.
+        void insert(const T& item, double priority) override;
+
+        /// @brief Insert an item that is not in the list.
+        void insert(const T& item, double priority, double tie_breaker) override;
+
+        bool supports_decrease_key() const override;
+
+        /// @brief Lower the priority and tie-breaker of an item that is in the list. Keys that are not lower are an error.
+        void decrease_key(const T& item, double priority, double tie_breaker) override;
+
+        bool contains(const T& item) const;
+
+        T pop() override;
+
+        std::size_t size() override;
+    };
+
+    std::shared_ptr<IndexedHeapOpenList<int32_t>> create_indexed_heap_open_list(std::size_t arity = 4);
+}  // namespace planners
+
+#endif  // MIMIR_PLANNERS_INDEXED_HEAP_OPEN_LIST_HPP_
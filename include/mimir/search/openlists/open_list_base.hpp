@@ -2,6 +2,7 @@
 #define MIMIR_PLANNERS_OPEN_LIST_BASE_HPP_
 
 #include <memory>
+#include <stdexcept>
 
 namespace mimir::planners
 {
@@ -13,6 +14,16 @@ namespace mimir::planners
 
         virtual void insert(const T& item, double priority) = 0;
 
+        /// @brief Insert an item with a second priority that orders items of equal priority, lower first. Open lists that do not break ties ignore
+        /// it.
+        virtual void insert(const T& item, double priority, double tie_breaker) { insert(item, priority); }
+
+        /// @return True if the open list holds every item at most once and can lower the priority of an item in place with decrease_key.
+        virtual bool supports_decrease_key() const { return false; }
+
+        /// @brief Lower the priority and tie-breaker of an item that is in the open list. Only supported if supports_decrease_key() is true.
+        virtual void decrease_key(const T& item, double priority, double tie_breaker) { throw std::logic_error("open list does not support decrease_key"); }
+
         virtual T pop() = 0;
 
         virtual std::size_t size() = 0;
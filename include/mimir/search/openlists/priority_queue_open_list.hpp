@@ -15,6 +15,8 @@ namespace mimir::planners
         std::priority_queue<std::pair<double, T>, std::vector<std::pair<double, T>>, std::greater<std::pair<double, T>>> priority_queue_;
 
       public:
+        using OpenListBase<T>::insert;
+
         PriorityQueueOpenList();
 
         void insert(const T& item, double priority) override;
@@ -0,0 +1,58 @@
+#ifndef MIMIR_PLANNERS_TIE_BREAKING_OPEN_LIST_HPP_
+#define MIMIR_PLANNERS_TIE_BREAKING_OPEN_LIST_HPP_
+
+#include "open_list_base.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mimir::planners
+{
+    /// @brief An open list that orders items lexicographically by a fixed number of keys, such as the f-value, then the h-value, then the g-value.
+    /// Keys that are not given are 0, and items with equal keys are popped first in, first out. The keys of all items are stored in one array, so an
+    /// insertion does not allocate once the list has grown to its maximum size.
+    template<typename T>
+    class TieBreakingOpenList : public OpenListBase<T>
+    {
+      private:
+        struct Entry
+        {
+            std::size_t slot;  // The keys of the entry are keys_[slot * num_keys_, (slot + 1) * num_keys_)
+            uint64_t counter;
+            T item;
+        };
+
+        std::size_t num_keys_;
+        std::vector<double> keys_;
+        std::vector<std::size_t> free_slots_;
+        std::vector<Entry> heap_;
+        uint64_t counter_;
+
+        bool is_greater(const Entry& lhs, const Entry& rhs) const;
+
+        void push(const T& item, const double* keys, std::size_t num_keys);
+
+      public:
+        using OpenListBase<T>::insert;
+
+        /// @param num_keys The number of keys of every item, at least 1.
+        explicit TieBreakingOpenList(std::size_t num_keys = 2);
+
+        void insert(const T& item, double priority) override;
+
+        /// @brief Insert an item with the priority and the tie-breaker as its first two keys. The tie-breaker is ignored if the list has one key.
+        void insert(const T& item, double priority, double tie_breaker) override;
+
+        /// @brief Insert an item with the given keys, of which there must be at most as many as the list was created with.
+        void insert(const T& item, const std::vector<double>& keys);
+
+        T pop() override;
+
+        std::size_t size() override;
+    };
+
+    std::shared_ptr<TieBreakingOpenList<int32_t>> create_tie_breaking_open_list(std::size_t num_keys = 2);
+}  // namespace planners
+
+#endif  // MIMIR_PLANNERS_TIE_BREAKING_OPEN_LIST_HPP_
@@ -0,0 +1,93 @@
+#ifndef MIMIR_PLANNERS_SEARCH_SPACE_HPP_
+#define MIMIR_PLANNERS_SEARCH_SPACE_HPP_
+
+#include "../datastructures/robin_map.hpp"
+#include "../formalism/action.hpp"
+#include "../formalism/state_repository.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace mimir::planners
+{
+    /// @brief The search nodes of a single search. Every state of the state repository of the search has one node, identified by the id of the state,
+    /// so nodes are added in the order in which the states are interned. The fields of the nodes are stored in separate arrays: the ids of the parent
+    /// and of the creating action, the depth, the g- and h-values in single precision and the status bits, 21 bytes per node in total. Actions are
+    /// interned by address, which keeps the number of distinct ids small for successor generators that reuse their ground actions.
+    class SearchSpaceImpl
+    {
+      private:
+        static constexpr uint8_t closed_bit = 1;
+        static constexpr uint8_t evaluated_bit = 2;
+
+        std::vector<uint32_t> parent_ids_;
+        std::vector<uint32_t> action_ids_;
+        std::vector<uint32_t> depths_;
+        std::vector<float> g_values_;
+        std::vector<float> h_values_;
+        std::vector<uint8_t> status_;
+        mimir::formalism::ActionList actions_;
+        mimir::tsl::robin_map<const mimir::formalism::ActionImpl*, uint32_t> action_id_by_address_;
+
+        void set_bit(mimir::formalism::StateId id, uint8_t bit, bool value);
+
+      public:
+        static constexpr uint32_t no_id = std::numeric_limits<uint32_t>::max();
+
+        SearchSpaceImpl();
+
+        /// @brief Add the node of the initial state, which must be the first state of the repository.
+        void add_root_node(mimir::formalism::StateId id);
+
+        /// @brief Add the node of a state that was just interned. Its h-value is unknown and it is neither evaluated nor closed.
+        void add_node(mimir::formalism::StateId id, mimir::formalism::StateId parent_id, const mimir::formalism::Action& action, float g_value);
+
+        /// @brief Make the given state the parent of the node, when a cheaper path to it is found.
+        void set_parent(mimir::formalism::StateId id, mimir::formalism::StateId parent_id, const mimir::formalism::Action& action, float g_value);
+
+        /// @return The id of the parent, or no_id for the root node.
+        uint32_t get_parent_id(mimir::formalism::StateId id) const;
+
+        /// @return The creating action, or nullptr for the root node.
+        mimir::formalism::Action get_action(mimir::formalism::StateId id) const;
+
+        uint32_t get_depth(mimir::formalism::StateId id) const;
+
+        float get_g_value(mimir::formalism::StateId id) const;
+
+        float get_h_value(mimir::formalism::StateId id) const;
+
+        /// @brief Set the h-value of the node and mark it as evaluated.
+        void set_h_value(mimir::formalism::StateId id, double h_value);
+
+        bool is_evaluated(mimir::formalism::StateId id) const;
+
+        bool is_closed(mimir::formalism::StateId id) const;
+
+        void set_closed(mimir::formalism::StateId id, bool closed);
+
+        /// @brief Get the id of an action, interning it if it was not seen before.
+        uint32_t get_action_id(const mimir::formalism::Action& action);
+
+        const mimir::formalism::Action& get_action_by_id(uint32_t action_id) const;
+
+        /// @brief Get the actions on the path from the root node to the given node.
+        mimir::formalism::ActionList get_plan(mimir::formalism::StateId id) const;
+
+        std::size_t size() const;
+
+        /// @brief Get the number of bytes allocated for the nodes and the interned actions.
+        std::size_t memory_usage() const;
+
+        void clear();
+    };
+
+    using SearchSpace = std::shared_ptr<SearchSpaceImpl>;
+
+    SearchSpace create_search_space();
+}  // namespace mimir::planners
+
+#endif  // MIMIR_PLANNERS_SEARCH_SPACE_HPP_
@@ -6,13 +6,23 @@
 #include "../include/mimir/generators/successor_generator.hpp"
 #include "../include/mimir/generators/successor_generator_factory.hpp"
 #include "../include/mimir/pddl/parsers.hpp"
+#include "../include/mimir/search/batched_astar_search.hpp"
 #include "../include/mimir/search/breadth_first_search.hpp"
 #include "../include/mimir/search/eager_astar_search.hpp"
+#include "../include/mimir/search/hda_star_search.hpp"
+#include "../include/mimir/search/lazy_best_first_search.hpp"
 #include "../include/mimir/search/heuristics/h1_heuristic.hpp"
 #include "../include/mimir/search/heuristics/h2_heuristic.hpp"
 #include "../include/mimir/search/heuristics/heuristic_base.hpp"
+#include "../include/mimir/search/heuristics/pdb_heuristic.hpp"
+#include "../include/mimir/search/heuristics/relaxation_heuristic.hpp"
 #include "../include/mimir/search/openlists/open_list_base.hpp"
+#include "../include/mimir/search/openlists/alternation_open_list.hpp"
+#include "../include/mimir/search/openlists/bucket_open_list.hpp"
+#include "../include/mimir/search/openlists/epsilon_greedy_open_list.hpp"
+#include "../include/mimir/search/openlists/indexed_heap_open_list.hpp"
 #include "../include/mimir/search/openlists/priority_queue_open_list.hpp"
+#include "../include/mimir/search/openlists/tie_breaking_open_list.hpp"
 #include "../include/mimir/search/search_base.hpp"
 
 #include <Python.h>
@@ -158,9 +168,9 @@ std::shared_ptr<mimir::parsers::DomainParser> create_domain_parser(const std::st
 
 std::shared_ptr<mimir::parsers::ProblemParser> create_problem_parser(const std::string& path) { return std::make_shared<mimir::parsers::ProblemParser>(path); }
 
-std::shared_ptr<mimir::planners::LiftedSuccessorGenerator> create_lifted_successor_generator(const mimir::formalism::ProblemDescription& problem)
+std::shared_ptr<mimir::planners::LiftedSuccessorGenerator> create_lifted_successor_generator(const mimir::formalism::ProblemDescription& problem, std::size_t num_threads)
 {
-    auto successor_generator = mimir::planners::create_sucessor_generator(problem, mimir::planners::SuccessorGeneratorType::LIFTED);
+    auto successor_generator = mimir::planners::create_sucessor_generator(problem, mimir::planners::SuccessorGeneratorType::LIFTED, num_threads);
     return std::dynamic_pointer_cast<mimir::planners::LiftedSuccessorGenerator>(successor_generator);
 }
 
@@ -202,11 +212,23 @@ PYBIND11_MODULE(pymimir, m)
     py::class_<mimir::planners::SearchBase, mimir::planners::Search> search(m, "Search");
     py::class_<mimir::planners::BreadthFirstSearchImpl, mimir::planners::BreadthFirstSearch> breadth_first_search(m, "BreadthFirstSearch", search);
     py::class_<mimir::planners::EagerAStarSearchImpl, mimir::planners::EagerAStarSearch> eager_astar_search(m, "AStarSearch", search);
+    py::class_<mimir::planners::BatchedAStarSearchImpl, mimir::planners::BatchedAStarSearch> batched_astar_search(m, "BatchedAStarSearch", search);
+    py::class_<mimir::planners::LazyBestFirstSearchImpl, mimir::planners::LazyBestFirstSearch> lazy_best_first_search(m, "LazyBestFirstSearch", search);
+    py::class_<mimir::planners::HDAStarSearchImpl, mimir::planners::HDAStarSearch> hda_star_search(m, "HDAStarSearch", search);
     py::class_<mimir::planners::OpenListBase<int32_t>, mimir::planners::OpenList> open_list(m, "OpenList");
     py::class_<mimir::planners::PriorityQueueOpenList<int32_t>, std::shared_ptr<mimir::planners::PriorityQueueOpenList<int32_t>>> priority_queue_open_list(m, "PriorityQueueOpenList", open_list);
+    py::class_<mimir::planners::BucketOpenList<int32_t>, std::shared_ptr<mimir::planners::BucketOpenList<int32_t>>> bucket_open_list(m, "BucketOpenList", open_list);
+    py::class_<mimir::planners::TieBreakingOpenList<int32_t>, std::shared_ptr<mimir::planners::TieBreakingOpenList<int32_t>>> tie_breaking_open_list(m, "TieBreakingOpenList", open_list);
+    py::class_<mimir::planners::AlternationOpenList<int32_t>, std::shared_ptr<mimir::planners::AlternationOpenList<int32_t>>> alternation_open_list(m, "AlternationOpenList", open_list);
+    py::class_<mimir::planners::EpsilonGreedyOpenList<int32_t>, std::shared_ptr<mimir::planners::EpsilonGreedyOpenList<int32_t>>> epsilon_greedy_open_list(m, "EpsilonGreedyOpenList", open_list);
+    py::class_<mimir::planners::IndexedHeapOpenList<int32_t>, std::shared_ptr<mimir::planners::IndexedHeapOpenList<int32_t>>> indexed_heap_open_list(m, "IndexedHeapOpenList", open_list);
     py::class_<mimir::planners::HeuristicBase, mimir::planners::Heuristic> heuristic(m, "Heuristic");
-    py::class_<mimir::planners::H1Heuristic, std::shared_ptr<mimir::planners::H1Heuristic>> h1_heuristic(m, "H1Heuristic", heuristic);
+    py::enum_<mimir::planners::RelaxationType> relaxation_type(m, "RelaxationType");
+    py::class_<mimir::planners::RelaxationHeuristic, std::shared_ptr<mimir::planners::RelaxationHeuristic>> relaxation_heuristic(m, "RelaxationHeuristic", heuristic);
+    py::class_<mimir::planners::H1Heuristic, std::shared_ptr<mimir::planners::H1Heuristic>> h1_heuristic(m, "H1Heuristic", relaxation_heuristic);
     py::class_<mimir::planners::H2Heuristic, std::shared_ptr<mimir::planners::H2Heuristic>> h2_heuristic(m, "H2Heuristic", heuristic);
+    py::class_<mimir::planners::PDBHeuristic, std::shared_ptr<mimir::planners::PDBHeuristic>> pdb_heuristic(m, "PDBHeuristic", heuristic);
+    py::class_<mimir::planners::PDBBuilder, std::shared_ptr<mimir::planners::PDBBuilder>> pdb_builder(m, "PDBBuilder");
     py::class_<mimir::formalism::TransitionImpl, mimir::formalism::Transition> transition(m, "Transition");
     py::class_<LiteralGrounder, std::shared_ptr<LiteralGrounder>> literal_grounder(m, "LiteralGrounder");
     py::class_<mimir::planners::GoalMatcher, std::shared_ptr<mimir::planners::GoalMatcher>> goal_matcher(m, "GoalMatcher");
@@ -336,7 +358,7 @@ PYBIND11_MODULE(pymimir, m)
     successor_generator_base.def("get_applicable_actions", &mimir::planners::SuccessorGeneratorBase::get_applicable_actions, "state"_a, "Gets all ground actions applicable in the given state.");
     successor_generator_base.def("__repr__", [](const mimir::planners::SuccessorGeneratorBase& generator) { return "<SuccessorGenerator '" + generator.get_problem()->name + "'>"; });
 
-    lifted_successor_generator.def(py::init(&create_lifted_successor_generator), "problem"_a);
+    lifted_successor_generator.def(py::init(&create_lifted_successor_generator), "problem"_a, "num_threads"_a = 1);
     grounded_successor_generator.def(py::init(&create_grounded_successor_generator), "problem"_a);
 
     search.def("plan", [](const mimir::planners::Search& search) { mimir::formalism::ActionList plan; const auto result = search->plan(plan); return std::make_pair(result == mimir::planners::SearchResult::SOLVED, plan); });
@@ -347,11 +369,42 @@ PYBIND11_MODULE(pymimir, m)
 
     breadth_first_search.def(py::init(&mimir::planners::create_breadth_first_search), "problem"_a, "successor_generator"_a, "Creates a breadth-first search object.");
     eager_astar_search.def(py::init(&mimir::planners::create_eager_astar), "problem"_a, "successor_generator"_a, "heuristic"_a, "open_list"_a, "Creates an A* search object.");
+    batched_astar_search.def(py::init(&mimir::planners::create_batched_astar), "problem"_a, "successor_generator"_a, "heuristic"_a, "open_list"_a, "batch_size"_a = 0, "max_latency"_a = 0.0, "Creates an A* search object that evaluates the heuristic on batches of states, pipelined with the expansion if the batch size is positive.");
+    lazy_best_first_search.def(py::init(&mimir::planners::create_lazy_best_first_search), "problem"_a, "successor_generator"_a, "heuristic"_a, "open_list"_a, "preferred_open_list"_a = nullptr, "g_weight"_a = 0.0, "preferred_boost"_a = 1000, "Creates a best-first search object that evaluates states when they are generated from the open list, greedy if the weight of the g-value is zero.");
+    hda_star_search.def(py::init(&mimir::planners::create_hda_star), "problem"_a, "successor_generator"_a, "heuristics"_a, "Creates a parallel A* search object with one worker thread per heuristic, which distributes the states among the workers by their hash.");
 
     priority_queue_open_list.def(py::init(&mimir::planners::create_priority_queue_open_list), "Creates a priority queue open list object.");
+    bucket_open_list.def(py::init(&mimir::planners::create_bucket_open_list), "Creates an open list with one bucket per integer priority, which breaks ties by the lower heuristic value.");
+    tie_breaking_open_list.def(py::init(&mimir::planners::create_tie_breaking_open_list), "num_keys"_a = 2, "Creates an open list that orders items lexicographically by their priority and tie-breakers.");
+    alternation_open_list.def(py::init(&mimir::planners::create_alternation_open_list), "open_lists"_a, "Creates an open list that alternates between the given open lists.");
+    alternation_open_list.def("boost", &mimir::planners::AlternationOpenList<int32_t>::boost, "index"_a, "amount"_a, "Lets the open list with the given index be popped the given number of times before the others.");
+    epsilon_greedy_open_list.def(py::init(&mimir::planners::create_epsilon_greedy_open_list), "epsilon"_a = 0.2, "seed"_a = 0, "Creates an open list that pops a random item with probability epsilon, and an item of lowest priority otherwise.");
+    indexed_heap_open_list.def(py::init(&mimir::planners::create_indexed_heap_open_list), "arity"_a = 4, "Creates a d-ary heap open list that updates the priority of an item in place instead of inserting it again.");
+
+    relaxation_type.value("MAX", mimir::planners::RelaxationType::MAX);
+    relaxation_type.value("ADD", mimir::planners::RelaxationType::ADD);
+    relaxation_type.value("FF", mimir::planners::RelaxationType::FF);
+
+    heuristic.def("get_preferred_actions", &mimir::planners::HeuristicBase::get_preferred_actions, "state"_a, "Get the preferred operators of the state that was evaluated last.");
+
+    relaxation_heuristic.def(py::init(&mimir::planners::create_relaxation_heuristic), "problem"_a, "successor_generator"_a, "type"_a, "Creates a h_max, h_add or h_FF heuristic function object.");
+    relaxation_heuristic.def("get_relaxed_plan", &mimir::planners::RelaxationHeuristic::get_relaxed_plan, "Get the indices of the actions of the relaxed plan of the last evaluation, only computed for h_FF.");
 
     h1_heuristic.def(py::init(&mimir::planners::create_h1_heuristic), "problem"_a, "successor_generator"_a, "Creates a h1 heuristic function object.");
-    h2_heuristic.def(py::init(&mimir::planners::create_h2_heuristic), "problem"_a, "successor_generator"_a, "Creates a h2 heuristic function object.");
+    h2_heuristic.def(py::init(&mimir::planners::create_h2_heuristic), "problem"_a, "successor_generator"_a, "prune_mutex_pairs"_a = false, "Creates a h2 heuristic function object, optionally restricted to the pairs that are reachable from the initial state.");
+    h2_heuristic.def("get_table_size", &mimir::planners::H2Heuristic::get_table_size, "Get the number of entries of the table of pair costs.");
+    h2_heuristic.def("get_memory_usage", &mimir::planners::H2Heuristic::get_memory_usage, "Get the number of bytes allocated for the table and the compiled actions.");
+
+    pdb_heuristic.def(py::init(py::overload_cast<const mimir::formalism::ProblemDescription&, const mimir::planners::SuccessorGenerator&, const std::vector<std::vector<int32_t>>&>(&mimir::planners::create_pdb_heuristic)), "problem"_a, "successor_generator"_a, "patterns"_a, "Creates a canonical pattern database heuristic function object for the given patterns of atom ranks.");
+    pdb_heuristic.def(py::init(py::overload_cast<const mimir::formalism::ProblemDescription&, const mimir::planners::SuccessorGenerator&, std::size_t, std::size_t, std::size_t>(&mimir::planners::create_hill_climbing_pdb_heuristic)), "problem"_a, "successor_generator"_a, "max_pattern_states"_a, "max_collection_states"_a, "num_samples"_a, "Creates a canonical pattern database heuristic function object whose patterns are found by hill climbing.");
+    pdb_heuristic.def(py::init(py::overload_cast<const mimir::formalism::ProblemDescription&, const mimir::planners::SuccessorGenerator&, const std::vector<std::vector<int32_t>>&, mimir::planners::PDBBuilder&>(&mimir::planners::create_pdb_heuristic)), "problem"_a, "successor_generator"_a, "patterns"_a, "builder"_a, "Creates a canonical pattern database heuristic function object whose tables are built by the given builder.");
+    pdb_heuristic.def(py::init(py::overload_cast<const mimir::formalism::ProblemDescription&, const mimir::planners::SuccessorGenerator&, std::size_t, std::size_t, std::size_t, mimir::planners::PDBBuilder&>(&mimir::planners::create_hill_climbing_pdb_heuristic)), "problem"_a, "successor_generator"_a, "max_pattern_states"_a, "max_collection_states"_a, "num_samples"_a, "builder"_a, "Creates a canonical pattern database heuristic function object whose patterns are found by hill climbing and whose tables are built by the given builder.");
+    pdb_heuristic.def("get_patterns", &mimir::planners::PDBHeuristic::get_patterns, "Get the patterns of the collection.");
+    pdb_heuristic.def("get_memory_usage", &mimir::planners::PDBHeuristic::get_memory_usage, "Get the number of bytes allocated for the distance tables.");
+
+    pdb_builder.def(py::init<std::size_t, std::size_t, const std::string&>(), "num_threads"_a = 1, "memory_budget"_a = std::numeric_limits<std::size_t>::max(), "cache_directory"_a = "", "Creates a builder of pattern database tables with a thread pool, a memory budget in bytes, and an optional directory for persisted tables.");
+    pdb_builder.def("register_callback", &mimir::planners::PDBBuilder::register_handler, "callback_function"_a, "The callback function will be invoked whenever a batch of tables is done.");
+    pdb_builder.def("get_statistics", &mimir::planners::PDBBuilder::get_statistics, "Get the number of scheduled, built, loaded and rejected patterns, and the memory charged to the budget.");
 
     transition.def_readonly("source", &mimir::formalism::TransitionImpl::source_state, "Gets the source of the transition.");
     transition.def_readonly("target", &mimir::formalism::TransitionImpl::target_state, "Gets the target of the transition.");
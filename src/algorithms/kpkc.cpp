@@ -16,143 +16,243 @@
  */
 
 #include "../../include/mimir/algorithms/kpkc.hpp"
+#include "../../include/mimir/formalism/fixed_bitset.hpp"
+
+#include <algorithm>
+#include <stdexcept>
 
 namespace mimir::algorithms
 {
-    bool find_all_k_cliques_in_k_partite_graph_helper(const std::chrono::high_resolution_clock::time_point end_time,
-                                                      const std::vector<boost::dynamic_bitset<>>& adjacency_matrix,
-                                                      const std::vector<std::vector<size_t>>& partitions,
-                                                      std::vector<boost::dynamic_bitset<>>& compatible_vertices,
-                                                      boost::dynamic_bitset<>& partition_bits,
-                                                      boost::dynamic_bitset<>& not_partition_bits,  // TODO: Check if !partition_bits[i] is better...
-                                                      std::vector<size_t>& partial_solution,
-                                                      std::vector<std::vector<std::size_t>>& out_cliques)
+    FlatAdjacencyMatrix::FlatAdjacencyMatrix() : num_vertices_(0), num_words_per_row_(0), data_() {}
+
+    FlatAdjacencyMatrix::FlatAdjacencyMatrix(std::size_t num_vertices) : FlatAdjacencyMatrix() { reset(num_vertices); }
+
+    void FlatAdjacencyMatrix::reset(std::size_t num_vertices)
     {
-        if (std::chrono::high_resolution_clock::now() > end_time)
+        num_vertices_ = num_vertices;
+        num_words_per_row_ = (num_vertices + block_size - 1) / block_size;
+        data_.assign(num_vertices_ * num_words_per_row_, 0);
+    }
+
+    void FlatAdjacencyMatrix::clear() { std::fill(data_.begin(), data_.end(), 0); }
+
+    std::size_t FlatAdjacencyMatrix::num_vertices() const { return num_vertices_; }
+
+    std::size_t FlatAdjacencyMatrix::num_words_per_row() const { return num_words_per_row_; }
+
+    // Helper functions for bit ranges [begin, end) of a word array
+
+    inline std::size_t get_range_mask(std::size_t word_index, std::size_t begin, std::size_t end)
+    {
+        constexpr auto block_size = FlatAdjacencyMatrix::block_size;
+        const auto word_begin = word_index * block_size;
+        const auto low = (begin > word_begin) ? (begin - word_begin) : 0;
+        const auto high = std::min(end - word_begin, block_size);
+        const auto high_mask = (high == block_size) ? ~static_cast<std::size_t>(0) : ((static_cast<std::size_t>(1) << high) - 1);
+        return high_mask & (~static_cast<std::size_t>(0) << low);
+    }
+
+    inline std::size_t count_bits_in_range(const std::size_t* words, std::size_t begin, std::size_t end)
+    {
+        std::size_t count = 0;
+
+        for (auto word_index = begin / FlatAdjacencyMatrix::block_size; word_index * FlatAdjacencyMatrix::block_size < end; ++word_index)
         {
-            return false;
+            count += mimir::formalism::kernels::popcount_word(words[word_index] & get_range_mask(word_index, begin, end));
         }
 
-        size_t k = partitions.size();
-        size_t best_set_bits = std::numeric_limits<size_t>::max();
-        size_t best_partition = std::numeric_limits<size_t>::max();
+        return count;
+    }
 
-        // Find the best partition to work with
-        for (size_t partition = 0; partition < k; ++partition)
+    inline bool any_bit_in_range(const std::size_t* words, std::size_t begin, std::size_t end)
+    {
+        for (auto word_index = begin / FlatAdjacencyMatrix::block_size; word_index * FlatAdjacencyMatrix::block_size < end; ++word_index)
         {
-            const auto num_set_bits = compatible_vertices[partition].count();
+            if ((words[word_index] & get_range_mask(word_index, begin, end)) != 0)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    inline std::size_t get_lowest_bit_position(std::size_t word)
+    {
+#if defined(_MSC_VER)
+        unsigned long position;
+        _BitScanForward64(&position, word);
+        return static_cast<std::size_t>(position);
+#else
+        return static_cast<std::size_t>(__builtin_ctzll(word));
+#endif
+    }
+
+    KPartiteCliqueEnumerator::KPartiteCliqueEnumerator() : KPartiteCliqueEnumerator(std::vector<std::vector<std::size_t>>()) {}
 
-            if (not_partition_bits[partition] && (num_set_bits < best_set_bits))
+    KPartiteCliqueEnumerator::KPartiteCliqueEnumerator(const std::vector<std::vector<std::size_t>>& partitions) :
+        partition_begin_(),
+        partition_end_(),
+        num_vertices_(0),
+        num_words_(0),
+        compatible_vertices_stack_(),
+        partition_done_(partitions.size(), 0),
+        partial_solution_(),
+        steps_until_time_check_(time_check_interval),
+        stopped_(false)
+    {
+        for (const auto& partition : partitions)
+        {
+            for (std::size_t index = 0; index < partition.size(); ++index)
             {
-                best_set_bits = num_set_bits;
-                best_partition = partition;
+                if (partition[index] != (num_vertices_ + index))
+                {
+                    throw std::invalid_argument("the vertices of the partitions must be consecutive");
+                }
             }
+
+            partition_begin_.push_back(num_vertices_);
+            num_vertices_ += partition.size();
+            partition_end_.push_back(num_vertices_);
         }
 
-        size_t adjacent_index = compatible_vertices[best_partition].find_first();
+        // One set of compatible vertices for every depth of the search, the last one is never read but simplifies the bookkeeping
+
+        num_words_ = (num_vertices_ + FlatAdjacencyMatrix::block_size - 1) / FlatAdjacencyMatrix::block_size;
+        compatible_vertices_stack_.resize((partitions.size() + 1) * num_words_);
+        partial_solution_.reserve(partitions.size());
+    }
 
-        // Iterate through compatible vertices in the best partition
-        while (adjacent_index < compatible_vertices[best_partition].size())
+    bool KPartiteCliqueEnumerator::enumerate_helper(std::size_t depth,
+                                                    const std::chrono::high_resolution_clock::time_point end_time,
+                                                    const FlatAdjacencyMatrix& adjacency_matrix,
+                                                    const CliqueCallback& callback)
+    {
+        if (--steps_until_time_check_ == 0)
         {
+            steps_until_time_check_ = time_check_interval;
+
             if (std::chrono::high_resolution_clock::now() > end_time)
             {
+                stopped_ = true;
                 return false;
             }
+        }
+
+        const auto k = partition_begin_.size();
+        const auto compatible_vertices = compatible_vertices_stack_.data() + depth * num_words_;
+        const auto next_compatible_vertices = compatible_vertices + num_words_;
 
-            size_t vertex = partitions[best_partition][adjacent_index];
-            compatible_vertices[best_partition][adjacent_index] = 0;
-            partial_solution.push_back(vertex);
+        // Branch on the remaining partition with the fewest compatible vertices
 
-            if (partial_solution.size() == k)
+        std::size_t best_partition = k;
+        std::size_t best_num_vertices = std::numeric_limits<std::size_t>::max();
+
+        for (std::size_t partition = 0; partition < k; ++partition)
+        {
+            if (!partition_done_[partition])
             {
-                out_cliques.push_back(partial_solution);
+                const auto num_vertices = count_bits_in_range(compatible_vertices, partition_begin_[partition], partition_end_[partition]);
+
+                if (num_vertices < best_num_vertices)
+                {
+                    best_num_vertices = num_vertices;
+                    best_partition = partition;
+                }
             }
-            else
+        }
+
+        if ((best_partition == k) || (best_num_vertices == 0))
+        {
+            return true;
+        }
+
+        partition_done_[best_partition] = 1;
+
+        const auto begin = partition_begin_[best_partition];
+        const auto end = partition_end_[best_partition];
+
+        for (auto word_index = begin / FlatAdjacencyMatrix::block_size; word_index * FlatAdjacencyMatrix::block_size < end; ++word_index)
+        {
+            auto word = compatible_vertices[word_index] & get_range_mask(word_index, begin, end);
+
+            while (word != 0)
             {
-                // Update compatible vertices for the next recursion
-                std::vector<boost::dynamic_bitset<>> compatible_vertices_next = compatible_vertices;
-                size_t offset = 0;
-                for (size_t partition = 0; partition < k; ++partition)
+                const auto vertex = word_index * FlatAdjacencyMatrix::block_size + get_lowest_bit_position(word);
+                word &= word - 1;
+                partial_solution_.push_back(vertex);
+
+                if (partial_solution_.size() == k)
                 {
-                    const auto partition_size = compatible_vertices_next[partition].size();
-                    if (not_partition_bits[partition])
+                    if (!callback(partial_solution_))
                     {
-                        for (size_t index = 0; index < partition_size; ++index)
-                        {
-                            compatible_vertices_next[partition][index] &= adjacency_matrix[vertex][index + offset];
-                        }
+                        stopped_ = true;
                     }
-                    offset += partition_size;
                 }
+                else
+                {
+                    // Intersect all compatible vertices with the neighbours of the vertex at once, the chosen partitions are simply ignored
 
-                partition_bits[best_partition] = 1;
-                not_partition_bits[best_partition] = 0;
+                    mimir::formalism::kernels::bitwise_and(compatible_vertices, adjacency_matrix.get_row(vertex), next_compatible_vertices, num_words_);
 
-                size_t possible_additions = 0;
-                for (size_t partition = 0; partition < k; ++partition)
-                {
-                    if (not_partition_bits[partition] && compatible_vertices[partition].any())
+                    bool all_partitions_possible = true;
+
+                    for (std::size_t partition = 0; partition < k; ++partition)
                     {
-                        ++possible_additions;
+                        if (!partition_done_[partition] && !any_bit_in_range(next_compatible_vertices, partition_begin_[partition], partition_end_[partition]))
+                        {
+                            all_partitions_possible = false;
+                            break;
+                        }
                     }
-                }
 
-                if ((partial_solution.size() + possible_additions) == k)
-                {
-                    if (!find_all_k_cliques_in_k_partite_graph_helper(end_time,
-                                                                      adjacency_matrix,
-                                                                      partitions,
-                                                                      compatible_vertices_next,
-                                                                      partition_bits,
-                                                                      not_partition_bits,
-                                                                      partial_solution,
-                                                                      out_cliques))
+                    if (all_partitions_possible)
                     {
-                        return false;
+                        enumerate_helper(depth + 1, end_time, adjacency_matrix, callback);
                     }
                 }
 
-                partition_bits[best_partition] = 0;
-                not_partition_bits[best_partition] = 1;
-            }
+                partial_solution_.pop_back();
 
-            partial_solution.pop_back();
-            adjacent_index = compatible_vertices[best_partition].find_next(adjacent_index);
+                if (stopped_)
+                {
+                    partition_done_[best_partition] = 0;
+                    return false;
+                }
+            }
         }
 
+        partition_done_[best_partition] = 0;
         return true;
     }
 
-    bool find_all_k_cliques_in_k_partite_graph(const std::chrono::high_resolution_clock::time_point end_time,
-                                               const std::vector<boost::dynamic_bitset<>>& adjacency_matrix,
-                                               const std::vector<std::vector<size_t>>& partitions,
-                                               std::vector<std::vector<std::size_t>>& out_cliques)
+    bool KPartiteCliqueEnumerator::enumerate(const std::chrono::high_resolution_clock::time_point end_time,
+                                             const FlatAdjacencyMatrix& adjacency_matrix,
+                                             const CliqueCallback& callback)
     {
-        std::vector<boost::dynamic_bitset<>> compatible_vertices;
+        if (adjacency_matrix.num_vertices() != num_vertices_)
+        {
+            throw std::invalid_argument("the adjacency matrix does not match the partitions");
+        }
 
-        for (std::size_t index = 0; index < partitions.size(); ++index)
+        if (partition_begin_.empty())
         {
-            boost::dynamic_bitset<> bitset(partitions[index].size());
-            bitset.set();
-            compatible_vertices.push_back(std::move(bitset));
+            return true;
         }
 
-        const size_t k = partitions.size();
-        boost::dynamic_bitset<> partition_bits(k);
-        boost::dynamic_bitset<> not_partition_bits(k);
-        partition_bits.reset();
-        not_partition_bits.set();
-        std::vector<size_t> partial_solution;
-
-        const auto finished = find_all_k_cliques_in_k_partite_graph_helper(end_time,
-                                                                           adjacency_matrix,
-                                                                           partitions,
-                                                                           compatible_vertices,
-                                                                           partition_bits,
-                                                                           not_partition_bits,
-                                                                           partial_solution,
-                                                                           out_cliques);
-
-        return finished;
+        if (std::chrono::high_resolution_clock::now() > end_time)
+        {
+            return false;
+        }
+
+        // Initially, every vertex is compatible
+
+        std::fill(compatible_vertices_stack_.begin(), compatible_vertices_stack_.begin() + num_words_, ~static_cast<std::size_t>(0));
+        partial_solution_.clear();
+        steps_until_time_check_ = time_check_interval;
+        stopped_ = false;
+
+        enumerate_helper(0, end_time, adjacency_matrix, callback);
+        return !stopped_;
     }
 }  // namespace algorithms
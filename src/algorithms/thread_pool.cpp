@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2023 Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "../../include/mimir/algorithms/thread_pool.hpp"
+
+#include <stdexcept>
+
+namespace mimir::algorithms
+{
+    ThreadPool::ThreadPool(std::size_t num_threads) :
+        workers_(),
+        mutex_(),
+        batch_started_(),
+        batch_finished_(),
+        task_(nullptr),
+        num_tasks_(0),
+        next_task_(0),
+        num_busy_workers_(0),
+        exception_(),
+        batch_(0),
+        stopping_(false)
+    {
+        if (num_threads == 0)
+        {
+            throw std::invalid_argument("a thread pool needs at least one thread");
+        }
+
+        workers_.reserve(num_threads - 1);
+
+        for (std::size_t index = 1; index < num_threads; ++index)
+        {
+            workers_.emplace_back(&ThreadPool::worker_loop, this);
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+
+        batch_started_.notify_all();
+
+        for (auto& worker : workers_)
+        {
+            worker.join();
+        }
+    }
+
+    void ThreadPool::run_tasks(const std::function<void(std::size_t)>& task, std::size_t num_tasks)
+    {
+        // Tasks are handed out one at a time, so threads that finish early pick up the remaining work
+
+        for (auto index = next_task_.fetch_add(1); index < num_tasks; index = next_task_.fetch_add(1))
+        {
+            try
+            {
+                task(index);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+
+                if (!exception_)
+                {
+                    exception_ = std::current_exception();
+                }
+            }
+        }
+    }
+
+    void ThreadPool::worker_loop()
+    {
+        uint64_t last_batch = 0;
+
+        while (true)
+        {
+            const std::function<void(std::size_t)>* task = nullptr;
+            std::size_t num_tasks = 0;
+
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                batch_started_.wait(lock, [this, last_batch] { return stopping_ || (batch_ != last_batch); });
+
+                if (stopping_)
+                {
+                    return;
+                }
+
+                // A worker that wakes up after its batch has ended sees no tasks and goes back to sleep
+
+                last_batch = batch_;
+                task = task_;
+                num_tasks = num_tasks_;
+                ++num_busy_workers_;
+            }
+
+            if (task)
+            {
+                run_tasks(*task, num_tasks);
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+
+                if (--num_busy_workers_ == 0)
+                {
+                    batch_finished_.notify_one();
+                }
+            }
+        }
+    }
+
+    void ThreadPool::run(std::size_t num_tasks, const std::function<void(std::size_t)>& task)
+    {
+        if (num_tasks == 0)
+        {
+            return;
+        }
+
+        if (workers_.empty() || (num_tasks == 1))
+        {
+            for (std::size_t index = 0; index < num_tasks; ++index)
+            {
+                task(index);
+            }
+
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            task_ = &task;
+            num_tasks_ = num_tasks;
+            next_task_.store(0);
+            ++batch_;
+        }
+
+        batch_started_.notify_all();
+        run_tasks(task, num_tasks);
+
+        // All tasks have been handed out, wait until the workers that took some of them are done
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        batch_finished_.wait(lock, [this] { return num_busy_workers_ == 0; });
+        task_ = nullptr;
+        num_tasks_ = 0;
+
+        if (exception_)
+        {
+            // Rethrow the first exception of a task on the calling thread
+
+            auto exception = exception_;
+            exception_ = nullptr;
+            std::rethrow_exception(exception);
+        }
+    }
+
+    std::size_t ThreadPool::num_threads() const { return workers_.size() + 1; }
+}  // namespace algorithms
@@ -88,10 +88,30 @@ namespace mimir::formalism
         return implications;
     }
 
+    void use_unique_literals(const mimir::formalism::ProblemDescription& problem, mimir::formalism::LiteralList& literals)
+    {
+        for (auto& literal : literals)
+        {
+            literal = problem->create_literal(literal->atom, literal->negated);
+        }
+    }
+
+    std::size_t get_num_bits(const mimir::formalism::ProblemDescription& problem, const mimir::formalism::LiteralList& literals)
+    {
+        std::size_t num_bits = 0;
+
+        for (const auto& literal : literals)
+        {
+            num_bits = std::max(num_bits, static_cast<std::size_t>(problem->get_rank(literal->atom)) + 1);
+        }
+
+        return num_bits;
+    }
+
     void convert_to_bitsets(const mimir::formalism::ProblemDescription& problem,
                             const mimir::formalism::LiteralList& literals,
-                            mimir::formalism::Bitset& positive,
-                            mimir::formalism::Bitset& negative)
+                            mimir::formalism::FixedBitset& positive,
+                            mimir::formalism::FixedBitset& negative)
     {
         for (const auto& literal : literals)
         {
@@ -100,7 +120,7 @@ namespace mimir::formalism
 
             if (literal->negated)
             {
-                negative.unset(rank);
+                negative.set(rank);
             }
             else
             {
@@ -116,10 +136,10 @@ namespace mimir::formalism
                            mimir::formalism::LiteralList&& unconditional_effect,
                            mimir::formalism::ImplicationList&& conditional_effect,
                            double cost) :
-        applicability_positive_precondition_bitset_(0, false),
-        applicability_negative_precondition_bitset_(0, true),
-        unconditional_positive_effect_bitset_(0, false),
-        unconditional_negative_effect_bitset_(0, true),
+        applicability_positive_precondition_bitset_(),
+        applicability_negative_precondition_bitset_(),
+        unconditional_positive_effect_bitset_(),
+        unconditional_negative_effect_bitset_(),
         conditional_positive_precondition_bitsets_(),
         conditional_negative_precondition_bitsets_(),
         conditional_positive_effect_bitsets_(),
@@ -132,15 +152,40 @@ namespace mimir::formalism
         schema(schema),
         cost(cost)
     {
+        // Share the literals with all other actions of the problem, their atoms already know their ranks
+
+        use_unique_literals(problem, applicability_precondition_);
+        use_unique_literals(problem, unconditional_effect_);
+
+        for (auto& [antecedent, consequence] : conditional_effect_)
+        {
+            use_unique_literals(problem, antecedent);
+            use_unique_literals(problem, consequence);
+        }
+
+        // Use a single width for all bitsets so that the kernels never have to deal with bitsets of different sizes.
+
+        auto num_bits = std::max(get_num_bits(problem, applicability_precondition_), get_num_bits(problem, unconditional_effect_));
+
+        for (const auto& [antecedent, consequence] : conditional_effect_)
+        {
+            num_bits = std::max(num_bits, std::max(get_num_bits(problem, antecedent), get_num_bits(problem, consequence)));
+        }
+
+        applicability_positive_precondition_bitset_ = mimir::formalism::FixedBitset(num_bits);
+        applicability_negative_precondition_bitset_ = mimir::formalism::FixedBitset(num_bits);
+        unconditional_positive_effect_bitset_ = mimir::formalism::FixedBitset(num_bits);
+        unconditional_negative_effect_bitset_ = mimir::formalism::FixedBitset(num_bits);
+
         convert_to_bitsets(problem, applicability_precondition_, applicability_positive_precondition_bitset_, applicability_negative_precondition_bitset_);
         convert_to_bitsets(problem, unconditional_effect_, unconditional_positive_effect_bitset_, unconditional_negative_effect_bitset_);
 
         for (const auto& [antecedent, consequence] : conditional_effect_)
         {
-            mimir::formalism::Bitset positive_precondition(0, false);
-            mimir::formalism::Bitset negative_precondition(0, true);
-            mimir::formalism::Bitset positive_effect(0, false);
-            mimir::formalism::Bitset negative_effect(0, true);
+            mimir::formalism::FixedBitset positive_precondition(num_bits);
+            mimir::formalism::FixedBitset negative_precondition(num_bits);
+            mimir::formalism::FixedBitset positive_effect(num_bits);
+            mimir::formalism::FixedBitset negative_effect(num_bits);
 
             convert_to_bitsets(problem, antecedent, positive_precondition, negative_precondition);
             convert_to_bitsets(problem, consequence, positive_effect, negative_effect);
@@ -45,6 +45,7 @@ namespace mimir::formalism
 
     AtomImpl::AtomImpl(const mimir::formalism::Predicate& predicate, mimir::formalism::ObjectList&& arguments) :
         hash_(0),
+        rank_stamp_(0),
         predicate(predicate),
         arguments(std::move(arguments))
     {
@@ -53,6 +54,7 @@ namespace mimir::formalism
 
     AtomImpl::AtomImpl(const mimir::formalism::Predicate& predicate, const mimir::formalism::ObjectList& arguments) :
         hash_(0),
+        rank_stamp_(0),
         predicate(predicate),
         arguments(arguments)
     {
@@ -316,6 +318,16 @@ namespace std
             return false;
         }
 
+        // Atoms ranked by the same problem are equal if and only if their ranks are
+
+        const auto left_stamp = left_atom->rank_stamp_.load(std::memory_order_acquire);
+        const auto right_stamp = right_atom->rank_stamp_.load(std::memory_order_acquire);
+
+        if ((left_stamp != 0) && ((left_stamp >> 32) == (right_stamp >> 32)))
+        {
+            return left_stamp == right_stamp;
+        }
+
         const std::hash<mimir::formalism::Atom> hash;
 
         if (hash(left_atom) != hash(right_atom))
@@ -48,6 +48,22 @@ namespace mimir::formalism
     {
     }
 
+    Bitset::Bitset(const std::size_t* blocks, std::size_t num_blocks) : data(blocks, blocks + num_blocks), default_bit_value(false)
+    {
+        if (data.empty())
+        {
+            data.emplace_back(block_zeroes);
+        }
+    }
+
+    Bitset::Bitset(std::vector<std::size_t>&& blocks) : data(std::move(blocks)), default_bit_value(false)
+    {
+        if (data.empty())
+        {
+            data.emplace_back(block_zeroes);
+        }
+    }
+
     Bitset::Bitset(const Bitset& other) : data(other.data), default_bit_value(other.default_bit_value) {}
 
     Bitset::Bitset(Bitset&& other) noexcept : data(std::move(other.data)), default_bit_value(other.default_bit_value) {}
@@ -259,6 +275,10 @@ namespace mimir::formalism
 
         return true;
     }
+
+    const std::vector<std::size_t>& Bitset::get_blocks() const { return data; }
+
+    bool Bitset::get_default_bit_value() const { return default_bit_value; }
 }  // namespace mimir::formalism
 
 namespace std
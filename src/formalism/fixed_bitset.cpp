@@ -0,0 +1,33 @@
+/*
+ * Copyright (C) 2023 Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "../../include/mimir/formalism/fixed_bitset.hpp"
+
+#include <algorithm>
+
+namespace mimir::formalism
+{
+    FixedBitset::FixedBitset() : data_() {}
+
+    FixedBitset::FixedBitset(std::size_t num_bits) : data_(num_words_for(num_bits), 0) {}
+
+    FixedBitset::FixedBitset(const std::size_t* blocks, std::size_t num_blocks) : data_(blocks, blocks + num_blocks) {}
+
+    std::size_t FixedBitset::num_words_for(std::size_t num_bits) { return (num_bits + block_size - 1) / block_size; }
+
+    void FixedBitset::reset() { std::fill(data_.begin(), data_.end(), 0); }
+}  // namespace mimir::formalism
@@ -20,24 +20,49 @@
 #include "help_functions.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cmath>
 
 namespace mimir::formalism
 {
+    static std::atomic<uint32_t> next_problem_id(1);
+
+    std::size_t ProblemImpl::AtomRankHash::operator()(const mimir::formalism::Atom& atom) const { return std::hash<mimir::formalism::Atom>()(atom); }
+
+    std::size_t ProblemImpl::AtomRankHash::operator()(const AtomView& view) const
+    {
+        // Must agree with the hash of an atom with the same predicate and arguments
+        return hash_combine(view.predicate, view.arguments);
+    }
+
+    bool ProblemImpl::AtomRankEqual::operator()(const mimir::formalism::Atom& left_atom, const mimir::formalism::Atom& right_atom) const
+    {
+        return std::equal_to<mimir::formalism::Atom>()(left_atom, right_atom);
+    }
+
+    bool ProblemImpl::AtomRankEqual::operator()(const mimir::formalism::Atom& atom, const AtomView& view) const
+    {
+        return (atom->predicate == view.predicate) && (atom->arguments == view.arguments);
+    }
+
+    bool ProblemImpl::AtomRankEqual::operator()(const AtomView& view, const mimir::formalism::Atom& atom) const { return this->operator()(atom, view); }
+
     ProblemImpl::ProblemImpl(const std::string& name,
                              const mimir::formalism::DomainDescription& domain,
                              const mimir::formalism::ObjectList& objects,
                              const mimir::formalism::AtomList& initial,
                              const mimir::formalism::LiteralList& goal,
                              const std::unordered_map<mimir::formalism::Atom, double>& atom_costs) :
+        id_(next_problem_id.fetch_add(1)),
         static_atoms_(),
         predicate_id_to_static_(),
-        atom_ranks_(),
-        rank_to_atom_(),
-        rank_to_predicate_id_(),
-        rank_to_arity_(),
-        rank_to_argument_ids_(),
+        path_(),
+        frozen_ranks_(),
+        rank_shards_(),
+        rank_segments_(),
+        next_rank_(0),
+        num_ranks_(0),
         name(name),
         domain(domain),
         objects(objects),
@@ -69,6 +94,14 @@ namespace mimir::formalism
                   [](const mimir::formalism::Object& lhs, const mimir::formalism::Object& rhs) { return lhs->id < rhs->id; });
     }
 
+    ProblemImpl::~ProblemImpl()
+    {
+        for (auto& segment : rank_segments_)
+        {
+            delete[] segment.load();
+        }
+    }
+
     mimir::formalism::ProblemDescription ProblemImpl::replace_initial(const mimir::formalism::AtomList& initial) const
     {
         return create_problem(this->name, this->domain, this->objects, initial, this->goal, this->atom_costs);
@@ -80,91 +113,234 @@ namespace mimir::formalism
 
     fs::path ProblemImpl::get_path() const { return path_; }
 
-    uint32_t ProblemImpl::get_rank(const mimir::formalism::Atom& atom) const
+    inline std::size_t get_highest_bit_position(std::size_t word)
+    {
+#if defined(_MSC_VER)
+        unsigned long position;
+        _BitScanReverse64(&position, word);
+        return static_cast<std::size_t>(position);
+#else
+        return static_cast<std::size_t>(63 - __builtin_clzll(word));
+#endif
+    }
+
+    // The segment k holds the ranks [first_segment_size * (2^k - 1), first_segment_size * (2^(k + 1) - 1))
+    inline std::pair<std::size_t, std::size_t> get_segment_position(uint32_t rank, std::size_t first_segment_size)
+    {
+        const auto segment = get_highest_bit_position((rank / first_segment_size) + 1);
+        const auto offset = rank - (first_segment_size * ((static_cast<std::size_t>(1) << segment) - 1));
+        return { segment, offset };
+    }
+
+    ProblemImpl::RankShard& ProblemImpl::get_rank_shard(std::size_t hash) const
+    {
+        // The maps of the shards use the lower bits of the hash, so the shard is chosen by the upper bits of a mixed hash
+        return rank_shards_[(static_cast<uint64_t>(hash) * 0x9e3779b97f4a7c15ull) >> 58];
+    }
+
+    const ProblemImpl::RankRecord& ProblemImpl::get_rank_record(uint32_t rank) const
+    {
+        const auto [segment, offset] = get_segment_position(rank, first_segment_size);
+        const auto records = rank_segments_[segment].load(std::memory_order_acquire);
+        assert(records);
+        return records[offset];
+    }
+
+    ProblemImpl::RankRecord& ProblemImpl::allocate_rank_record(uint32_t rank) const
     {
-        auto& rank_with_offset = atom_ranks_[atom];
+        const auto [segment, offset] = get_segment_position(rank, first_segment_size);
+        auto records = rank_segments_[segment].load(std::memory_order_acquire);
 
-        if (rank_with_offset == 0)
+        if (!records)
         {
-            // Indexing creates a new item if none exists, thus the size is at least 1.
-            rank_with_offset = static_cast<uint32_t>(atom_ranks_.size());
-
-            assert(rank_to_atom_.size() == (rank_with_offset - 1));
-            assert(rank_to_predicate_id_.size() == (rank_with_offset - 1));
-            assert(rank_to_arity_.size() == (rank_with_offset - 1));
-            assert(rank_to_argument_ids_.size() == (rank_with_offset - 1));
-
-            rank_to_atom_.emplace_back(atom);
-            rank_to_predicate_id_.emplace_back(atom->predicate->id);
-            rank_to_arity_.emplace_back(atom->predicate->arity);
-
-            std::vector<uint32_t> predicate_ids;
-            predicate_ids.reserve(atom->arguments.size());
-            std::transform(atom->arguments.cbegin(),
-                           atom->arguments.cend(),
-                           std::back_insert_iterator(predicate_ids),
-                           [](const mimir::formalism::Object& object) { return object->id; });
-            rank_to_argument_ids_.emplace_back(std::move(predicate_ids));
+            // Threads that add the first ranks of a segment at the same time race to allocate it, all but one discard their allocation
+
+            const auto allocated_records = new RankRecord[first_segment_size << segment]();
+
+            if (rank_segments_[segment].compare_exchange_strong(records, allocated_records, std::memory_order_acq_rel))
+            {
+                records = allocated_records;
+            }
+            else
+            {
+                delete[] allocated_records;
+            }
         }
 
-        return rank_with_offset - 1;
+        return records[offset];
     }
 
-    std::vector<uint32_t> ProblemImpl::to_ranks(const mimir::formalism::AtomList& atoms) const
+    void ProblemImpl::publish_rank(RankRecord& record) const
     {
-        std::vector<uint32_t> ranks;
+        record.published.store(true);
 
-        for (const auto& atom : atoms)
+        // Ranks are published out of order, the count only covers the ranks before the first one that is not published yet. Whichever thread
+        // publishes the last missing rank moves the count past all ranks that were published before.
+
+        auto count = num_ranks_.load();
+
+        while (count < next_rank_.load())
         {
-            ranks.emplace_back(get_rank(atom));
+            const auto [segment, offset] = get_segment_position(count, first_segment_size);
+            const auto records = rank_segments_[segment].load();
+
+            if (!records || !records[offset].published.load())
+            {
+                break;
+            }
+
+            num_ranks_.compare_exchange_weak(count, count + 1);
         }
+    }
 
-        return ranks;
+    uint32_t ProblemImpl::add_rank(const mimir::formalism::Atom& atom, std::size_t hash) const
+    {
+        auto& shard = get_rank_shard(hash);
+
+        {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            const auto iter = shard.ranks.find(atom, hash);
+
+            if (iter != shard.ranks.end())
+            {
+                return iter->second;
+            }
+        }
+
+        // Another thread may have ranked the atom in the meantime, then the rank it assigned is used. The record is complete before the atom is
+        // added to the shard, so threads that find the atom there can read it.
+
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        const auto iter = shard.ranks.find(atom, hash);
+
+        if (iter != shard.ranks.end())
+        {
+            return iter->second;
+        }
+
+        const auto rank = next_rank_.fetch_add(1);
+        auto& record = allocate_rank_record(rank);
+        record.atom = atom;
+        record.literals[0] = mimir::formalism::create_literal(atom, false);
+        record.literals[1] = mimir::formalism::create_literal(atom, true);
+        record.predicate_id = atom->predicate->id;
+        record.arity = atom->predicate->arity;
+        record.argument_ids.reserve(atom->arguments.size());
+        std::transform(atom->arguments.cbegin(),
+                       atom->arguments.cend(),
+                       std::back_insert_iterator(record.argument_ids),
+                       [](const mimir::formalism::Object& object) { return object->id; });
+        shard.ranks.emplace(atom, rank);
+        lock.unlock();
+
+        publish_rank(record);
+        return rank;
     }
 
-    uint32_t ProblemImpl::num_ranks() const { return static_cast<uint32_t>(atom_ranks_.size()); }
+    uint32_t ProblemImpl::get_rank(const mimir::formalism::Atom& atom) const
+    {
+        const auto stamp = atom->rank_stamp_.load(std::memory_order_acquire);
 
-    bool ProblemImpl::is_static(uint32_t rank) const { return rank < static_atoms_.size(); }
+        if ((stamp >> 32) == id_)
+        {
+            return static_cast<uint32_t>(stamp);
+        }
 
-    bool ProblemImpl::is_dynamic(uint32_t rank) const { return !is_static(rank); }
+        const auto hash = AtomRankHash()(atom);
+        const auto iter = frozen_ranks_.find(atom, hash);
+        const auto rank = (iter != frozen_ranks_.end()) ? iter->second : add_rank(atom, hash);
+
+        // An atom keeps the rank of the first problem that ranks it, other problems fall back to the lookup above
+
+        uint64_t unranked = 0;
+        atom->rank_stamp_.compare_exchange_strong(unranked, (static_cast<uint64_t>(id_) << 32) | rank, std::memory_order_acq_rel);
 
-    uint32_t ProblemImpl::get_arity(uint32_t rank) const
+        return rank;
+    }
+
+    void ProblemImpl::freeze_ranks() const
     {
-        assert(rank < rank_to_arity_.size());
-        return rank_to_arity_.at(rank);
+        for (auto& shard : rank_shards_)
+        {
+            frozen_ranks_.insert(shard.ranks.begin(), shard.ranks.end());
+            shard.ranks.clear();
+        }
     }
 
-    uint32_t ProblemImpl::get_predicate_id(uint32_t rank) const
+    uint32_t ProblemImpl::num_frozen_ranks() const { return static_cast<uint32_t>(frozen_ranks_.size()); }
+
+    mimir::formalism::Atom ProblemImpl::create_atom(const mimir::formalism::Predicate& predicate, mimir::formalism::ObjectList&& arguments) const
     {
-        assert(rank < rank_to_predicate_id_.size());
-        return rank_to_predicate_id_.at(rank);
+        const AtomView view { predicate, arguments };
+        const auto hash = AtomRankHash()(view);
+        const auto frozen_iter = frozen_ranks_.find(view, hash);
+
+        if (frozen_iter != frozen_ranks_.end())
+        {
+            return get_rank_record(frozen_iter->second).atom;
+        }
+
+        {
+            auto& shard = get_rank_shard(hash);
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            const auto iter = shard.ranks.find(view, hash);
+
+            if (iter != shard.ranks.end())
+            {
+                return get_rank_record(iter->second).atom;
+            }
+        }
+
+        // If another thread creates the same atom concurrently, both get the atom that was ranked first
+
+        return get_rank_record(get_rank(mimir::formalism::create_atom(predicate, std::move(arguments)))).atom;
     }
 
-    const std::vector<uint32_t>& ProblemImpl::get_argument_ids(uint32_t rank) const
+    mimir::formalism::Literal ProblemImpl::create_literal(const mimir::formalism::Atom& atom, bool negated) const
     {
-        assert(rank < rank_to_argument_ids_.size());
-        return rank_to_argument_ids_.at(rank);
+        return get_rank_record(get_rank(atom)).literals[negated ? 1 : 0];
     }
 
-    mimir::formalism::Atom ProblemImpl::get_atom(uint32_t rank) const
+    std::vector<uint32_t> ProblemImpl::to_ranks(const mimir::formalism::AtomList& atoms) const
     {
-        assert(rank < rank_to_atom_.size());
-        return rank_to_atom_.at(rank);
+        std::vector<uint32_t> ranks;
+
+        for (const auto& atom : atoms)
+        {
+            ranks.emplace_back(get_rank(atom));
+        }
+
+        return ranks;
     }
 
+    uint32_t ProblemImpl::num_ranks() const { return num_ranks_.load(std::memory_order_acquire); }
+
+    bool ProblemImpl::is_static(uint32_t rank) const { return rank < static_atoms_.size(); }
+
+    bool ProblemImpl::is_dynamic(uint32_t rank) const { return !is_static(rank); }
+
+    uint32_t ProblemImpl::get_arity(uint32_t rank) const { return get_rank_record(rank).arity; }
+
+    uint32_t ProblemImpl::get_predicate_id(uint32_t rank) const { return get_rank_record(rank).predicate_id; }
+
+    const std::vector<uint32_t>& ProblemImpl::get_argument_ids(uint32_t rank) const { return get_rank_record(rank).argument_ids; }
+
+    mimir::formalism::Atom ProblemImpl::get_atom(uint32_t rank) const { return get_rank_record(rank).atom; }
+
     mimir::formalism::AtomList ProblemImpl::get_encountered_atoms() const
     {
         mimir::formalism::AtomList atoms;
+        const auto count = num_ranks();
 
-        for (const auto& [key, value] : atom_ranks_)
+        for (uint32_t rank = 0; rank < count; ++rank)
         {
-            atoms.emplace_back(key);
+            atoms.emplace_back(get_rank_record(rank).atom);
         }
 
         return atoms;
     }
 
-    uint32_t ProblemImpl::num_encountered_atoms() const { return static_cast<uint32_t>(atom_ranks_.size()); }
+    uint32_t ProblemImpl::num_encountered_atoms() const { return num_ranks(); }
 
     mimir::formalism::Object ProblemImpl::get_object(uint32_t object_id) const
     {
@@ -265,6 +265,12 @@ namespace mimir::formalism
 
     mimir::formalism::ProblemDescription StateImpl::get_problem() const { return problem_; }
 
+    const std::vector<std::size_t>& StateImpl::get_blocks() const
+    {
+        assert(!bitset_.get_default_bit_value());
+        return bitset_.get_blocks();
+    }
+
     std::map<mimir::formalism::Predicate, mimir::formalism::AtomList> StateImpl::get_atoms_grouped_by_predicate() const
     {
         std::map<mimir::formalism::Predicate, mimir::formalism::AtomList> grouped_atoms;
@@ -410,66 +416,115 @@ namespace mimir::formalism
         return true;
     }
 
-    bool is_applicable(const mimir::formalism::Action& action, const mimir::formalism::State& state)
+    // The bitsets of an action and a state do not necessarily have the same number of words, the missing words of either are treated as unset.
+
+    inline bool is_subset_of_words(const mimir::formalism::FixedBitset& bitset, const std::size_t* words, std::size_t num_words)
+    {
+        const auto num_common_words = std::min(bitset.num_words(), num_words);
+        return mimir::formalism::kernels::is_subset(bitset.data(), words, num_common_words)
+               && mimir::formalism::kernels::is_zero(bitset.data() + num_common_words, bitset.num_words() - num_common_words);
+    }
+
+    inline bool intersects_words(const mimir::formalism::FixedBitset& bitset, const std::size_t* words, std::size_t num_words)
+    {
+        return mimir::formalism::kernels::intersects(bitset.data(), words, std::min(bitset.num_words(), num_words));
+    }
+
+    bool is_applicable(const mimir::formalism::Action& action, const std::size_t* words, std::size_t num_words)
     {
         if (static_cast<int32_t>(action->get_arguments().size()) != action->schema->arity)
         {
             throw std::runtime_error("is_applicable: action is not ground");
         }
 
-        auto bitset = state->bitset_;
-        bitset |= action->applicability_positive_precondition_bitset_;
-        bitset &= action->applicability_negative_precondition_bitset_;
-        return state->bitset_ == bitset;
+        return is_subset_of_words(action->applicability_positive_precondition_bitset_, words, num_words)
+               && !intersects_words(action->applicability_negative_precondition_bitset_, words, num_words);
     }
 
-    mimir::formalism::State apply(const mimir::formalism::Action& action, const mimir::formalism::State& state)
+    bool is_applicable(const mimir::formalism::Action& action, const mimir::formalism::State& state)
+    {
+        const auto& blocks = state->bitset_.get_blocks();
+        assert(!state->bitset_.get_default_bit_value());
+        return is_applicable(action, blocks.data(), blocks.size());
+    }
+
+    void apply_into(const mimir::formalism::Action& action,
+                    const std::size_t* parent_words,
+                    std::size_t num_parent_words,
+                    std::vector<std::size_t>& out_words)
     {
         // We first apply the delete lists, followed by the add lists to prevent actions from simultaneously negating and establishing the same condition.
 
-        auto bitset = state->bitset_;
+        const auto num_action_words = action->unconditional_positive_effect_bitset_.num_words();
+        const auto num_common_words = std::min(num_parent_words, num_action_words);
+        out_words.resize(std::max(num_parent_words, num_action_words));
+
+        // Apply the unconditional delete list and add list in a single pass, words outside of the common range are copied from whichever is longer.
+
+        mimir::formalism::kernels::apply_effect(parent_words,
+                                                action->unconditional_negative_effect_bitset_.data(),
+                                                action->unconditional_positive_effect_bitset_.data(),
+                                                out_words.data(),
+                                                num_common_words);
+        std::copy(parent_words + num_common_words, parent_words + num_parent_words, out_words.begin() + num_common_words);
+        std::copy(action->unconditional_positive_effect_bitset_.data() + num_common_words,
+                  action->unconditional_positive_effect_bitset_.data() + num_action_words,
+                  out_words.begin() + num_common_words);
+
         const auto num_conditional_effects = action->conditional_positive_precondition_bitsets_.size();
 
         if (num_conditional_effects > 0)
         {
-            std::vector<std::size_t> applicable_conditional_effects;
+            // The conditions are evaluated in the parent, which is left untouched, so they are simply evaluated again for the add lists instead of
+            // remembering which ones hold.
 
-            for (std::size_t index = 0; index < num_conditional_effects; ++index)
+            const auto condition_holds = [&](std::size_t index)
             {
-                if ((bitset == (bitset | action->conditional_positive_precondition_bitsets_[index])) &&  // positive preconditions
-                    (bitset == (bitset & action->conditional_negative_precondition_bitsets_[index])))    // negative preconditions
-                {
-                    applicable_conditional_effects.emplace_back(index);
-                }
-            }
+                return is_subset_of_words(action->conditional_positive_precondition_bitsets_[index], parent_words, num_parent_words)
+                       && !intersects_words(action->conditional_negative_precondition_bitsets_[index], parent_words, num_parent_words);
+            };
 
-            // Apply the delete lists
+            bool any_condition_holds = false;
 
-            bitset &= action->unconditional_negative_effect_bitset_;
+            // Apply the delete lists
 
-            for (const auto& index : applicable_conditional_effects)
+            for (std::size_t index = 0; index < num_conditional_effects; ++index)
             {
-                bitset &= action->conditional_negative_effect_bitsets_[index];
+                if (condition_holds(index))
+                {
+                    const auto& negative_effect = action->conditional_negative_effect_bitsets_[index];
+                    mimir::formalism::kernels::bitwise_andnot(out_words.data(), negative_effect.data(), out_words.data(), num_action_words);
+                    any_condition_holds = true;
+                }
             }
 
-            // Apply the add lists
+            // Apply the add lists, the unconditional add list has to be reapplied in case a conditional delete list removed an atom of it
 
-            bitset |= action->unconditional_positive_effect_bitset_;
-
-            for (const auto& index : applicable_conditional_effects)
+            if (any_condition_holds)
             {
-                bitset |= action->conditional_positive_effect_bitsets_[index];
+                const auto& positive_effect = action->unconditional_positive_effect_bitset_;
+                mimir::formalism::kernels::bitwise_or(out_words.data(), positive_effect.data(), out_words.data(), num_action_words);
+
+                for (std::size_t index = 0; index < num_conditional_effects; ++index)
+                {
+                    if (condition_holds(index))
+                    {
+                        const auto& conditional_positive_effect = action->conditional_positive_effect_bitsets_[index];
+                        mimir::formalism::kernels::bitwise_or(out_words.data(), conditional_positive_effect.data(), out_words.data(), num_action_words);
+                    }
+                }
             }
         }
-        else
-        {
-            // Apply the delete list, then the add list
+    }
 
-            bitset &= action->unconditional_negative_effect_bitset_;
-            bitset |= action->unconditional_positive_effect_bitset_;
-        }
+    mimir::formalism::State apply(const mimir::formalism::Action& action, const mimir::formalism::State& state)
+    {
+        const auto& blocks = state->bitset_.get_blocks();
+        assert(!state->bitset_.get_default_bit_value());
 
-        return std::make_shared<mimir::formalism::StateImpl>(std::move(bitset), state->problem_);
+        std::vector<std::size_t> words;
+        apply_into(action, blocks.data(), blocks.size(), words);
+        return std::make_shared<mimir::formalism::StateImpl>(mimir::formalism::Bitset(std::move(words)), state->problem_);
     }
 
     bool atoms_hold(const AtomList& atoms, const mimir::formalism::State& state)
@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2023 Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "../../include/mimir/algorithms/murmurhash3.hpp"
+#include "../../include/mimir/formalism/state_repository.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <stdexcept>
+
+namespace mimir::formalism
+{
+    std::size_t StateRepositoryImpl::StateIdHash::operator()(const BlockView& view) const
+    {
+        int64_t hash[2];
+        MurmurHash3_x64_128(view.blocks, static_cast<int>(view.num_blocks * sizeof(std::size_t)), 0, hash);
+        return static_cast<std::size_t>(hash[0] + 0x9e3779b9 + (hash[1] << 6) + (hash[1] >> 2));
+    }
+
+    std::size_t StateRepositoryImpl::hash(const std::size_t* blocks, std::size_t num_blocks)
+    {
+        return StateIdHash { nullptr }(BlockView { blocks, trim(blocks, num_blocks) });
+    }
+
+    std::size_t StateRepositoryImpl::StateIdHash::operator()(StateId id) const { return this->operator()(repository->get_view(id)); }
+
+    bool StateRepositoryImpl::StateIdEqual::operator()(StateId id, const BlockView& view) const
+    {
+        const auto stored_view = repository->get_view(id);
+
+        if (stored_view.num_blocks != view.num_blocks)
+        {
+            return false;
+        }
+
+        return std::equal(stored_view.blocks, stored_view.blocks + stored_view.num_blocks, view.blocks);
+    }
+
+    bool StateRepositoryImpl::StateIdEqual::operator()(const BlockView& view, StateId id) const { return this->operator()(id, view); }
+
+    bool StateRepositoryImpl::StateIdEqual::operator()(StateId left_id, StateId right_id) const
+    {
+        return (left_id == right_id) || this->operator()(left_id, repository->get_view(right_id));
+    }
+
+    StateRepositoryImpl::StateRepositoryImpl(const mimir::formalism::ProblemDescription& problem, std::size_t chunk_size) :
+        problem_(problem),
+        chunks_(),
+        chunk_size_(chunk_size),
+        chunk_capacity_(0),
+        chunk_used_(0),
+        num_chunk_blocks_(0),
+        state_blocks_(),
+        state_num_blocks_(),
+        state_ids_(0, StateIdHash { this }, StateIdEqual { this })
+    {
+        if (chunk_size == 0)
+        {
+            throw std::invalid_argument("chunk size must be positive");
+        }
+    }
+
+    StateRepositoryImpl::BlockView StateRepositoryImpl::get_view(StateId id) const
+    {
+        assert(id < state_blocks_.size());
+        return BlockView { state_blocks_[id], state_num_blocks_[id] };
+    }
+
+    std::size_t* StateRepositoryImpl::allocate_blocks(std::size_t num_blocks)
+    {
+        if (chunks_.empty() || ((chunk_used_ + num_blocks) > chunk_capacity_))
+        {
+            // The blocks of a state are never split between chunks, so a state larger than the chunk size gets a chunk of its own.
+            chunk_capacity_ = std::max(chunk_size_, num_blocks);
+            chunks_.emplace_back(new std::size_t[chunk_capacity_]);
+            chunk_used_ = 0;
+            num_chunk_blocks_ += chunk_capacity_;
+        }
+
+        const auto blocks = chunks_.back().get() + chunk_used_;
+        chunk_used_ += num_blocks;
+        return blocks;
+    }
+
+    std::size_t StateRepositoryImpl::trim(const std::size_t* blocks, std::size_t num_blocks)
+    {
+        // Trailing zero blocks do not affect the state, ignore them so that equal states have equal representations.
+
+        while ((num_blocks > 0) && (blocks[num_blocks - 1] == 0))
+        {
+            --num_blocks;
+        }
+
+        return num_blocks;
+    }
+
+    bool StateRepositoryImpl::insert(const std::size_t* blocks, std::size_t num_blocks, StateId& out_id)
+    {
+        const BlockView view { blocks, trim(blocks, num_blocks) };
+        const auto hash = state_ids_.hash_function()(view);
+        const auto handler = state_ids_.find(view, hash);
+
+        if (handler != state_ids_.end())
+        {
+            out_id = *handler;
+            return false;
+        }
+
+        if (state_blocks_.size() >= static_cast<std::size_t>(std::numeric_limits<StateId>::max()))
+        {
+            throw std::overflow_error("too many states in the repository");
+        }
+
+        const auto stored_blocks = allocate_blocks(view.num_blocks);
+        std::copy(view.blocks, view.blocks + view.num_blocks, stored_blocks);
+
+        out_id = static_cast<StateId>(state_blocks_.size());
+        state_blocks_.emplace_back(stored_blocks);
+        state_num_blocks_.emplace_back(static_cast<uint32_t>(view.num_blocks));
+        state_ids_.insert(out_id);
+        return true;
+    }
+
+    bool StateRepositoryImpl::insert(const mimir::formalism::State& state, StateId& out_id)
+    {
+        if (state->problem_ != problem_)
+        {
+            throw std::invalid_argument("state belongs to a different problem");
+        }
+
+        const auto& blocks = state->bitset_.get_blocks();
+        return insert(blocks.data(), blocks.size(), out_id);
+    }
+
+    bool StateRepositoryImpl::find(const mimir::formalism::State& state, StateId& out_id) const
+    {
+        if (state->problem_ != problem_)
+        {
+            return false;
+        }
+
+        const auto& blocks = state->bitset_.get_blocks();
+        const auto handler = state_ids_.find(BlockView { blocks.data(), trim(blocks.data(), blocks.size()) });
+
+        if (handler == state_ids_.end())
+        {
+            return false;
+        }
+
+        out_id = *handler;
+        return true;
+    }
+
+    mimir::formalism::State StateRepositoryImpl::get_state(StateId id) const
+    {
+        const auto view = get_view(id);
+        return std::make_shared<StateImpl>(Bitset(view.blocks, view.num_blocks), problem_);
+    }
+
+    const std::size_t* StateRepositoryImpl::get_blocks(StateId id) const { return get_view(id).blocks; }
+
+    std::size_t StateRepositoryImpl::get_num_blocks(StateId id) const { return get_view(id).num_blocks; }
+
+    mimir::formalism::ProblemDescription StateRepositoryImpl::get_problem() const { return problem_; }
+
+    std::size_t StateRepositoryImpl::size() const { return state_blocks_.size(); }
+
+    std::size_t StateRepositoryImpl::memory_usage() const
+    {
+        // The bucket size is an estimate: the id, the stored hash and the distance to the ideal bucket.
+
+        std::size_t memory = 0;
+        memory += num_chunk_blocks_ * sizeof(std::size_t);
+        memory += state_blocks_.capacity() * sizeof(const std::size_t*);
+        memory += state_num_blocks_.capacity() * sizeof(uint32_t);
+        memory += state_ids_.bucket_count() * (sizeof(StateId) + sizeof(uint32_t) + sizeof(int16_t));
+        return memory;
+    }
+
+    void StateRepositoryImpl::clear()
+    {
+        state_ids_.clear();
+        state_blocks_.clear();
+        state_num_blocks_.clear();
+        chunks_.clear();
+        chunk_capacity_ = 0;
+        chunk_used_ = 0;
+        num_chunk_blocks_ = 0;
+    }
+
+    StateRepository create_state_repository(const mimir::formalism::ProblemDescription& problem)
+    {
+        return std::make_shared<StateRepositoryImpl>(problem);
+    }
+}  // namespace mimir::formalism
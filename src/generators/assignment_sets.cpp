@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2023 Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "../../include/mimir/generators/assignment_sets.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+namespace mimir::planners
+{
+    std::size_t
+    get_assignment_position(int32_t first_position, int32_t first_object, int32_t second_position, int32_t second_object, int32_t arity, int32_t num_objects)
+    {
+        const auto first = 1;
+        const auto second = first * (arity + 1);
+        const auto third = second * (arity + 1);
+        const auto fourth = third * (num_objects + 1);
+        const auto rank = (first * (first_position + 1)) + (second * (second_position + 1)) + (third * (first_object + 1)) + (fourth * (second_object + 1));
+        return (std::size_t) rank;
+    }
+
+    std::size_t num_assignments(int32_t arity, int32_t num_objects)
+    {
+        const auto first = 1;
+        const auto second = first * (arity + 1);
+        const auto third = second * (arity + 1);
+        const auto fourth = third * (num_objects + 1);
+        const auto max = (first * arity) + (second * arity) + (third * num_objects) + (fourth * num_objects);
+        return (std::size_t)(max + 1);
+    }
+
+    AssignmentSets::AssignmentSets(const mimir::formalism::DomainDescription& domain, const mimir::formalism::ProblemDescription& problem) :
+        problem_(problem),
+        num_objects_(static_cast<int32_t>(problem->objects.size())),
+        offsets_(),
+        assignments_(),
+        supports_(),
+        ranks_(),
+        is_fixed_(false)
+    {
+        std::size_t num_positions = 0;
+        offsets_.resize(domain->predicates.size());
+
+        for (const auto& predicate : domain->predicates)
+        {
+            offsets_[predicate->id] = num_positions;
+            num_positions += num_assignments(predicate->arity, num_objects_);
+        }
+
+        assignments_ = mimir::formalism::FixedBitset(num_positions);
+    }
+
+    AssignmentSets::AssignmentSets(const mimir::formalism::DomainDescription& domain,
+                                   const mimir::formalism::ProblemDescription& problem,
+                                   const std::vector<uint32_t>& ranks) :
+        AssignmentSets(domain, problem)
+    {
+        assert(std::is_sorted(ranks.begin(), ranks.end()));
+
+        for (const auto rank : ranks)
+        {
+            for_each_assignment(rank, [this](std::size_t position) { assignments_.set(position); });
+        }
+
+        ranks_ = ranks;
+        is_fixed_ = true;
+    }
+
+    template<typename Function>
+    void AssignmentSets::for_each_assignment(uint32_t rank, Function&& function) const
+    {
+        const auto arity = static_cast<int32_t>(problem_->get_arity(rank));
+        const auto offset = offsets_[problem_->get_predicate_id(rank)];
+        const auto& argument_ids = problem_->get_argument_ids(rank);
+
+        for (int32_t first_position = 0; first_position < arity; ++first_position)
+        {
+            const auto first_object_id = static_cast<int32_t>(argument_ids[first_position]);
+            function(offset + get_assignment_position(first_position, first_object_id, -1, -1, arity, num_objects_));
+
+            for (int32_t second_position = first_position + 1; second_position < arity; ++second_position)
+            {
+                const auto second_object_id = static_cast<int32_t>(argument_ids[second_position]);
+                function(offset + get_assignment_position(first_position, first_object_id, second_position, second_object_id, arity, num_objects_));
+            }
+        }
+    }
+
+    void AssignmentSets::insert(uint32_t rank)
+    {
+        for_each_assignment(rank,
+                            [this](std::size_t position)
+                            {
+                                if (supports_[position]++ == 0)
+                                {
+                                    assignments_.set(position);
+                                }
+                            });
+    }
+
+    void AssignmentSets::erase(uint32_t rank)
+    {
+        for_each_assignment(rank,
+                            [this](std::size_t position)
+                            {
+                                const auto iter = supports_.find(position);
+                                assert(iter != supports_.end());
+
+                                if (--iter.value() == 0)
+                                {
+                                    supports_.erase(iter);
+                                    assignments_.unset(position);
+                                }
+                            });
+    }
+
+    void AssignmentSets::update(const std::vector<uint32_t>& ranks)
+    {
+        assert(std::is_sorted(ranks.begin(), ranks.end()));
+
+        if (is_fixed_)
+        {
+            throw std::logic_error("assignment sets of fixed atoms cannot be updated");
+        }
+
+        // Both lists are sorted, so the atoms that differ are found by merging them
+
+        auto old_iter = ranks_.cbegin();
+        auto new_iter = ranks.cbegin();
+
+        while ((old_iter != ranks_.cend()) || (new_iter != ranks.cend()))
+        {
+            if ((new_iter == ranks.cend()) || ((old_iter != ranks_.cend()) && (*old_iter < *new_iter)))
+            {
+                erase(*old_iter);
+                ++old_iter;
+            }
+            else if ((old_iter == ranks_.cend()) || (*new_iter < *old_iter))
+            {
+                insert(*new_iter);
+                ++new_iter;
+            }
+            else
+            {
+                ++old_iter;
+                ++new_iter;
+            }
+        }
+
+        ranks_ = ranks;
+    }
+
+    const std::vector<uint32_t>& AssignmentSets::get_ranks() const { return ranks_; }
+}  // namespace planners
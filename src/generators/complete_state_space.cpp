@@ -56,7 +56,7 @@ namespace mimir::planners
         states_by_distance_(),
         forward_transitions_(),
         backward_transitions_(),
-        state_indices_(),
+        state_repository_(mimir::formalism::create_state_repository(problem)),
         state_distances_()
     {
     }
@@ -68,27 +68,27 @@ namespace mimir::planners
         state_infos_.clear();
         forward_transitions_.clear();
         backward_transitions_.clear();
-        state_indices_.clear();
+        state_repository_->clear();
         state_distances_.clear();
     }
 
     bool CompleteStateSpaceImpl::add_or_get_state(const mimir::formalism::State& state, uint64_t& out_index)
     {
-        const auto index_handler = state_indices_.find(state);
+        // The ids of the repository are dense and assigned in order of insertion, so they coincide with the indices of states_.
+        mimir::formalism::StateId state_id;
 
-        if (index_handler != state_indices_.end())
+        if (!state_repository_->insert(state, state_id))
         {
-            out_index = index_handler->second;
+            out_index = state_id;
             return false;
         }
         else
         {
-            out_index = states_.size();
+            out_index = state_id;
             states_.push_back(state);
             state_infos_.push_back(StateInfo(-1, -1));
             forward_transitions_.push_back(std::vector<mimir::formalism::Transition>());
             backward_transitions_.push_back(std::vector<mimir::formalism::Transition>());
-            state_indices_.insert(std::make_pair(state, out_index));
 
             if (literals_hold(problem->goal, state))
             {
@@ -173,15 +173,15 @@ namespace mimir::planners
 
     uint64_t CompleteStateSpaceImpl::get_state_index(const mimir::formalism::State& state) const
     {
-        const auto index_handler = state_indices_.find(state);
+        mimir::formalism::StateId state_id;
 
-        if (index_handler == state_indices_.end())
+        if (!state_repository_->find(state, state_id))
         {
             throw std::invalid_argument("state");
         }
         else
         {
-            return index_handler->second;
+            return state_id;
         }
     }
 
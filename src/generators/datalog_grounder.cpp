@@ -0,0 +1,736 @@
+/*
+ * Copyright (C) 2023 Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "../../include/mimir/algorithms/murmurhash3.hpp"
+#include "../../include/mimir/algorithms/thread_pool.hpp"
+#include "../../include/mimir/formalism/atom.hpp"
+#include "../../include/mimir/formalism/domain.hpp"
+#include "../../include/mimir/formalism/type.hpp"
+#include "../../include/mimir/generators/datalog_grounder.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+
+namespace mimir::planners
+{
+    std::size_t DatalogGrounder::KeyHash::operator()(const std::vector<uint32_t>& object_ids) const
+    {
+        int64_t hash[2];
+        MurmurHash3_x64_128(object_ids.data(), static_cast<int>(object_ids.size() * sizeof(uint32_t)), 0, hash);
+        return static_cast<std::size_t>(hash[0] + 0x9e3779b9 + (hash[1] << 6) + (hash[1] >> 2));
+    }
+
+    uint32_t DatalogGrounder::Relation::size() const { return arity == 0 ? static_cast<uint32_t>(index_by_arguments.size()) : static_cast<uint32_t>(arguments.size() / arity); }
+
+    const uint32_t* DatalogGrounder::Relation::get_arguments(uint32_t index) const { return arguments.data() + (static_cast<std::size_t>(index) * arity); }
+
+    DatalogGrounder::Rule::Rule(const mimir::formalism::ProblemDescription& problem, const mimir::formalism::ActionSchema& action_schema) :
+        schema(problem->domain, action_schema),
+        body(),
+        heads(),
+        negated_static_body(),
+        join_orders(),
+        unbound_parameters(),
+        is_compatible_object(),
+        compatible_objects(),
+        ground_arguments(),
+        num_ground_actions(0),
+        action_order()
+    {
+        // Negative fluent literals are ignored by the relaxation, negative static literals only depend on the initial state and are tested last
+
+        for (const auto& literal : schema.static_precondition)
+        {
+            (literal.negated ? negated_static_body : body).emplace_back(literal);
+        }
+
+        for (const auto& literal : schema.fluent_precondition)
+        {
+            if (!literal.negated)
+            {
+                body.emplace_back(literal);
+            }
+        }
+
+        // Conditional effects are relaxed to unconditional ones, as in relax(action_schema, true, true)
+
+        for (const auto& literal : schema.unconditional_effect)
+        {
+            if (!literal.negated)
+            {
+                heads.emplace_back(literal);
+            }
+        }
+
+        for (const auto& implication : schema.conditional_effect)
+        {
+            for (const auto& literal : implication.consequence)
+            {
+                if (!literal.negated)
+                {
+                    heads.emplace_back(literal);
+                }
+            }
+        }
+
+        // Parameters that the body does not mention can be bound to any object of their type
+
+        std::vector<bool> is_body_parameter(schema.arity, false);
+
+        for (const auto& literal : body)
+        {
+            for (const auto& term : literal.arguments)
+            {
+                if (term.is_variable())
+                {
+                    is_body_parameter[term.get_value()] = true;
+                }
+            }
+        }
+
+        for (uint32_t parameter_index = 0; parameter_index < schema.arity; ++parameter_index)
+        {
+            const auto& parameter = schema.get_parameters()[parameter_index];
+            std::vector<bool> is_compatible(problem->objects.size(), false);
+            std::vector<uint32_t> compatible;
+
+            for (const auto& object : problem->objects)
+            {
+                if (mimir::formalism::is_subtype_of(object->type, parameter->type))
+                {
+                    is_compatible[object->id] = true;
+                    compatible.emplace_back(object->id);
+                }
+            }
+
+            is_compatible_object.emplace_back(std::move(is_compatible));
+            compatible_objects.emplace_back(std::move(compatible));
+
+            if (!is_body_parameter[parameter_index])
+            {
+                unbound_parameters.emplace_back(parameter_index);
+            }
+        }
+
+        // Join the delta literal first, then greedily the literal with the most arguments that are already bound, so that the atom indices can be used
+
+        for (uint32_t delta_position = 0; delta_position < body.size(); ++delta_position)
+        {
+            std::vector<JoinStep> join_order;
+            std::vector<bool> is_bound(schema.arity, false);
+            std::vector<bool> is_joined(body.size(), false);
+
+            const auto join_literal = [this, &join_order, &is_bound, &is_joined](uint32_t literal_index)
+            {
+                JoinStep step { literal_index, -1, {} };
+                const auto& arguments = body[literal_index].arguments;
+
+                for (std::size_t position = 0; position < arguments.size(); ++position)
+                {
+                    const auto& term = arguments[position];
+
+                    if (term.is_constant() || is_bound[term.get_value()])
+                    {
+                        if (step.index_position < 0)
+                        {
+                            step.index_position = static_cast<int32_t>(position);
+                        }
+                    }
+                    else if (std::count(step.bound_parameters.begin(), step.bound_parameters.end(), term.get_value()) == 0)
+                    {
+                        step.bound_parameters.emplace_back(term.get_value());
+                    }
+                }
+
+                for (const auto parameter_index : step.bound_parameters)
+                {
+                    is_bound[parameter_index] = true;
+                }
+
+                is_joined[literal_index] = true;
+                join_order.emplace_back(std::move(step));
+            };
+
+            join_literal(delta_position);
+
+            while (join_order.size() < body.size())
+            {
+                uint32_t best_literal_index = 0;
+                int32_t best_num_bound = -1;
+
+                for (uint32_t literal_index = 0; literal_index < body.size(); ++literal_index)
+                {
+                    if (!is_joined[literal_index])
+                    {
+                        const auto& arguments = body[literal_index].arguments;
+                        const auto num_bound = std::count_if(arguments.begin(),
+                                                             arguments.end(),
+                                                             [&is_bound](const ParameterIndexOrConstantId& term)
+                                                             { return term.is_constant() || is_bound[term.get_value()]; });
+
+                        if (num_bound > best_num_bound)
+                        {
+                            best_literal_index = literal_index;
+                            best_num_bound = static_cast<int32_t>(num_bound);
+                        }
+                    }
+                }
+
+                join_literal(best_literal_index);
+            }
+
+            join_orders.emplace_back(std::move(join_order));
+        }
+    }
+
+    DatalogGrounder::DatalogGrounder(const mimir::formalism::ProblemDescription& problem, std::size_t num_threads) :
+        problem_(problem),
+        num_threads_(num_threads),
+        predicates_(),
+        relations_(),
+        rules_(),
+        assignment_(),
+        scratch_arguments_(),
+        num_rounds_(0)
+    {
+        if (num_threads == 0)
+        {
+            throw std::invalid_argument("num_threads must be at least 1");
+        }
+
+        const auto num_objects = problem->objects.size();
+        relations_.resize(problem->domain->predicates.size());
+        predicates_.resize(problem->domain->predicates.size());
+
+        for (const auto& predicate : problem->domain->predicates)
+        {
+            predicates_[predicate->id] = predicate;
+            auto& relation = relations_[predicate->id];
+            relation.arity = predicate->arity;
+            relation.indices_by_position.assign(predicate->arity, std::vector<std::vector<uint32_t>>(num_objects));
+            relation.delta_begin = 0;
+            relation.delta_end = 0;
+        }
+
+        std::size_t max_arity = 0;
+        rules_.reserve(problem->domain->action_schemas.size());
+
+        for (const auto& action_schema : problem->domain->action_schemas)
+        {
+            rules_.emplace_back(problem, action_schema);
+            max_arity = std::max(max_arity, static_cast<std::size_t>(rules_.back().schema.arity));
+        }
+
+        assignment_.assign(max_arity, unbound);
+    }
+
+    bool DatalogGrounder::insert_atom(uint32_t predicate_id, const std::vector<uint32_t>& arguments)
+    {
+        auto& relation = relations_[predicate_id];
+        const auto index = relation.size();
+
+        if (!relation.index_by_arguments.emplace(arguments, index).second)
+        {
+            return false;
+        }
+
+        relation.arguments.insert(relation.arguments.end(), arguments.begin(), arguments.end());
+
+        for (std::size_t position = 0; position < arguments.size(); ++position)
+        {
+            relation.indices_by_position[position][arguments[position]].emplace_back(index);
+        }
+
+        return true;
+    }
+
+    bool DatalogGrounder::contains_atom(uint32_t predicate_id, const std::vector<uint32_t>& arguments) const
+    {
+        const auto& relation = relations_[predicate_id];
+        return relation.index_by_arguments.find(arguments) != relation.index_by_arguments.end();
+    }
+
+    void DatalogGrounder::ground_literal(const FlatLiteral& literal, const uint32_t* assignment, std::vector<uint32_t>& out_arguments) const
+    {
+        out_arguments.clear();
+
+        for (const auto& term : literal.arguments)
+        {
+            out_arguments.emplace_back(term.is_constant() ? term.get_value() : assignment[term.get_value()]);
+        }
+    }
+
+    bool DatalogGrounder::join(const std::chrono::high_resolution_clock::time_point end_time,
+                               Rule& rule,
+                               uint32_t delta_position,
+                               const std::vector<JoinStep>& join_order,
+                               std::size_t depth)
+    {
+        if (depth == join_order.size())
+        {
+            assign_unbound_parameters(rule, 0);
+            return true;
+        }
+
+        // Semi-naive evaluation: the literals before the delta literal only match older atoms and the literals after it match all atoms known at the
+        // start of the round, so every combination of atoms is joined in exactly one round and for exactly one delta literal
+
+        const auto& step = join_order[depth];
+        const auto& literal = rule.body[step.literal_index];
+        const auto& relation = relations_[literal.predicate_id];
+        const auto begin = (step.literal_index == delta_position) ? relation.delta_begin : 0;
+        const auto end = (step.literal_index < delta_position) ? relation.delta_begin : relation.delta_end;
+
+        // Atoms are appended to the relations while the rule fires, so neither the candidates nor the arguments are held across the recursion
+
+        const std::vector<uint32_t>* candidates = nullptr;
+        std::size_t candidate_position = begin;
+        std::size_t num_candidates = end;
+
+        if (step.index_position >= 0)
+        {
+            const auto& term = literal.arguments[step.index_position];
+            const auto object_id = term.is_constant() ? term.get_value() : assignment_[term.get_value()];
+            candidates = &relation.indices_by_position[step.index_position][object_id];
+            candidate_position = static_cast<std::size_t>(std::lower_bound(candidates->begin(), candidates->end(), begin) - candidates->begin());
+            num_candidates = candidates->size();
+        }
+
+        for (; candidate_position < num_candidates; ++candidate_position)
+        {
+            const auto atom_index = candidates ? (*candidates)[candidate_position] : static_cast<uint32_t>(candidate_position);
+
+            if (atom_index >= end)
+            {
+                break;
+            }
+
+            if ((depth == 0) && (std::chrono::high_resolution_clock::now() >= end_time))
+            {
+                return false;
+            }
+
+            const auto arguments = relation.get_arguments(atom_index);
+            bool matches = true;
+
+            for (std::size_t position = 0; matches && (position < literal.arity); ++position)
+            {
+                const auto& term = literal.arguments[position];
+                const auto object_id = arguments[position];
+
+                if (term.is_constant())
+                {
+                    matches = (term.get_value() == object_id);
+                }
+                else
+                {
+                    auto& value = assignment_[term.get_value()];
+
+                    if (value == unbound)
+                    {
+                        matches = rule.is_compatible_object[term.get_value()][object_id];
+                        value = object_id;
+                    }
+                    else
+                    {
+                        matches = (value == object_id);
+                    }
+                }
+            }
+
+            if (matches && !join(end_time, rule, delta_position, join_order, depth + 1))
+            {
+                return false;
+            }
+
+            for (const auto parameter_index : step.bound_parameters)
+            {
+                assignment_[parameter_index] = unbound;
+            }
+        }
+
+        return true;
+    }
+
+    void DatalogGrounder::assign_unbound_parameters(Rule& rule, std::size_t depth)
+    {
+        if (depth == rule.unbound_parameters.size())
+        {
+            fire(rule);
+            return;
+        }
+
+        const auto parameter_index = rule.unbound_parameters[depth];
+
+        for (const auto object_id : rule.compatible_objects[parameter_index])
+        {
+            assignment_[parameter_index] = object_id;
+            assign_unbound_parameters(rule, depth + 1);
+        }
+
+        assignment_[parameter_index] = unbound;
+    }
+
+    void DatalogGrounder::fire(Rule& rule)
+    {
+        for (const auto& literal : rule.negated_static_body)
+        {
+            ground_literal(literal, assignment_.data(), scratch_arguments_);
+
+            if (contains_atom(literal.predicate_id, scratch_arguments_))
+            {
+                return;
+            }
+        }
+
+        rule.ground_arguments.insert(rule.ground_arguments.end(), assignment_.begin(), assignment_.begin() + rule.schema.arity);
+        ++rule.num_ground_actions;
+
+        for (const auto& literal : rule.heads)
+        {
+            ground_literal(literal, assignment_.data(), scratch_arguments_);
+            insert_atom(literal.predicate_id, scratch_arguments_);
+        }
+    }
+
+    double DatalogGrounder::get_cost(const Rule& rule, const mimir::formalism::ObjectList& arguments) const
+    {
+        const auto& cost_function = rule.schema.source->cost;
+        double cost;
+
+        if (cost_function->is_constant())
+        {
+            cost = cost_function->get_constant();
+        }
+        else
+        {
+            mimir::formalism::ObjectList cost_arguments;
+
+            for (const auto& term : rule.schema.cost_arguments)
+            {
+                cost_arguments.emplace_back(term.is_constant() ? problem_->get_object(term.get_value()) : arguments[term.get_value()]);
+            }
+
+            cost = problem_->atom_costs.at(mimir::formalism::create_atom(cost_function->get_atom()->predicate, std::move(cost_arguments)));
+        }
+
+        return (cost_function->get_operation() == mimir::formalism::FunctionOperation::DECREASE) ? -cost : cost;
+    }
+
+    bool DatalogGrounder::ground(const std::chrono::high_resolution_clock::time_point end_time, mimir::formalism::ActionList& out_actions)
+    {
+        for (auto& relation : relations_)
+        {
+            relation.arguments.clear();
+            relation.index_by_arguments.clear();
+
+            for (auto& indices_by_object : relation.indices_by_position)
+            {
+                for (auto& indices : indices_by_object)
+                {
+                    indices.clear();
+                }
+            }
+
+            relation.delta_begin = 0;
+            relation.delta_end = 0;
+        }
+
+        num_rounds_ = 0;
+
+        for (const auto& atom : problem_->initial)
+        {
+            scratch_arguments_.clear();
+
+            for (const auto& object : atom->arguments)
+            {
+                scratch_arguments_.emplace_back(object->id);
+            }
+
+            insert_atom(atom->predicate->id, scratch_arguments_);
+        }
+
+        // Rules without a body fire exactly once, their heads are part of the first delta
+
+        for (auto& rule : rules_)
+        {
+            rule.ground_arguments.clear();
+            rule.num_ground_actions = 0;
+
+            if (rule.body.empty())
+            {
+                assign_unbound_parameters(rule, 0);
+            }
+        }
+
+        while (true)
+        {
+            bool has_delta = false;
+
+            for (auto& relation : relations_)
+            {
+                relation.delta_begin = relation.delta_end;
+                relation.delta_end = relation.size();
+                has_delta |= (relation.delta_begin < relation.delta_end);
+            }
+
+            if (!has_delta)
+            {
+                break;
+            }
+
+            ++num_rounds_;
+
+            for (auto& rule : rules_)
+            {
+                for (uint32_t delta_position = 0; delta_position < rule.body.size(); ++delta_position)
+                {
+                    const auto& delta_relation = relations_[rule.body[delta_position].predicate_id];
+
+                    if ((delta_relation.delta_begin < delta_relation.delta_end)
+                        && !join(end_time, rule, delta_position, rule.join_orders[delta_position], 0))
+                    {
+                        return false;
+                    }
+                }
+            }
+        }
+
+        // Rank all atoms that the actions mention before the actions are created, in an order that does not depend on the number of threads. The
+        // reachable atoms come first, then the initial and goal atoms, they don't necessarily have to be mentioned in a ground action.
+
+        for (uint32_t predicate_id = 0; predicate_id < relations_.size(); ++predicate_id)
+        {
+            const auto& relation = relations_[predicate_id];
+
+            for (uint32_t index = 0; index < relation.size(); ++index)
+            {
+                create_atom(predicate_id, relation.get_arguments(index));
+            }
+        }
+
+        for (const auto& atom : problem_->initial)
+        {
+            problem_->get_rank(atom);
+        }
+
+        for (const auto& literal : problem_->goal)
+        {
+            problem_->get_rank(literal->atom);
+        }
+
+        // Order the actions of every rule by their arguments and split them into shards, the shards are processed in parallel and then merged in
+        // order, so the result does not depend on the order of evaluation or on the number of threads
+
+        mimir::algorithms::ThreadPool thread_pool(num_threads_);
+        std::size_t num_actions = 0;
+
+        for (const auto& rule : rules_)
+        {
+            num_actions += rule.num_ground_actions;
+        }
+
+        thread_pool.run(rules_.size(),
+                        [this](std::size_t rule_index)
+                        {
+                            auto& rule = rules_[rule_index];
+                            const auto arity = static_cast<std::size_t>(rule.schema.arity);
+                            rule.action_order.resize(rule.num_ground_actions);
+                            std::iota(rule.action_order.begin(), rule.action_order.end(), 0);
+                            std::sort(rule.action_order.begin(),
+                                      rule.action_order.end(),
+                                      [&rule, arity](uint32_t left, uint32_t right)
+                                      {
+                                          const auto left_arguments = rule.ground_arguments.begin() + (left * arity);
+                                          const auto right_arguments = rule.ground_arguments.begin() + (right * arity);
+                                          return std::lexicographical_compare(left_arguments,
+                                                                              left_arguments + arity,
+                                                                              right_arguments,
+                                                                              right_arguments + arity);
+                                      });
+                        });
+
+        const auto shard_size = std::max(min_shard_size, num_actions / (8 * num_threads_));
+        std::vector<Shard> shards;
+
+        for (uint32_t rule_index = 0; rule_index < rules_.size(); ++rule_index)
+        {
+            const auto num_rule_actions = rules_[rule_index].num_ground_actions;
+
+            for (std::size_t begin = 0; begin < num_rule_actions; begin += shard_size)
+            {
+                shards.push_back(Shard { rule_index, begin, std::min(begin + shard_size, num_rule_actions), {}, {} });
+            }
+        }
+
+        // Literals of unreachable atoms, such as negative preconditions or delete effects, need new ranks. They are collected in parallel and ranked
+        // in the order of the shards, afterwards creating the actions only looks up ranks.
+
+        std::atomic<bool> timed_out = false;
+
+        thread_pool.run(shards.size(),
+                        [this, end_time, &shards, &timed_out](std::size_t shard_index)
+                        {
+                            if (!timed_out.load(std::memory_order_relaxed) && !collect_unranked_atoms(end_time, shards[shard_index]))
+                            {
+                                timed_out.store(true, std::memory_order_relaxed);
+                            }
+                        });
+
+        if (timed_out)
+        {
+            return false;
+        }
+
+        for (auto& shard : shards)
+        {
+            for (std::size_t offset = 0; offset < shard.unranked_atoms.size(); offset += 1 + relations_[shard.unranked_atoms[offset]].arity)
+            {
+                create_atom(shard.unranked_atoms[offset], shard.unranked_atoms.data() + offset + 1);
+            }
+        }
+
+        thread_pool.run(shards.size(),
+                        [this, end_time, &shards, &timed_out](std::size_t shard_index)
+                        {
+                            if (!timed_out.load(std::memory_order_relaxed) && !create_actions(end_time, shards[shard_index]))
+                            {
+                                timed_out.store(true, std::memory_order_relaxed);
+                            }
+                        });
+
+        if (timed_out)
+        {
+            return false;
+        }
+
+        out_actions.reserve(out_actions.size() + num_actions);
+
+        for (auto& shard : shards)
+        {
+            out_actions.insert(out_actions.end(), std::make_move_iterator(shard.actions.begin()), std::make_move_iterator(shard.actions.end()));
+        }
+
+        return true;
+    }
+
+    mimir::formalism::Atom DatalogGrounder::create_atom(uint32_t predicate_id, const uint32_t* arguments) const
+    {
+        mimir::formalism::ObjectList objects;
+        objects.reserve(relations_[predicate_id].arity);
+
+        for (std::size_t position = 0; position < relations_[predicate_id].arity; ++position)
+        {
+            objects.emplace_back(problem_->get_object(arguments[position]));
+        }
+
+        return problem_->create_atom(predicates_[predicate_id], std::move(objects));
+    }
+
+    bool DatalogGrounder::collect_unranked_atoms(const std::chrono::high_resolution_clock::time_point end_time, Shard& shard) const
+    {
+        const auto& rule = rules_[shard.rule_index];
+        const auto& schema = rule.schema;
+        mimir::tsl::robin_map<std::vector<uint32_t>, uint32_t, KeyHash> seen_atoms;
+        std::vector<uint32_t> arguments;
+
+        const auto collect = [this, &shard, &seen_atoms, &arguments](const std::vector<FlatLiteral>& literals, const uint32_t* assignment)
+        {
+            for (const auto& literal : literals)
+            {
+                ground_literal(literal, assignment, arguments);
+
+                if (!contains_atom(literal.predicate_id, arguments))
+                {
+                    arguments.emplace_back(literal.predicate_id);
+
+                    if (seen_atoms.emplace(arguments, 0).second)
+                    {
+                        shard.unranked_atoms.emplace_back(literal.predicate_id);
+                        shard.unranked_atoms.insert(shard.unranked_atoms.end(), arguments.begin(), arguments.end() - 1);
+                    }
+                }
+            }
+        };
+
+        for (auto position = shard.begin; position < shard.end; ++position)
+        {
+            if (std::chrono::high_resolution_clock::now() >= end_time)
+            {
+                return false;
+            }
+
+            const auto assignment = rule.ground_arguments.data() + (static_cast<std::size_t>(rule.action_order[position]) * schema.arity);
+            collect(schema.static_precondition, assignment);
+            collect(schema.fluent_precondition, assignment);
+            collect(schema.unconditional_effect, assignment);
+
+            for (const auto& implication : schema.conditional_effect)
+            {
+                collect(implication.antecedent, assignment);
+                collect(implication.consequence, assignment);
+            }
+        }
+
+        return true;
+    }
+
+    bool DatalogGrounder::create_actions(const std::chrono::high_resolution_clock::time_point end_time, Shard& shard) const
+    {
+        const auto& rule = rules_[shard.rule_index];
+        const auto arity = static_cast<std::size_t>(rule.schema.arity);
+        shard.actions.reserve(shard.end - shard.begin);
+
+        for (auto position = shard.begin; position < shard.end; ++position)
+        {
+            if (std::chrono::high_resolution_clock::now() >= end_time)
+            {
+                return false;
+            }
+
+            const auto assignment = rule.ground_arguments.data() + (static_cast<std::size_t>(rule.action_order[position]) * arity);
+            mimir::formalism::ObjectList arguments;
+            arguments.reserve(arity);
+
+            for (std::size_t index = 0; index < arity; ++index)
+            {
+                arguments.emplace_back(problem_->get_object(assignment[index]));
+            }
+
+            const auto cost = get_cost(rule, arguments);
+            shard.actions.emplace_back(mimir::formalism::create_action(problem_, rule.schema.source, std::move(arguments), cost));
+        }
+
+        return true;
+    }
+
+    std::size_t DatalogGrounder::get_num_rounds() const { return num_rounds_; }
+
+    std::size_t DatalogGrounder::get_num_atoms() const
+    {
+        std::size_t num_atoms = 0;
+
+        for (const auto& relation : relations_)
+        {
+            num_atoms += relation.size();
+        }
+
+        return num_atoms;
+    }
+}  // namespace planners
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2023 Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "../../include/mimir/algorithms/murmurhash3.hpp"
+#include "../../include/mimir/generators/ground_action_cache.hpp"
+
+#include <cassert>
+
+namespace mimir::planners
+{
+    std::size_t GroundActionCache::KeyHash::operator()(const std::vector<uint32_t>& object_ids) const
+    {
+        int64_t hash[2];
+        MurmurHash3_x64_128(object_ids.data(), static_cast<int>(object_ids.size() * sizeof(uint32_t)), 0, hash);
+        return static_cast<std::size_t>(hash[0] + 0x9e3779b9 + (hash[1] << 6) + (hash[1] >> 2));
+    }
+
+    GroundActionCache::GroundActionCache(std::size_t capacity) :
+        capacity_(capacity),
+        slot_by_key_(),
+        slot_keys_(),
+        slot_actions_(),
+        slot_referenced_(),
+        clock_hand_(0),
+        num_hits_(0),
+        num_misses_(0),
+        num_evictions_(0)
+    {
+    }
+
+    mimir::formalism::Action GroundActionCache::find(const std::vector<uint32_t>& object_ids)
+    {
+        const auto iter = slot_by_key_.find(object_ids);
+
+        if (iter == slot_by_key_.end())
+        {
+            ++num_misses_;
+            return nullptr;
+        }
+
+        ++num_hits_;
+        slot_referenced_[iter->second] = true;
+        return slot_actions_[iter->second];
+    }
+
+    void GroundActionCache::insert(const std::vector<uint32_t>& object_ids, const mimir::formalism::Action& action)
+    {
+        if (capacity_ == 0)
+        {
+            return;
+        }
+
+        assert(!slot_by_key_.contains(object_ids));
+
+        if (slot_actions_.size() < capacity_)
+        {
+            slot_by_key_.emplace(object_ids, static_cast<uint32_t>(slot_actions_.size()));
+            slot_keys_.emplace_back(object_ids);
+            slot_actions_.emplace_back(action);
+            slot_referenced_.emplace_back(false);
+            return;
+        }
+
+        // Give every action that was used since the last pass a second chance, and replace the first one that was not
+
+        while (slot_referenced_[clock_hand_])
+        {
+            slot_referenced_[clock_hand_] = false;
+            clock_hand_ = (clock_hand_ + 1) % capacity_;
+        }
+
+        const auto slot = clock_hand_;
+        clock_hand_ = (clock_hand_ + 1) % capacity_;
+        ++num_evictions_;
+
+        slot_by_key_.erase(slot_keys_[slot]);
+        slot_keys_[slot] = object_ids;
+        slot_actions_[slot] = action;
+        slot_by_key_.emplace(slot_keys_[slot], static_cast<uint32_t>(slot));
+    }
+
+    void GroundActionCache::clear()
+    {
+        slot_by_key_.clear();
+        slot_keys_.clear();
+        slot_actions_.clear();
+        slot_referenced_.clear();
+        clock_hand_ = 0;
+    }
+
+    std::size_t GroundActionCache::size() const { return slot_actions_.size(); }
+
+    std::size_t GroundActionCache::capacity() const { return capacity_; }
+
+    std::size_t GroundActionCache::get_num_hits() const { return num_hits_; }
+
+    std::size_t GroundActionCache::get_num_misses() const { return num_misses_; }
+
+    std::size_t GroundActionCache::get_num_evictions() const { return num_evictions_; }
+}  // namespace planners
@@ -15,247 +15,438 @@
  * along with this program. If not, see <https://www.gnu.org/licenses/>.
  */
 
-#include "../../include/mimir/datastructures/robin_map.hpp"
+#include "../../include/mimir/algorithms/thread_pool.hpp"
 #include "../../include/mimir/generators/grounded_successor_generator.hpp"
 
 #include <algorithm>
 #include <cstddef>
-#include <iterator>
+#include <stdexcept>
 
 namespace mimir::planners
 {
-    DecisionNode::~DecisionNode() = default;
-
-    BranchNode::BranchNode(uint32_t rank) : rank_(rank) {}
-
-    LeafNode::LeafNode(const mimir::formalism::ActionList& actions) : actions_(actions) {}
-
-    GroundedSuccessorGenerator::GroundedSuccessorGenerator(const mimir::formalism::ProblemDescription& problem,
-                                                           const mimir::formalism::ActionList& ground_actions) :
-        problem_(problem),
-        actions_(ground_actions),
-        root_(nullptr)
-    {
-        root_ = build_decision_tree(problem, ground_actions);
-    }
-
-    mimir::formalism::ProblemDescription GroundedSuccessorGenerator::get_problem() const { return problem_; }
-
-    const mimir::formalism::ActionList& GroundedSuccessorGenerator::get_actions() const { return actions_; }
-
-    mimir::formalism::ActionList GroundedSuccessorGenerator::get_applicable_actions(const mimir::formalism::State& state) const
+    /// @brief The state of the construction of a decision tree. The preconditions of the actions are encoded as sorted lists of
+    /// (position << 1 | negated), where the position of an atom is its index in the order in which the tree branches on atoms. Every action has a
+    /// cursor to the first literal that no branch above it has tested yet. A subtree is built from a range of action_ids, which is partitioned
+    /// in place into the ranges of its children, so subtrees with disjoint ranges can be built concurrently.
+    struct GroundedSuccessorGenerator::DecisionTreeBuilder
     {
-        if (problem_ != state->get_problem())
+        struct Subtree
         {
-            throw std::invalid_argument("successor generator is built for a different problem");
-        }
+            std::vector<FlatDecisionNode> nodes;
+            std::vector<uint32_t> leaf_action_ids;
+            std::size_t size = 0;
+        };
 
-        mimir::formalism::ActionList applicable_actions;
-
-        if (root_)
+        // A subtree that is built on its own, and the child slot of the node that refers to it
+        struct PendingSubtree
         {
-            root_->get_applicable_actions(state, applicable_actions);
-        }
-
-        return applicable_actions;
-    }
-
-    std::size_t GroundedSuccessorGenerator::get_size() const
-    {
-        return root_->get_size();
-    }
-
-    mimir::formalism::AtomList::const_iterator GroundedSuccessorGenerator::select_branching_atom(const mimir::formalism::ActionList& ground_actions,
-                                                                                                 const mimir::formalism::AtomList& atoms,
-                                                                                                 mimir::formalism::AtomList::const_iterator next_atom)
+            uint32_t begin;
+            uint32_t end;
+            uint32_t parent;
+            uint32_t slot;
+        };
+
+        static constexpr uint32_t no_position = std::numeric_limits<uint32_t>::max();
+        static constexpr uint32_t pending_index = std::numeric_limits<uint32_t>::max();
+
+        std::vector<uint32_t> precondition_offsets;
+        std::vector<uint32_t> preconditions;
+        std::vector<uint32_t> position_to_rank;
+        std::vector<uint32_t> cursors;
+        std::vector<uint32_t> action_ids;
+
+        DecisionTreeBuilder(const mimir::formalism::ProblemDescription& problem, const mimir::formalism::ActionList& actions);
+
+        /// @brief Build the subtree of the actions in action_ids[begin, end) and return the index of its root, or 0 if it is an empty leaf. If
+        /// pending_subtrees is given, subtrees below the given depth are not built but recorded, and their parents refer to them by pending_index.
+        uint32_t build(uint32_t begin,
+                       uint32_t end,
+                       Subtree& out_subtree,
+                       std::vector<uint32_t>& scratch,
+                       std::vector<PendingSubtree>* pending_subtrees,
+                       uint32_t remaining_depth);
+    };
+
+    GroundedSuccessorGenerator::DecisionTreeBuilder::DecisionTreeBuilder(const mimir::formalism::ProblemDescription& problem,
+                                                                         const mimir::formalism::ActionList& actions) :
+        precondition_offsets(),
+        preconditions(),
+        position_to_rank(),
+        cursors(),
+        action_ids()
     {
-        std::equal_to<mimir::formalism::Atom> equal_to;
+        std::vector<bool> is_static_predicate(problem->domain->predicates.size(), false);
 
-        while (next_atom != atoms.end())
+        for (const auto& predicate : problem->domain->static_predicates)
         {
-            const auto atom = *next_atom;
-
-            for (const auto& ground_action : ground_actions)
-            {
-                for (const auto& literal : ground_action->get_precondition())
-                {
-                    if (equal_to(literal->atom, atom))
-                    {
-                        return next_atom;
-                    }
-                }
-            }
-
-            ++next_atom;
+            is_static_predicate[predicate->id] = true;
         }
 
-        return next_atom;
-    }
-
-    std::unique_ptr<DecisionNode> GroundedSuccessorGenerator::build_decision_tree(const mimir::formalism::ProblemDescription& problem,
-                                                                                  const mimir::formalism::ActionList& ground_actions)
-    {
-        const auto& static_predicates = problem->domain->static_predicates;
-        const auto& static_atoms = problem->get_static_atoms();
+        // Count how often every fluent atom occurs in a precondition, static literals are dropped since they hold in every state
 
-        mimir::tsl::robin_map<mimir::formalism::Atom, uint32_t> atom_occurrances;
+        std::vector<uint32_t> occurrences(problem->num_ranks(), 0);
+        std::vector<uint32_t> fluent_ranks;
+        precondition_offsets.reserve(actions.size() + 1);
+        precondition_offsets.emplace_back(0);
 
-        // Find unique atoms from ground action preconditions
-        for (const auto& action : ground_actions)
+        for (const auto& action : actions)
         {
             for (const auto& literal : action->get_precondition())
             {
-                const auto is_static_predicate = std::count(static_predicates.begin(), static_predicates.end(), literal->atom->predicate);
+                const auto rank = problem->get_rank(literal->atom);
 
-                if (is_static_predicate)
+                if (is_static_predicate[literal->atom->predicate->id])
                 {
-                    // We can disregard static atoms, provided that all actions in "ground_actions" meet the precondition for doing so
+                    // We can disregard static atoms, provided that all actions meet the precondition for doing so
 
-                    if (static_atoms.contains(literal->atom) == literal->negated)
+                    if (problem->is_static(rank) == literal->negated)
                     {
                         throw std::runtime_error("ground_actions contains an always inapplicable action");
                     }
                 }
                 else
                 {
-                    ++atom_occurrances[literal->atom];
+                    if (rank >= occurrences.size())
+                    {
+                        occurrences.resize(rank + 1, 0);
+                    }
+
+                    ++occurrences[rank];
+                    preconditions.emplace_back((rank << 1) | (literal->negated ? 1 : 0));
                 }
             }
+
+            precondition_offsets.emplace_back(static_cast<uint32_t>(preconditions.size()));
         }
 
-        mimir::formalism::AtomList atoms;
-        atoms.reserve(atom_occurrances.size());
+        // Branch on frequent atoms first, ties are broken by rank to keep the tree deterministic
 
-        for (const auto& [key, value] : atom_occurrances)
+        for (uint32_t rank = 0; rank < occurrences.size(); ++rank)
         {
-            atoms.emplace_back(key);
+            if (occurrences[rank] > 0)
+            {
+                position_to_rank.emplace_back(rank);
+            }
         }
 
-        const auto occurance_descending = [&atom_occurrances](const mimir::formalism::Atom& lhs, const mimir::formalism::Atom& rhs)
-        { return atom_occurrances[lhs] > atom_occurrances[rhs]; };
+        std::stable_sort(position_to_rank.begin(),
+                         position_to_rank.end(),
+                         [&occurrences](uint32_t left_rank, uint32_t right_rank) { return occurrences[left_rank] > occurrences[right_rank]; });
 
-        std::sort(atoms.begin(), atoms.end(), occurance_descending);
+        std::vector<uint32_t> rank_to_position(occurrences.size(), no_position);
 
-        return build_decision_tree_recursive(problem, ground_actions, atoms, atoms.begin());
+        for (uint32_t position = 0; position < position_to_rank.size(); ++position)
+        {
+            rank_to_position[position_to_rank[position]] = position;
+        }
+
+        for (std::size_t action_id = 0; action_id < actions.size(); ++action_id)
+        {
+            const auto begin = preconditions.begin() + precondition_offsets[action_id];
+            const auto end = preconditions.begin() + precondition_offsets[action_id + 1];
+            std::transform(begin, end, begin, [&rank_to_position](uint32_t literal) { return (rank_to_position[literal >> 1] << 1) | (literal & 1); });
+            std::sort(begin, end);
+        }
+
+        cursors.assign(precondition_offsets.begin(), precondition_offsets.end() - 1);
+        action_ids.resize(actions.size());
+
+        for (uint32_t action_id = 0; action_id < actions.size(); ++action_id)
+        {
+            action_ids[action_id] = action_id;
+        }
     }
 
-    std::unique_ptr<DecisionNode> GroundedSuccessorGenerator::build_decision_tree_recursive(const mimir::formalism::ProblemDescription& problem,
-                                                                                            const mimir::formalism::ActionList& ground_actions,
-                                                                                            const mimir::formalism::AtomList& atoms,
-                                                                                            mimir::formalism::AtomList::const_iterator next_atom)
+    uint32_t GroundedSuccessorGenerator::DecisionTreeBuilder::build(uint32_t begin,
+                                                                    uint32_t end,
+                                                                    Subtree& out_subtree,
+                                                                    std::vector<uint32_t>& scratch,
+                                                                    std::vector<PendingSubtree>* pending_subtrees,
+                                                                    uint32_t remaining_depth)
     {
-        next_atom = select_branching_atom(ground_actions, atoms, next_atom);
+        if (begin == end)
+        {
+            ++out_subtree.size;
+            return 0;
+        }
 
-        if ((next_atom == atoms.end()) || ground_actions.empty())
+        if (pending_subtrees && (remaining_depth == 0))
         {
-            return std::make_unique<LeafNode>(ground_actions);
+            pending_subtrees->push_back(PendingSubtree { begin, end, 0, 0 });
+            return pending_index;
         }
 
-        mimir::formalism::Atom branching_atom = *next_atom;
+        ++out_subtree.size;
 
-        mimir::formalism::ActionList present_actions;
-        mimir::formalism::ActionList not_present_actions;
-        mimir::formalism::ActionList dont_care_actions;
+        // Branch on the first atom that a precondition of the remaining actions mentions but no branch above has tested
 
-        std::equal_to<mimir::formalism::Atom> equal_to;
+        auto next_position = no_position;
 
-        for (const auto& ground_action : ground_actions)
+        for (auto index = begin; index < end; ++index)
         {
-            bool present = false;
-            bool not_present = false;
+            const auto action_id = action_ids[index];
+            const auto cursor = cursors[action_id];
 
-            for (const auto& literal : ground_action->get_precondition())
+            if (cursor < precondition_offsets[action_id + 1])
             {
-                if (equal_to(literal->atom, branching_atom))
-                {
-                    if (literal->negated)
-                    {
-                        not_present = true;
-                    }
-                    else
-                    {
-                        present = true;
-                    }
-
-                    break;
-                }
+                next_position = std::min(next_position, preconditions[cursor] >> 1);
             }
+        }
+
+        if (next_position == no_position)
+        {
+            const auto node_index = static_cast<uint32_t>(out_subtree.nodes.size());
+            const auto first = static_cast<uint32_t>(out_subtree.leaf_action_ids.size());
+            out_subtree.leaf_action_ids.insert(out_subtree.leaf_action_ids.end(), action_ids.begin() + begin, action_ids.begin() + end);
+            out_subtree.nodes.push_back(FlatDecisionNode { leaf_rank, first, static_cast<uint32_t>(out_subtree.leaf_action_ids.size()), 0 });
+            return node_index;
+        }
 
-            if (present)
+        // Stable partition of the range into the actions that require the atom, that require its absence and that do not mention it
+
+        scratch.resize(end - begin);
+        uint32_t num_present = 0;
+        uint32_t num_not_present = 0;
+
+        for (auto index = begin; index < end; ++index)
+        {
+            const auto action_id = action_ids[index];
+            const auto cursor = cursors[action_id];
+
+            if ((cursor < precondition_offsets[action_id + 1]) && ((preconditions[cursor] >> 1) == next_position))
             {
-                present_actions.push_back(ground_action);
+                ++((preconditions[cursor] & 1) ? num_not_present : num_present);
             }
-            else if (not_present)
+        }
+
+        auto present_position = 0u;
+        auto not_present_position = num_present;
+        auto dont_care_position = num_present + num_not_present;
+
+        for (auto index = begin; index < end; ++index)
+        {
+            const auto action_id = action_ids[index];
+            auto& cursor = cursors[action_id];
+            const auto cursor_end = precondition_offsets[action_id + 1];
+
+            if ((cursor < cursor_end) && ((preconditions[cursor] >> 1) == next_position))
             {
-                not_present_actions.push_back(ground_action);
+                scratch[(preconditions[cursor] & 1) ? not_present_position++ : present_position++] = action_id;
+
+                while ((cursor < cursor_end) && ((preconditions[cursor] >> 1) == next_position))
+                {
+                    ++cursor;
+                }
             }
             else
             {
-                dont_care_actions.push_back(ground_action);
+                scratch[dont_care_position++] = action_id;
             }
         }
 
-        ++next_atom;
+        std::copy(scratch.begin(), scratch.begin() + (end - begin), action_ids.begin() + begin);
+
+        const auto node_index = static_cast<uint32_t>(out_subtree.nodes.size());
+        out_subtree.nodes.push_back(FlatDecisionNode { position_to_rank[next_position], 0, 0, 0 });
+
+        const auto present_end = begin + num_present;
+        const auto not_present_end = present_end + num_not_present;
+        const uint32_t child_ranges[3][2] = { { begin, present_end }, { present_end, not_present_end }, { not_present_end, end } };
+        uint32_t children[3];
 
-        if ((present_actions.size() == 0) && (not_present_actions.size() == 0) && (dont_care_actions.size() > 0))
+        for (uint32_t slot = 0; slot < 3; ++slot)
         {
-            return build_decision_tree_recursive(problem, dont_care_actions, atoms, next_atom);
+            children[slot] = build(child_ranges[slot][0], child_ranges[slot][1], out_subtree, scratch, pending_subtrees, remaining_depth - 1);
+
+            if (children[slot] == pending_index)
+            {
+                pending_subtrees->back().parent = node_index;
+                pending_subtrees->back().slot = slot;
+                children[slot] = 0;
+            }
         }
-        else
+
+        // The vector may have grown while the children were built, so the node is only accessed by its index
+
+        out_subtree.nodes[node_index].first = children[0];
+        out_subtree.nodes[node_index].second = children[1];
+        out_subtree.nodes[node_index].third = children[2];
+        return node_index;
+    }
+
+    GroundedSuccessorGenerator::GroundedSuccessorGenerator(const mimir::formalism::ProblemDescription& problem,
+                                                           const mimir::formalism::ActionList& ground_actions,
+                                                           std::size_t num_threads) :
+        problem_(problem),
+        actions_(ground_actions),
+        nodes_(),
+        leaf_action_ids_(),
+        size_(0)
+    {
+        if (num_threads == 0)
         {
-            auto branch_node = std::make_unique<BranchNode>(problem->get_rank(branching_atom));
-            branch_node->present_ = build_decision_tree_recursive(problem, present_actions, atoms, next_atom);
-            branch_node->not_present_ = build_decision_tree_recursive(problem, not_present_actions, atoms, next_atom);
-            branch_node->dont_care_ = build_decision_tree_recursive(problem, dont_care_actions, atoms, next_atom);
-            return branch_node;
+            throw std::invalid_argument("num_threads must be at least 1");
         }
+
+        build_decision_tree(num_threads);
     }
 
-    void BranchNode::get_applicable_actions(const mimir::formalism::State& state, mimir::formalism::ActionList& applicable_actions) const
+    void GroundedSuccessorGenerator::build_decision_tree(std::size_t num_threads)
     {
-        const bool atom_present = mimir::formalism::is_in_state(rank_, state);
+        DecisionTreeBuilder builder(problem_, actions_);
+        DecisionTreeBuilder::Subtree tree;
+        std::vector<uint32_t> scratch;
+        const auto num_actions = static_cast<uint32_t>(actions_.size());
+
+        // Small sets of actions are not worth the threads
 
-        if (atom_present)
+        constexpr std::size_t min_actions_per_thread = 4096;
+        num_threads = std::min(num_threads, std::max(static_cast<std::size_t>(1), actions_.size() / min_actions_per_thread));
+
+        if (num_threads == 1)
         {
-            present_->get_applicable_actions(state, applicable_actions);
+            builder.build(0, num_actions, tree, scratch, nullptr, 0);
         }
         else
         {
-            not_present_->get_applicable_actions(state, applicable_actions);
-        }
+            // Build the top of the tree sequentially, deep enough to have a few subtrees per thread, and the subtrees below it in parallel. Every
+            // subtree is stored contiguously after the top of the tree, its nodes are then relocated to their final indices.
 
-        dont_care_->get_applicable_actions(state, applicable_actions);
-    }
+            uint32_t top_depth = 1;
 
-    void LeafNode::get_applicable_actions(const mimir::formalism::State& state, mimir::formalism::ActionList& applicable_actions) const
-    {
-        applicable_actions.insert(applicable_actions.end(), actions_.cbegin(), actions_.cend());
+            for (std::size_t num_subtrees = 3; num_subtrees < 4 * num_threads; num_subtrees *= 3)
+            {
+                ++top_depth;
+            }
+
+            std::vector<DecisionTreeBuilder::PendingSubtree> pending_subtrees;
+            builder.build(0, num_actions, tree, scratch, &pending_subtrees, top_depth);
+
+            std::vector<DecisionTreeBuilder::Subtree> subtrees(pending_subtrees.size());
+            mimir::algorithms::ThreadPool thread_pool(num_threads);
+            thread_pool.run(pending_subtrees.size(),
+                            [&builder, &pending_subtrees, &subtrees](std::size_t index)
+                            {
+                                std::vector<uint32_t> subtree_scratch;
+                                const auto& pending_subtree = pending_subtrees[index];
+                                builder.build(pending_subtree.begin, pending_subtree.end, subtrees[index], subtree_scratch, nullptr, 0);
+                            });
+
+            for (std::size_t index = 0; index < subtrees.size(); ++index)
+            {
+                const auto& subtree = subtrees[index];
+                const auto node_offset = static_cast<uint32_t>(tree.nodes.size());
+                const auto leaf_offset = static_cast<uint32_t>(tree.leaf_action_ids.size());
+
+                for (auto node : subtree.nodes)
+                {
+                    if (node.rank == leaf_rank)
+                    {
+                        node.first += leaf_offset;
+                        node.second += leaf_offset;
+                    }
+                    else
+                    {
+                        node.first = node.first ? (node.first + node_offset) : 0;
+                        node.second = node.second ? (node.second + node_offset) : 0;
+                        node.third = node.third ? (node.third + node_offset) : 0;
+                    }
+
+                    tree.nodes.push_back(node);
+                }
+
+                tree.leaf_action_ids.insert(tree.leaf_action_ids.end(), subtree.leaf_action_ids.begin(), subtree.leaf_action_ids.end());
+                tree.size += subtree.size;
+
+                const auto& pending_subtree = pending_subtrees[index];
+                auto& parent = tree.nodes[pending_subtree.parent];
+                (pending_subtree.slot == 0 ? parent.first : (pending_subtree.slot == 1 ? parent.second : parent.third)) = node_offset;
+            }
+        }
+
+        nodes_ = std::move(tree.nodes);
+        leaf_action_ids_ = std::move(tree.leaf_action_ids);
+        size_ = tree.size;
     }
 
-    std::size_t BranchNode::get_size() const
+    template<typename Function>
+    void GroundedSuccessorGenerator::for_each_applicable_action_id(const std::size_t* words, std::size_t num_words, Function&& function) const
     {
-        std::size_t size = 1;
+        constexpr std::size_t block_size = sizeof(std::size_t) * 8;
 
-        if (present_)
+        if (nodes_.empty())
         {
-            size += present_->get_size();
+            return;
         }
 
-        if (not_present_)
+        // The dont-care children that still have to be visited, the stack never grows deeper than the tree
+
+        thread_local std::vector<uint32_t> pending_nodes;
+        pending_nodes.clear();
+        pending_nodes.push_back(0);
+
+        while (!pending_nodes.empty())
         {
-            size += not_present_->get_size();
+            auto index = pending_nodes.back();
+            pending_nodes.pop_back();
+
+            while (true)
+            {
+                const auto& node = nodes_[index];
+
+                if (node.rank == leaf_rank)
+                {
+                    for (auto position = node.first; position < node.second; ++position)
+                    {
+                        function(leaf_action_ids_[position]);
+                    }
+
+                    break;
+                }
+
+                if (node.third)
+                {
+                    pending_nodes.push_back(node.third);
+                }
+
+                const auto block_index = node.rank / block_size;
+                const auto atom_present = (block_index < num_words) && ((words[block_index] >> (node.rank % block_size)) & 1);
+                index = atom_present ? node.first : node.second;
+
+                if (!index)
+                {
+                    break;
+                }
+            }
         }
+    }
 
-        if (dont_care_)
+    mimir::formalism::ProblemDescription GroundedSuccessorGenerator::get_problem() const { return problem_; }
+
+    const mimir::formalism::ActionList& GroundedSuccessorGenerator::get_actions() const { return actions_; }
+
+    mimir::formalism::ActionList GroundedSuccessorGenerator::get_applicable_actions(const mimir::formalism::State& state) const
+    {
+        if (problem_ != state->get_problem())
         {
-            size += dont_care_->get_size();
+            throw std::invalid_argument("successor generator is built for a different problem");
         }
 
-        return size;
+        mimir::formalism::ActionList applicable_actions;
+        const auto& blocks = state->get_blocks();
+        for_each_applicable_action_id(blocks.data(),
+                                      blocks.size(),
+                                      [this, &applicable_actions](uint32_t action_id) { applicable_actions.push_back(actions_[action_id]); });
+        return applicable_actions;
     }
 
-    std::size_t LeafNode::get_size() const
+    bool GroundedSuccessorGenerator::is_thread_safe() const { return true; }
+
+    void GroundedSuccessorGenerator::get_applicable_action_ids(const std::size_t* words, std::size_t num_words, std::vector<uint32_t>& out_action_ids) const
     {
-        return 1;
+        out_action_ids.clear();
+        for_each_applicable_action_id(words, num_words, [&out_action_ids](uint32_t action_id) { out_action_ids.push_back(action_id); });
     }
+
+    std::size_t GroundedSuccessorGenerator::get_size() const { return size_; }
 }  // namespace planners
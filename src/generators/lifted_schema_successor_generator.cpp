@@ -22,79 +22,12 @@
 #include "../formalism/help_functions.hpp"
 
 #include <algorithm>
-#include <boost/dynamic_bitset.hpp>
 #include <limits>
 #include <set>
 
 namespace mimir::planners
 {
-    std::size_t
-    get_assignment_position(int32_t first_position, int32_t first_object, int32_t second_position, int32_t second_object, int32_t arity, int32_t num_objects)
-    {
-        const auto first = 1;
-        const auto second = first * (arity + 1);
-        const auto third = second * (arity + 1);
-        const auto fourth = third * (num_objects + 1);
-        const auto rank = (first * (first_position + 1)) + (second * (second_position + 1)) + (third * (first_object + 1)) + (fourth * (second_object + 1));
-        return (std::size_t) rank;
-    }
-
-    std::size_t num_assignments(int32_t arity, int32_t num_objects)
-    {
-        const auto first = 1;
-        const auto second = first * (arity + 1);
-        const auto third = second * (arity + 1);
-        const auto fourth = third * (num_objects + 1);
-        const auto max = (first * arity) + (second * arity) + (third * num_objects) + (fourth * num_objects);
-        return (std::size_t)(max + 1);
-    }
-
-    /**
-     * @brief Builds a datastructure to efficiently test if an assignment is compatible with an atom in the given set.
-     *
-     * @return A set for each predicate that contains possible compatible assignments.
-     */
-    std::vector<std::vector<bool>> LiftedSchemaSuccessorGenerator::build_assignment_sets(const mimir::formalism::DomainDescription& domain,
-                                                                                         const mimir::formalism::ProblemDescription& problem,
-                                                                                         const std::vector<uint32_t>& ranks)
-    {
-        const auto num_objects = problem->objects.size();
-        const auto& predicates = domain->predicates;
-        std::vector<std::vector<bool>> assignment_sets;
-        assignment_sets.resize(predicates.size());
-
-        for (const auto& predicate : predicates)
-        {
-            auto& assignment_set = assignment_sets[predicate->id];
-            assignment_set.resize(num_assignments(predicate->arity, num_objects));
-        }
-
-        for (const auto& rank : ranks)
-        {
-            const auto& predicate_arity = problem->get_arity(rank);
-            const auto& predicate_id = problem->get_predicate_id(rank);
-            const auto& argument_ids = problem->get_argument_ids(rank);
-            auto& assignment_set = assignment_sets[predicate_id];
-
-            for (size_t first_position = 0; first_position < predicate_arity; ++first_position)
-            {
-                const auto& first_object_id = argument_ids[first_position];
-                assignment_set[get_assignment_position(first_position, first_object_id, -1, -1, predicate_arity, num_objects)] = true;
-
-                for (size_t second_position = first_position + 1; second_position < predicate_arity; ++second_position)
-                {
-                    const auto& second_object_id = argument_ids[second_position];
-                    assignment_set[get_assignment_position(second_position, second_object_id, -1, -1, predicate_arity, num_objects)] = true;
-                    assignment_set[get_assignment_position(first_position, first_object_id, second_position, second_object_id, predicate_arity, num_objects)] =
-                        true;
-                }
-            }
-        }
-
-        return assignment_sets;
-    }
-
-    bool LiftedSchemaSuccessorGenerator::literal_all_consistent(const std::vector<std::vector<bool>>& assignment_sets,
+    bool LiftedSchemaSuccessorGenerator::literal_all_consistent(const AssignmentSets& assignment_sets,
                                                                 const std::vector<mimir::planners::FlatLiteral>& literals,
                                                                 const Assignment& first_assignment,
                                                                 const Assignment& second_assignment) const
@@ -172,15 +105,12 @@ namespace mimir::planners
 
             if (!empty_assignment)
             {
-                const auto& assignment_set = assignment_sets[literal.predicate_id];
-                const auto assignment_rank = get_assignment_position(first_position,
-                                                                     first_object_id,
-                                                                     second_position,
-                                                                     second_object_id,
-                                                                     static_cast<int32_t>(literal.arity),
-                                                                     static_cast<int32_t>(problem_->objects.size()));
-
-                const auto consistent_with_state = assignment_set[assignment_rank];
+                const auto consistent_with_state = assignment_sets.contains(literal.predicate_id,
+                                                                            first_position,
+                                                                            first_object_id,
+                                                                            second_position,
+                                                                            second_object_id,
+                                                                            static_cast<int32_t>(literal.arity));
 
                 if (!literal.negated && !consistent_with_state)
                 {
@@ -219,8 +149,8 @@ namespace mimir::planners
     mimir::formalism::Literal LiftedSchemaSuccessorGenerator::ground_literal(const FlatLiteral& literal, const mimir::formalism::ObjectList& terms) const
     {
         const auto& atom_predicate = literal.source->atom->predicate;
-        const auto ground_atom = mimir::formalism::create_atom(atom_predicate, ground_parameters(literal.arguments, terms));
-        return mimir::formalism::create_literal(ground_atom, literal.negated);
+        const auto ground_atom = problem_->create_atom(atom_predicate, ground_parameters(literal.arguments, terms));
+        return problem_->create_literal(ground_atom, literal.negated);
     }
 
     mimir::formalism::Action LiftedSchemaSuccessorGenerator::create_action(mimir::formalism::ObjectList&& terms) const
@@ -300,15 +230,46 @@ namespace mimir::planners
                                                cost);
     }
 
+    void LiftedSchemaSuccessorGenerator::add_action_if_applicable(const mimir::formalism::State& state, mimir::formalism::ActionList& out_actions) const
+    {
+        // Ground actions are only built the first time their arguments are seen, afterwards the cached action and its bitsets are reused
+
+        auto action = action_cache_.find(action_arguments_);
+
+        if (!action)
+        {
+            mimir::formalism::ObjectList terms;
+            terms.reserve(action_arguments_.size());
+
+            for (const auto object_id : action_arguments_)
+            {
+                terms.emplace_back(problem_->get_object(object_id));
+            }
+
+            action = create_action(std::move(terms));
+            action_cache_.insert(action_arguments_, action);
+        }
+
+        if (mimir::formalism::is_applicable(action, state))
+        {
+            out_actions.push_back(std::move(action));
+        }
+    }
+
     LiftedSchemaSuccessorGenerator::LiftedSchemaSuccessorGenerator(const mimir::formalism::ActionSchema& action_schema,
-                                                                   const mimir::formalism::ProblemDescription& problem) :
+                                                                   const mimir::formalism::ProblemDescription& problem,
+                                                                   std::size_t action_cache_capacity) :
         domain_(problem->domain),
         problem_(problem),
         flat_action_schema_(FlatActionSchema(problem->domain, action_schema)),
         objects_by_parameter_type(),
         to_vertex_assignment(),
         statically_consistent_assignments(),
-        partitions_()
+        partitions_(),
+        adjacency_matrix_(),
+        clique_enumerator_(),
+        action_cache_(action_cache_capacity),
+        action_arguments_()
     {
         // Type information is used by the unary and general case
 
@@ -352,9 +313,12 @@ namespace mimir::planners
                 partitions_.push_back(std::move(partition));
             }
 
+            adjacency_matrix_.reset(to_vertex_assignment.size());
+            clique_enumerator_ = mimir::algorithms::KPartiteCliqueEnumerator(partitions_);
+
             // Filter assignment based on static atoms
             const auto initial_state = mimir::formalism::create_state(problem->initial, problem);
-            const auto assignment_sets = build_assignment_sets(domain_, problem_, initial_state->get_static_ranks());
+            const AssignmentSets assignment_sets(domain_, problem_, initial_state->get_static_ranks());
 
             for (size_t first_id = 0; first_id < to_vertex_assignment.size(); ++first_id)
             {
@@ -415,12 +379,8 @@ namespace mimir::planners
             return false;
         }
 
-        const auto action = create_action(mimir::formalism::ObjectList {});
-
-        if (mimir::formalism::literals_hold(action->get_precondition(), state))
-        {
-            out_actions.push_back(action);
-        }
+        action_arguments_.clear();
+        add_action_if_applicable(state, out_actions);
 
         return true;
     }
@@ -443,12 +403,8 @@ namespace mimir::planners
                 return false;
             }
 
-            const auto action = create_action({ problem_->get_object(object_id) });
-
-            if (mimir::formalism::literals_hold(action->get_precondition(), state))
-            {
-                out_actions.push_back(action);
-            }
+            action_arguments_.assign(1, object_id);
+            add_action_if_applicable(state, out_actions);
         }
 
         return true;
@@ -463,7 +419,7 @@ namespace mimir::planners
 
     bool LiftedSchemaSuccessorGenerator::general_case(const std::chrono::high_resolution_clock::time_point end_time,
                                                       const mimir::formalism::State& state,
-                                                      const std::vector<std::vector<bool>>& assignment_sets,
+                                                      const AssignmentSets& assignment_sets,
                                                       mimir::formalism::ActionList& out_actions) const
     {
         assert(state);
@@ -473,9 +429,7 @@ namespace mimir::planners
             return false;
         }
 
-        const auto num_vertices = to_vertex_assignment.size();
-
-        std::vector<boost::dynamic_bitset<>> adjacency_matrix(num_vertices, boost::dynamic_bitset<>(num_vertices));
+        adjacency_matrix_.clear();
 
         for (const auto& assignment : statically_consistent_assignments)
         {
@@ -484,12 +438,7 @@ namespace mimir::planners
 
             if (literal_all_consistent(assignment_sets, flat_action_schema_.fluent_precondition, first_assignment, second_assignment))
             {
-                const auto first_id = assignment.first_position;
-                const auto second_id = assignment.second_position;
-                auto& first_row = adjacency_matrix[first_id];
-                auto& second_row = adjacency_matrix[second_id];
-                first_row[second_id] = 1;
-                second_row[first_id] = 1;
+                adjacency_matrix_.add_edge(assignment.first_position, assignment.second_position);
             }
         }
 
@@ -497,43 +446,25 @@ namespace mimir::planners
         // atoms in the state (compared to the number of possible atoms) lead to very sparse graphs, so the number of maximal cliques of maximum size (#
         // parameters) tends to be very small.
 
-        std::vector<std::vector<std::size_t>> cliques;
-        if (!algorithms::find_all_k_cliques_in_k_partite_graph(end_time, adjacency_matrix, partitions_, cliques))
-        {
-            return false;
-        }
-
-        for (const auto& clique : cliques)
-        {
-            if (std::chrono::high_resolution_clock::now() >= end_time)
-            {
-                return false;
-            }
-
-            mimir::formalism::ObjectList terms(flat_action_schema_.arity);
-
-            for (std::size_t vertex_index = 0; vertex_index < flat_action_schema_.arity; ++vertex_index)
-            {
-                const auto vertex_id = clique[vertex_index];
-                const auto& vertex_assignment = to_vertex_assignment.at(vertex_id);
-                const auto parameter_index = vertex_assignment.parameter_index;
-                const auto object_id = vertex_assignment.object_id;
-                terms[parameter_index] = problem_->get_object(object_id);
-            }
-
-            const auto action = create_action(std::move(terms));
-
-            if (mimir::formalism::literals_hold(action->get_precondition(), state, 3))
-            {
-                out_actions.push_back(action);
-            }
-        }
-
-        return true;
+        return clique_enumerator_.enumerate(end_time,
+                                            adjacency_matrix_,
+                                            [this, &state, &out_actions](const std::vector<std::size_t>& clique)
+                                            {
+                                                action_arguments_.resize(flat_action_schema_.arity);
+
+                                                for (std::size_t vertex_index = 0; vertex_index < flat_action_schema_.arity; ++vertex_index)
+                                                {
+                                                    const auto& vertex_assignment = to_vertex_assignment.at(clique[vertex_index]);
+                                                    action_arguments_[vertex_assignment.parameter_index] = vertex_assignment.object_id;
+                                                }
+
+                                                add_action_if_applicable(state, out_actions);
+                                                return true;
+                                            });
     }
 
     mimir::formalism::ActionList LiftedSchemaSuccessorGenerator::general_case(const mimir::formalism::State& state,
-                                                                              const std::vector<std::vector<bool>>& assignment_sets) const
+                                                                              const AssignmentSets& assignment_sets) const
     {
         mimir::formalism::ActionList applicable_actions;
         general_case(std::chrono::high_resolution_clock::time_point::max(), state, assignment_sets, applicable_actions);
@@ -541,7 +472,7 @@ namespace mimir::planners
     }
 
     mimir::formalism::ActionList LiftedSchemaSuccessorGenerator::get_applicable_actions(const mimir::formalism::State& state,
-                                                                                        const std::vector<std::vector<bool>>& assignment_sets) const
+                                                                                        const AssignmentSets& assignment_sets) const
     {
         if (!nullary_preconditions_hold(state))
         {
@@ -564,14 +495,26 @@ namespace mimir::planners
 
     mimir::formalism::ActionList LiftedSchemaSuccessorGenerator::get_applicable_actions(const mimir::formalism::State& state) const
     {
-        const auto assignment_sets = build_assignment_sets(domain_, problem_, state->get_dynamic_ranks());
+        AssignmentSets assignment_sets(domain_, problem_);
+
+        if (flat_action_schema_.arity > 1)
+        {
+            assignment_sets.update(state->get_dynamic_ranks());
+        }
+
         return get_applicable_actions(state, assignment_sets);
     }
 
     bool LiftedSchemaSuccessorGenerator::get_applicable_actions(const std::chrono::high_resolution_clock::time_point end_time,
                                                                 const mimir::formalism::State& state,
+                                                                const AssignmentSets& assignment_sets,
                                                                 mimir::formalism::ActionList& out_actions) const
     {
+        if (!nullary_preconditions_hold(state))
+        {
+            return true;
+        }
+
         if (flat_action_schema_.arity == 0)
         {
             if (!nullary_case(end_time, state, out_actions))
@@ -590,8 +533,6 @@ namespace mimir::planners
 
         if (flat_action_schema_.arity > 1)
         {
-            const auto assignment_sets = build_assignment_sets(domain_, problem_, state->get_dynamic_ranks());
-
             if (!general_case(end_time, state, assignment_sets, out_actions))
             {
                 return false;
@@ -600,4 +541,18 @@ namespace mimir::planners
 
         return true;
     }
+
+    bool LiftedSchemaSuccessorGenerator::get_applicable_actions(const std::chrono::high_resolution_clock::time_point end_time,
+                                                                const mimir::formalism::State& state,
+                                                                mimir::formalism::ActionList& out_actions) const
+    {
+        AssignmentSets assignment_sets(domain_, problem_);
+
+        if (flat_action_schema_.arity > 1)
+        {
+            assignment_sets.update(state->get_dynamic_ranks());
+        }
+
+        return get_applicable_actions(end_time, state, assignment_sets, out_actions);
+    }
 }  // namespace planners
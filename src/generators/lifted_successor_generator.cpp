@@ -17,27 +17,100 @@
 
 #include "../../include/mimir/generators/lifted_successor_generator.hpp"
 
+#include <algorithm>
 #include <chrono>
+#include <stdexcept>
 
 namespace mimir::planners
 {
-    LiftedSuccessorGenerator::LiftedSuccessorGenerator(const mimir::formalism::ProblemDescription& problem) : problem_(problem), generators_()
+    LiftedSuccessorGenerator::LiftedSuccessorGenerator(const mimir::formalism::ProblemDescription& problem,
+                                                       std::size_t num_threads,
+                                                       std::size_t action_cache_capacity) :
+        problem_(problem),
+        generators_(),
+        assignment_sets_mutex_(),
+        assignment_sets_(problem->domain, problem),
+        thread_pool_(),
+        ordered_generators_(),
+        schema_actions_(),
+        schema_completed_()
     {
-        for (const auto& action_schema : problem->domain->action_schemas)
+        if (num_threads == 0)
         {
-            generators_.insert(std::make_pair(action_schema, LiftedSchemaSuccessorGenerator(action_schema, problem)));
+            throw std::invalid_argument("num_threads must be at least 1");
         }
+
+        const auto& action_schemas = problem->domain->action_schemas;
+        const auto schema_cache_capacity =
+            (action_cache_capacity == 0) ? 0 : std::max(static_cast<std::size_t>(1), action_cache_capacity / std::max(action_schemas.size(), static_cast<std::size_t>(1)));
+
+        for (const auto& action_schema : action_schemas)
+        {
+            generators_.insert(std::make_pair(action_schema, LiftedSchemaSuccessorGenerator(action_schema, problem, schema_cache_capacity)));
+        }
+
+        // There is nothing to gain from more threads than schemas
+
+        num_threads = std::min(num_threads, generators_.size());
+
+        if (num_threads > 1)
+        {
+            thread_pool_ = std::make_unique<mimir::algorithms::ThreadPool>(num_threads);
+
+            for (const auto& [_, generator] : generators_)
+            {
+                ordered_generators_.push_back(&generator);
+            }
+
+            schema_actions_.resize(ordered_generators_.size());
+            schema_completed_.resize(ordered_generators_.size());
+        }
+    }
+
+    bool LiftedSuccessorGenerator::get_applicable_actions_in_parallel(const std::chrono::high_resolution_clock::time_point end_time,
+                                                                      const mimir::formalism::State& state,
+                                                                      mimir::formalism::ActionList& out_actions) const
+    {
+        // Every schema is handled by a single task, so the scratch memory of a schema generator is never shared between threads
+
+        thread_pool_->run(ordered_generators_.size(),
+                          [this, end_time, &state](std::size_t index)
+                          {
+                              auto& actions = schema_actions_[index];
+                              actions.clear();
+                              schema_completed_[index] = (std::chrono::high_resolution_clock::now() < end_time)
+                                                         && ordered_generators_[index]->get_applicable_actions(end_time, state, assignment_sets_, actions);
+                          });
+
+        for (std::size_t index = 0; index < ordered_generators_.size(); ++index)
+        {
+            if (!schema_completed_[index])
+            {
+                return false;
+            }
+
+            out_actions.insert(out_actions.end(), schema_actions_[index].begin(), schema_actions_[index].end());
+        }
+
+        return true;
     }
 
     mimir::formalism::ActionList LiftedSuccessorGenerator::get_applicable_actions(const mimir::formalism::State& state) const
     {
         mimir::formalism::ActionList applicable_actions;
 
-        const auto assignment_sets = LiftedSchemaSuccessorGenerator::build_assignment_sets(problem_->domain, problem_, state->get_dynamic_ranks());
+        std::lock_guard<std::mutex> lock(assignment_sets_mutex_);
+        assignment_sets_.update(state->get_dynamic_ranks());
+
+        if (thread_pool_)
+        {
+            get_applicable_actions_in_parallel(std::chrono::high_resolution_clock::time_point::max(), state, applicable_actions);
+            return applicable_actions;
+        }
 
         for (const auto& [_, generator] : generators_)
         {
-            const auto schema_actions = generator.get_applicable_actions(state, assignment_sets);
+            const auto schema_actions = generator.get_applicable_actions(state, assignment_sets_);
             applicable_actions.insert(applicable_actions.end(), schema_actions.begin(), schema_actions.end());
         }
 
@@ -50,6 +123,14 @@ namespace mimir::planners
                                                           const mimir::formalism::State& state,
                                                           mimir::formalism::ActionList& out_actions) const
     {
+        std::lock_guard<std::mutex> lock(assignment_sets_mutex_);
+        assignment_sets_.update(state->get_dynamic_ranks());
+
+        if (thread_pool_)
+        {
+            return get_applicable_actions_in_parallel(end_time, state, out_actions);
+        }
+
         for (const auto& [_, generator] : generators_)
         {
             if (std::chrono::high_resolution_clock::now() >= end_time)
@@ -57,7 +138,7 @@ namespace mimir::planners
                 return false;
             }
 
-            if (!generator.get_applicable_actions(end_time, state, out_actions))
+            if (!generator.get_applicable_actions(end_time, state, assignment_sets_, out_actions))
             {
                 return false;
             }
@@ -65,4 +146,6 @@ namespace mimir::planners
 
         return true;
     }
+
+    std::size_t LiftedSuccessorGenerator::get_num_threads() const { return thread_pool_ ? thread_pool_->num_threads() : 1; }
 }  // namespace planners
@@ -1,26 +1,33 @@
-#include "../../include/mimir/datastructures/robin_map.hpp"
+#include "../../include/mimir/formalism/state_repository.hpp"
 #include "../../include/mimir/search/batched_astar_search.hpp"
+#include "../../include/mimir/search/search_space.hpp"
 
 #include <algorithm>
-#include <deque>
+#include <chrono>
+#include <future>
 
 namespace mimir::planners
 {
     BatchedAStarSearchImpl::BatchedAStarSearchImpl(const mimir::formalism::ProblemDescription& problem,
                                                    const mimir::planners::SuccessorGenerator& successor_generator,
                                                    const mimir::planners::Heuristic& heuristic,
-                                                   const mimir::planners::OpenList& open_list) :
+                                                   const mimir::planners::OpenList& open_list,
+                                                   std::size_t batch_size,
+                                                   double max_latency) :
         SearchBase(problem),
         problem_(problem),
         successor_generator_(successor_generator),
         heuristic_(heuristic),
         open_list_(open_list),
+        batch_size_(batch_size),
+        max_latency_(max_latency),
         max_g_value_(-1),
         max_f_value_(-1),
         max_depth_(-1),
         expanded_(0),
         generated_(0),
-        evaluated_(0)
+        evaluated_(0),
+        batches_(0)
     {
     }
 
@@ -32,6 +39,7 @@ namespace mimir::planners
         expanded_ = 0;
         generated_ = 0;
         evaluated_ = 0;
+        batches_ = 0;
     }
 
     std::map<std::string, std::variant<int32_t, double>> BatchedAStarSearchImpl::get_statistics() const
@@ -40,6 +48,7 @@ namespace mimir::planners
         statistics["expanded"] = expanded_;
         statistics["generated"] = generated_;
         statistics["evaluated"] = evaluated_;
+        statistics["batches"] = batches_;
         statistics["max_depth"] = max_depth_;
         statistics["max_g_value"] = max_g_value_;
         statistics["max_f_value"] = max_f_value_;
@@ -56,49 +65,125 @@ namespace mimir::planners
         reset_statistics();
         int32_t last_f_value = -1;  // Used to notify handlers
 
-        struct Frame
+        // The nodes are indexed by the ids of their states in the repository
+        const auto state_repository = mimir::formalism::create_state_repository(problem_);
+        const auto search_space = create_search_space();
+        std::vector<std::size_t> succ_words;  // Scratch buffer, successors are only interned if they are new
+
+        // The successors that are not yet submitted, and the batch that is being evaluated if the search is pipelined
+        const auto is_pipelined = batch_size_ > 0;
+        mimir::formalism::StateList batched_states;
+        std::vector<int32_t> batched_indices;
+        std::chrono::steady_clock::time_point batch_start;
+        std::vector<int32_t> evaluating_indices;
+        std::future<std::vector<double>> evaluation;
+
+        const auto insert_evaluated = [this, &search_space](const std::vector<int32_t>& indices, const std::vector<double>& heuristic_values)
         {
-            mimir::formalism::State state;
-            mimir::formalism::Action predecessor_action;
-            int32_t predecessor_index;
-            int32_t depth;
-            double g_value;
-            double h_value;
-            bool closed;
+            for (std::size_t batch_index = 0; batch_index < indices.size(); ++batch_index)
+            {
+                const auto succ_index = indices[batch_index];
+                const auto succ_dead_end = HeuristicBase::is_dead_end(heuristic_values[batch_index]);
+
+                search_space->set_h_value(succ_index, heuristic_values[batch_index]);
+                search_space->set_closed(succ_index, succ_dead_end);
+                ++evaluated_;
+
+                // The g-value may have decreased while the state was evaluated
+
+                if (!succ_dead_end)
+                {
+                    const auto succ_h_value = search_space->get_h_value(succ_index);
+                    open_list_->insert(succ_index, search_space->get_g_value(succ_index) + succ_h_value, succ_h_value);
+                    ++generated_;
+                }
+            }
         };
 
-        mimir::tsl::robin_map<mimir::formalism::State, int32_t> state_indices;
-        std::deque<Frame> frame_list;
+        const auto wait_for_evaluation = [&evaluation, &evaluating_indices, &insert_evaluated]()
+        {
+            if (evaluation.valid())
+            {
+                insert_evaluated(evaluating_indices, evaluation.get());
+                evaluating_indices.clear();
+            }
+        };
 
-        {  // Initialize data-structures
-            // We want the index of the initial state to be 1 for convenience.
-            frame_list.emplace_back(Frame { nullptr, nullptr, -1, 0, 0.0, 0.0, true });
+        const auto submit_batch = [this, &batched_states, &batched_indices, &evaluating_indices, &evaluation, &wait_for_evaluation]()
+        {
+            // The heuristic is not required to be thread-safe, so the previous batch must be done
+
+            wait_for_evaluation();
+
+            if (batched_states.empty())
+            {
+                return;
+            }
+
+            evaluating_indices.swap(batched_indices);
+            evaluation = std::async(std::launch::async,
+                                    [heuristic = heuristic_, states = std::move(batched_states)]() { return heuristic->evaluate(states); });
+            batched_states.clear();
+            batched_indices.clear();
+            ++batches_;
+        };
 
-            // Add the initial state to the data-structures
-            const int32_t initial_index = static_cast<int32_t>(frame_list.size());
+        {  // Initialize data-structures
             const auto initial_state = this->initial_state;
             const auto initial_h_value = heuristic_->evaluate(initial_state);
-            state_indices[initial_state] = initial_index;
-            frame_list.emplace_back(Frame { initial_state, nullptr, -1, 0, 0.0, initial_h_value, false });
-            open_list_->insert(initial_index, 0.0);
+            mimir::formalism::StateId initial_index;
+            state_repository->insert(initial_state, initial_index);
+            search_space->add_root_node(initial_index);
+            search_space->set_h_value(initial_index, initial_h_value);
+            open_list_->insert(static_cast<int32_t>(initial_index), 0.0);
             ++evaluated_;
         }
 
-        while (open_list_->size() > 0)
+        while (true)
         {
-            const auto index = open_list_->pop();
-            auto& frame = frame_list[index];
+            if (is_pipelined)
+            {
+                if (evaluation.valid() && (evaluation.wait_for(std::chrono::seconds(0)) == std::future_status::ready))
+                {
+                    wait_for_evaluation();
+                }
+
+                if (!batched_states.empty())
+                {
+                    const auto is_full = batched_states.size() >= batch_size_;
+                    const auto is_late =
+                        !evaluation.valid() && (std::chrono::duration<double>(std::chrono::steady_clock::now() - batch_start).count() >= max_latency_);
+
+                    if (is_full || is_late || (open_list_->size() == 0))
+                    {
+                        submit_batch();
+                    }
+                }
+
+                if (open_list_->size() == 0)
+                {
+                    wait_for_evaluation();
+                }
+            }
+
+            if (open_list_->size() == 0)
+            {
+                break;
+            }
+
+            const auto index = static_cast<mimir::formalism::StateId>(open_list_->pop());
 
-            if (frame.closed)
+            if (search_space->is_closed(index))
             {
                 continue;
             }
 
-            frame.closed = true;
-            const auto f_value = frame.g_value + frame.h_value;
-            max_depth_ = std::max(max_depth_, frame.depth);
-            max_g_value_ = std::max(max_g_value_, frame.g_value);
-            max_f_value_ = std::max(max_f_value_, f_value);
+            search_space->set_closed(index, true);
+            const auto g_value = search_space->get_g_value(index);
+            const auto f_value = g_value + search_space->get_h_value(index);
+            max_depth_ = std::max(max_depth_, static_cast<int32_t>(search_space->get_depth(index)));
+            max_g_value_ = std::max(max_g_value_, static_cast<double>(g_value));
+            max_f_value_ = std::max(max_f_value_, static_cast<double>(f_value));
 
             if (last_f_value < f_value)
             {
@@ -111,93 +196,89 @@ namespace mimir::planners
                 return SearchResult::ABORTED;
             }
 
-            if (mimir::formalism::literals_hold(problem_->goal, frame.state))
-            {
-                // Reconstruct the path to the goal state
-
-                out_plan.clear();
-                auto current_frame = frame;
+            const auto state = state_repository->get_state(index);
 
-                while (current_frame.predecessor_action)
+            if (mimir::formalism::literals_hold(problem_->goal, state))
+            {
+                if (evaluation.valid() || !batched_states.empty())
                 {
-                    out_plan.emplace_back(current_frame.predecessor_action);
-                    current_frame = frame_list.at(current_frame.predecessor_index);
+                    // A state that is not yet in the open list may lead to a cheaper plan, so the goal state is put back until all are inserted
+
+                    search_space->set_closed(index, false);
+                    open_list_->insert(static_cast<int32_t>(index), f_value, search_space->get_h_value(index));
+                    submit_batch();
+                    wait_for_evaluation();
+                    continue;
                 }
 
-                std::reverse(out_plan.begin(), out_plan.end());
+                out_plan = search_space->get_plan(index);
                 return SearchResult::SOLVED;
             }
 
             ++expanded_;
 
-            const auto applicable_actions = successor_generator_->get_applicable_actions(frame.state);
-
-            mimir::formalism::StateList batched_states;
-            std::vector<int32_t> batched_indices;
+            const auto applicable_actions = successor_generator_->get_applicable_actions(state);
+            const auto state_words = state_repository->get_blocks(index);
+            const auto num_state_words = state_repository->get_num_blocks(index);
 
             for (const auto& action : applicable_actions)
             {
-                const auto succ_state = mimir::formalism::apply(action, frame.state);
-                auto& succ_index = state_indices[succ_state];  // Reference is used to update state_indices
+                mimir::formalism::apply_into(action, state_words, num_state_words, succ_words);
+                mimir::formalism::StateId succ_id;
+                const auto succ_g_value = g_value + static_cast<float>(action->cost);
 
-                if (succ_index == 0)
+                if (state_repository->insert(succ_words.data(), succ_words.size(), succ_id))
                 {
-                    // If succ_index is 0, then we haven't seen the state as it is reserved by the dummy frame that we added earlier
+                    const auto succ_index = static_cast<int32_t>(succ_id);
+                    const auto succ_state = state_repository->get_state(succ_id);
 
-                    succ_index = static_cast<int32_t>(frame_list.size());
-                    const auto succ_g_value = frame.g_value + action->cost;
+                    search_space->add_node(succ_id, index, action, succ_g_value);
 
-                    frame_list.emplace_back(Frame { succ_state, action, index, frame.depth + 1, succ_g_value, -1, false });
+                    if (batched_states.empty())
+                    {
+                        batch_start = std::chrono::steady_clock::now();
+                    }
 
                     batched_states.emplace_back(succ_state);
                     batched_indices.emplace_back(succ_index);
                 }
-                else
+                else if ((!search_space->is_closed(succ_id) || is_pipelined) && (succ_g_value < search_space->get_g_value(succ_id)))
                 {
-                    auto& succ_frame = frame_list[succ_index];
-                    const auto succ_g_value = frame.g_value + action->cost;
+                    // We have found a better way to the next state; update the node. Without pipelining, states are expanded in the order of their
+                    // f-values and closed states are never reached more cheaply.
 
-                    if (!succ_frame.closed && (succ_g_value < succ_frame.g_value))
-                    {
-                        // We have found a better way to the next state; update the frame
+                    search_space->set_parent(succ_id, index, action, succ_g_value);
 
-                        succ_frame.predecessor_action = action;
-                        succ_frame.predecessor_index = index;
-                        succ_frame.depth = frame.depth + 1;
-                        succ_frame.g_value = succ_g_value;
+                    // States that are not yet evaluated are inserted with their g-value at that time
 
-                        if (!HeuristicBase::is_dead_end(succ_frame.h_value))
-                        {
-                            // Instead of updating, we rely on the closed flag to ignore multiple entries in the same successor state
+                    const auto succ_h_value = search_space->get_h_value(succ_id);
+
+                    if (search_space->is_evaluated(succ_id) && !HeuristicBase::is_dead_end(succ_h_value))
+                    {
+                        // Open lists that support it update the entry of an open state, otherwise we rely on the closed flag to ignore multiple
+                        // entries in the same successor state. Closed states have no entry.
 
-                            const auto succ_f_value = succ_g_value + succ_frame.h_value;
-                            open_list_->insert(succ_index, succ_f_value);
-                            ++generated_;
+                        if (open_list_->supports_decrease_key() && !search_space->is_closed(succ_id))
+                        {
+                            open_list_->decrease_key(static_cast<int32_t>(succ_id), succ_g_value + succ_h_value, succ_h_value);
                         }
+                        else
+                        {
+                            search_space->set_closed(succ_id, false);
+                            open_list_->insert(static_cast<int32_t>(succ_id), succ_g_value + succ_h_value, succ_h_value);
+                        }
+
+                        ++generated_;
                     }
                 }
             }
 
-            const auto heuristic_values = heuristic_->evaluate(batched_states);
-
-            for (std::size_t batch_index = 0; batch_index < batched_states.size(); ++batch_index)
+            if (!is_pipelined)
             {
-                auto succ_index = batched_indices[batch_index];
-                auto& succ_frame = frame_list[succ_index];
-
-                const auto succ_h_value = heuristic_values[batch_index];
-                const auto succ_f_value = succ_frame.g_value + succ_h_value;
-                const auto succ_dead_end = HeuristicBase::is_dead_end(succ_h_value);
-
-                succ_frame.h_value = succ_h_value;
-                succ_frame.closed = succ_dead_end;
-                ++evaluated_;
-
-                if (!succ_dead_end)
-                {
-                    open_list_->insert(succ_index, succ_f_value);
-                    ++generated_;
-                }
+                insert_evaluated(batched_indices, heuristic_->evaluate(batched_states));
+                batched_states.clear();
+                batched_indices.clear();
+                ++batches_;
             }
         }
 
@@ -207,8 +288,10 @@ namespace mimir::planners
     BatchedAStarSearch create_batched_astar(const mimir::formalism::ProblemDescription& problem,
                                             const mimir::planners::SuccessorGenerator& successor_generator,
                                             const mimir::planners::Heuristic& heuristic,
-                                            const mimir::planners::OpenList& open_list)
+                                            const mimir::planners::OpenList& open_list,
+                                            std::size_t batch_size,
+                                            double max_latency)
     {
-        return std::make_shared<BatchedAStarSearchImpl>(problem, successor_generator, heuristic, open_list);
+        return std::make_shared<BatchedAStarSearchImpl>(problem, successor_generator, heuristic, open_list, batch_size, max_latency);
     }
 }  // namespace mimir::planners
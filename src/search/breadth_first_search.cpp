@@ -1,5 +1,6 @@
-#include "../../include/mimir/datastructures/robin_map.hpp"
+#include "../../include/mimir/formalism/state_repository.hpp"
 #include "../../include/mimir/search/breadth_first_search.hpp"
+#include "../../include/mimir/search/search_space.hpp"
 
 #include <algorithm>
 #include <deque>
@@ -41,43 +42,33 @@ namespace mimir::planners
         reset_statistics();
         int32_t last_depth = -1;  // Used to notify handlers
 
-        struct Frame
-        {
-            mimir::formalism::State state;
-            mimir::formalism::Action predecessor_action;
-            int32_t predecessor_index;
-            int32_t depth;
-            double g_value;
-        };
-
-        mimir::tsl::robin_map<mimir::formalism::State, int32_t> state_indices;
-        std::deque<Frame> frame_list;
-        std::deque<int32_t> open_list;
+        // The nodes are indexed by the ids of their states in the repository
+        const auto state_repository = mimir::formalism::create_state_repository(problem_);
+        const auto search_space = create_search_space();
+        std::deque<mimir::formalism::StateId> open_list;
+        std::vector<std::size_t> successor_words;  // Scratch buffer, successors are only interned if they are new
 
         {  // Initialize data-structures
-            // We want the index of the initial state to be 1 for convenience.
-            frame_list.emplace_back(Frame { nullptr, nullptr, -1, 0, 0.0 });
-
-            // Add the initial state to the data-structures
-            const int32_t initial_index = static_cast<int32_t>(frame_list.size());
-            const auto initial_state = this->initial_state;
-            state_indices[initial_state] = initial_index;
-            frame_list.emplace_back(Frame { initial_state, nullptr, -1, 0, 0.0 });
-            open_list.emplace_back(initial_index);
+            mimir::formalism::StateId initial_id;
+            state_repository->insert(this->initial_state, initial_id);
+            search_space->add_root_node(initial_id);
+            open_list.emplace_back(initial_id);
         }
 
         while (open_list.size() > 0)
         {
             const auto index = open_list.front();
-            const auto& frame = frame_list[index];
+            const auto depth = static_cast<int32_t>(search_space->get_depth(index));
+            const auto g_value = search_space->get_g_value(index);
+            const auto state = state_repository->get_state(index);
             open_list.pop_front();
 
-            max_depth_ = std::max(max_depth_, frame.depth);
-            max_g_value_ = std::max(max_g_value_, frame.g_value);
+            max_depth_ = std::max(max_depth_, depth);
+            max_g_value_ = std::max(max_g_value_, static_cast<double>(g_value));
 
-            if (last_depth < frame.depth)
+            if (last_depth < depth)
             {
-                last_depth = frame.depth;
+                last_depth = depth;
                 notify_handlers();
             }
 
@@ -86,38 +77,27 @@ namespace mimir::planners
                 return SearchResult::ABORTED;
             }
 
-            if (mimir::formalism::literals_hold(problem_->goal, frame.state))
+            if (mimir::formalism::literals_hold(problem_->goal, state))
             {
-                // Reconstruct the path to the goal state
-                out_plan.clear();
-                auto current_frame = frame;
-
-                while (current_frame.predecessor_action)
-                {
-                    out_plan.emplace_back(current_frame.predecessor_action);
-                    current_frame = frame_list.at(current_frame.predecessor_index);
-                }
-
-                std::reverse(out_plan.begin(), out_plan.end());
+                out_plan = search_space->get_plan(index);
                 return SearchResult::SOLVED;
             }
 
             ++expanded_;
 
-            const auto applicable_actions = successor_generator_->get_applicable_actions(frame.state);
+            const auto applicable_actions = successor_generator_->get_applicable_actions(state);
+            const auto state_words = state_repository->get_blocks(index);
+            const auto num_state_words = state_repository->get_num_blocks(index);
 
             for (const auto& action : applicable_actions)
             {
-                const auto successor_state = mimir::formalism::apply(action, frame.state);
-                auto& successor_index = state_indices[successor_state];  // Reference is used to update state_indices
+                mimir::formalism::apply_into(action, state_words, num_state_words, successor_words);
+                mimir::formalism::StateId successor_index;
 
-                if (successor_index == 0)
+                if (state_repository->insert(successor_words.data(), successor_words.size(), successor_index))
                 {
-                    // If successor_index is 0, then we haven't seen the state as it is reserved by the dummy frame that we added earlier.
-
                     ++generated_;
-                    successor_index = static_cast<int32_t>(frame_list.size());
-                    frame_list.emplace_back(Frame { successor_state, action, index, frame.depth + 1, frame.g_value + action->cost });
+                    search_space->add_node(successor_index, index, action, g_value + static_cast<float>(action->cost));
                     open_list.emplace_back(successor_index);
                 }
             }
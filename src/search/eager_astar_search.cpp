@@ -1,8 +1,8 @@
-#include "../../include/mimir/datastructures/robin_map.hpp"
+#include "../../include/mimir/formalism/state_repository.hpp"
 #include "../../include/mimir/search/eager_astar_search.hpp"
+#include "../../include/mimir/search/search_space.hpp"
 
 #include <algorithm>
-#include <deque>
 
 namespace mimir::planners
 {
@@ -56,49 +56,37 @@ namespace mimir::planners
         reset_statistics();
         int32_t last_f_value = -1;  // Used to notify handlers
 
-        struct Frame
-        {
-            mimir::formalism::State state;
-            mimir::formalism::Action predecessor_action;
-            int32_t predecessor_index;
-            int32_t depth;
-            double g_value;
-            double h_value;
-            bool closed;
-        };
-
-        mimir::tsl::robin_map<mimir::formalism::State, int32_t> state_indices;
-        std::deque<Frame> frame_list;
+        // The nodes are indexed by the ids of their states in the repository
+        const auto state_repository = mimir::formalism::create_state_repository(problem_);
+        const auto search_space = create_search_space();
+        std::vector<std::size_t> succ_words;  // Scratch buffer, successors are only interned if they are new
 
         {  // Initialize data-structures
-            // We want the index of the initial state to be 1 for convenience.
-            frame_list.emplace_back(Frame { nullptr, nullptr, -1, 0, 0.0, 0.0, true });
-
-            // Add the initial state to the data-structures
-            const int32_t initial_index = static_cast<int32_t>(frame_list.size());
             const auto initial_state = this->initial_state;
             const auto initial_h_value = heuristic_->evaluate(initial_state);
-            state_indices[initial_state] = initial_index;
-            frame_list.emplace_back(Frame { initial_state, nullptr, -1, 0, 0.0, initial_h_value, false });
-            open_list_->insert(initial_index, 0.0);
+            mimir::formalism::StateId initial_index;
+            state_repository->insert(initial_state, initial_index);
+            search_space->add_root_node(initial_index);
+            search_space->set_h_value(initial_index, initial_h_value);
+            open_list_->insert(static_cast<int32_t>(initial_index), 0.0);
             ++evaluated_;
         }
 
         while (open_list_->size() > 0)
         {
-            const auto index = open_list_->pop();
-            auto& frame = frame_list[index];
+            const auto index = static_cast<mimir::formalism::StateId>(open_list_->pop());
 
-            if (frame.closed)
+            if (search_space->is_closed(index))
             {
                 continue;
             }
 
-            frame.closed = true;
-            const auto f_value = frame.g_value + frame.h_value;
-            max_depth_ = std::max(max_depth_, frame.depth);
-            max_g_value_ = std::max(max_g_value_, frame.g_value);
-            max_f_value_ = std::max(max_f_value_, f_value);
+            search_space->set_closed(index, true);
+            const auto g_value = search_space->get_g_value(index);
+            const auto f_value = g_value + search_space->get_h_value(index);
+            max_depth_ = std::max(max_depth_, static_cast<int32_t>(search_space->get_depth(index)));
+            max_g_value_ = std::max(max_g_value_, static_cast<double>(g_value));
+            max_f_value_ = std::max(max_f_value_, static_cast<double>(f_value));
 
             if (last_f_value < f_value)
             {
@@ -111,74 +99,65 @@ namespace mimir::planners
                 return SearchResult::ABORTED;
             }
 
-            if (mimir::formalism::literals_hold(problem_->goal, frame.state))
-            {
-                // Reconstruct the path to the goal state
-
-                out_plan.clear();
-                auto current_frame = frame;
-
-                while (current_frame.predecessor_action)
-                {
-                    out_plan.emplace_back(current_frame.predecessor_action);
-                    current_frame = frame_list.at(current_frame.predecessor_index);
-                }
+            const auto state = state_repository->get_state(index);
 
-                std::reverse(out_plan.begin(), out_plan.end());
+            if (mimir::formalism::literals_hold(problem_->goal, state))
+            {
+                out_plan = search_space->get_plan(index);
                 return SearchResult::SOLVED;
             }
 
             ++expanded_;
 
-            const auto applicable_actions = successor_generator_->get_applicable_actions(frame.state);
+            const auto applicable_actions = successor_generator_->get_applicable_actions(state);
+            const auto state_words = state_repository->get_blocks(index);
+            const auto num_state_words = state_repository->get_num_blocks(index);
 
             for (const auto& action : applicable_actions)
             {
-                const auto succ_state = mimir::formalism::apply(action, frame.state);
-                auto& succ_index = state_indices[succ_state];  // Reference is used to update state_indices
+                mimir::formalism::apply_into(action, state_words, num_state_words, succ_words);
+                mimir::formalism::StateId succ_id;
+                const auto succ_g_value = g_value + static_cast<float>(action->cost);
 
-                if (succ_index == 0)
+                if (state_repository->insert(succ_words.data(), succ_words.size(), succ_id))
                 {
-                    // If succ_index is 0, then we haven't seen the state as it is reserved by the dummy frame that we added earlier
-
-                    succ_index = static_cast<int32_t>(frame_list.size());
-                    const auto succ_g_value = frame.g_value + action->cost;
+                    const auto succ_state = state_repository->get_state(succ_id);
                     const auto succ_h_value = heuristic_->evaluate(succ_state);
-                    const auto succ_f_value = succ_g_value + succ_h_value;
                     const auto succ_dead_end = HeuristicBase::is_dead_end(succ_h_value);
                     ++evaluated_;
 
-                    frame_list.emplace_back(Frame { succ_state, action, index, frame.depth + 1, succ_g_value, succ_h_value, succ_dead_end });
+                    search_space->add_node(succ_id, index, action, succ_g_value);
+                    search_space->set_h_value(succ_id, succ_h_value);
+                    search_space->set_closed(succ_id, succ_dead_end);
 
                     if (!succ_dead_end)
                     {
-                        open_list_->insert(succ_index, succ_f_value);
+                        const auto stored_h_value = search_space->get_h_value(succ_id);
+                        open_list_->insert(static_cast<int32_t>(succ_id), succ_g_value + stored_h_value, stored_h_value);
                         ++generated_;
                     }
                 }
-                else
+                else if (!search_space->is_closed(succ_id) && (succ_g_value < search_space->get_g_value(succ_id)))
                 {
-                    auto& succ_frame = frame_list[succ_index];
-                    const auto succ_g_value = frame.g_value + action->cost;
+                    // We have found a better way to the next state; update the node. Dead ends are closed, so the state is in the open list.
 
-                    if (!succ_frame.closed && (succ_g_value < succ_frame.g_value))
-                    {
-                        // We have found a better way to the next state; update the frame
+                    search_space->set_parent(succ_id, index, action, succ_g_value);
 
-                        succ_frame.predecessor_action = action;
-                        succ_frame.predecessor_index = index;
-                        succ_frame.depth = frame.depth + 1;
-                        succ_frame.g_value = succ_g_value;
+                    // Open lists that support it update the entry of the state, otherwise we rely on the closed flag to ignore multiple entries in the
+                    // same successor state
 
-                        if (!HeuristicBase::is_dead_end(succ_frame.h_value))
-                        {
-                            // Instead of updating, we rely on the closed flag to ignore multiple entries in the same successor state
+                    const auto succ_h_value = search_space->get_h_value(succ_id);
 
-                            const auto succ_f_value = succ_g_value + succ_frame.h_value;
-                            open_list_->insert(succ_index, succ_f_value);
-                            ++generated_;
-                        }
+                    if (open_list_->supports_decrease_key())
+                    {
+                        open_list_->decrease_key(static_cast<int32_t>(succ_id), succ_g_value + succ_h_value, succ_h_value);
                     }
+                    else
+                    {
+                        open_list_->insert(static_cast<int32_t>(succ_id), succ_g_value + succ_h_value, succ_h_value);
+                    }
+
+                    ++generated_;
                 }
             }
         }
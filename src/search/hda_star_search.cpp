@@ -0,0 +1,523 @@
+#include "../../include/mimir/algorithms/mpsc_queue.hpp"
+#include "../../include/mimir/search/hda_star_search.hpp"
+#include "../../include/mimir/search/openlists/indexed_heap_open_list.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+namespace mimir::planners
+{
+    struct HDAStarSearchImpl::Worker
+    {
+        static constexpr uint32_t no_parent = std::numeric_limits<uint32_t>::max();
+
+        /// @brief A successor sent to its owner. The blocks of its state are stored in the batch.
+        struct Message
+        {
+            uint32_t block_offset;
+            uint32_t num_blocks;
+            uint32_t parent_worker;
+            mimir::formalism::StateId parent_id;
+            mimir::formalism::Action action;
+            float g_value;
+            uint32_t depth;
+        };
+
+        struct Batch
+        {
+            std::vector<std::size_t> blocks;
+            std::vector<Message> messages;
+        };
+
+        mimir::planners::Heuristic heuristic;
+        mimir::formalism::StateRepository state_repository;
+        std::shared_ptr<IndexedHeapOpenList<int32_t>> open_list;
+        mimir::algorithms::MpscQueue<Batch> inbox;
+        std::vector<Batch> outboxes;  // The successors that are not yet sent, one batch per worker
+
+        // The search nodes, indexed by the ids of the states in the repository of the worker. The parent of a node may be owned by another worker.
+        std::vector<uint32_t> parent_workers;
+        std::vector<mimir::formalism::StateId> parent_ids;
+        mimir::formalism::ActionList actions;
+        std::vector<uint32_t> depths;
+        std::vector<float> g_values;
+        std::vector<float> h_values;
+        std::vector<uint8_t> closed;  // Set for every node that is not in the open list
+
+        // The statistics since they were last published
+        double max_g_value;
+        double max_f_value;
+        int32_t max_depth;
+        int32_t expanded;
+        int32_t generated;
+        int32_t evaluated;
+        int32_t reopened;
+        int32_t sent;
+
+        Worker(const mimir::formalism::ProblemDescription& problem, const mimir::planners::Heuristic& heuristic, std::size_t num_workers) :
+            heuristic(heuristic),
+            state_repository(mimir::formalism::create_state_repository(problem)),
+            open_list(create_indexed_heap_open_list()),
+            inbox(),
+            outboxes(num_workers),
+            parent_workers(),
+            parent_ids(),
+            actions(),
+            depths(),
+            g_values(),
+            h_values(),
+            closed(),
+            max_g_value(-1),
+            max_f_value(-1),
+            max_depth(-1),
+            expanded(0),
+            generated(0),
+            evaluated(0),
+            reopened(0),
+            sent(0)
+        {
+        }
+    };
+
+    // The number of expansions after which a worker sends its batches, even if it has states left to expand
+    static constexpr int32_t flush_interval = 32;
+
+    template<typename T>
+    static void update_maximum(std::atomic<T>& maximum, T value)
+    {
+        auto current = maximum.load(std::memory_order_relaxed);
+
+        while ((current < value) && !maximum.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+    }
+
+    HDAStarSearchImpl::HDAStarSearchImpl(const mimir::formalism::ProblemDescription& problem,
+                                         const mimir::planners::SuccessorGenerator& successor_generator,
+                                         const std::vector<mimir::planners::Heuristic>& heuristics) :
+        SearchBase(problem),
+        problem_(problem),
+        successor_generator_(successor_generator),
+        heuristics_(heuristics),
+        successor_generator_mutex_(),
+        incumbent_g_value_(std::numeric_limits<float>::infinity()),
+        incumbent_mutex_(),
+        incumbent_worker_(0),
+        incumbent_id_(0),
+        work_(0),
+        stop_(false),
+        max_g_value_(-1),
+        max_f_value_(-1),
+        max_depth_(-1),
+        expanded_(0),
+        generated_(0),
+        evaluated_(0),
+        reopened_(0),
+        sent_(0)
+    {
+        if (heuristics.empty())
+        {
+            throw std::invalid_argument("HDA* needs one heuristic per worker");
+        }
+    }
+
+    void HDAStarSearchImpl::reset_statistics()
+    {
+        max_g_value_ = -1;
+        max_f_value_ = -1;
+        max_depth_ = -1;
+        expanded_ = 0;
+        generated_ = 0;
+        evaluated_ = 0;
+        reopened_ = 0;
+        sent_ = 0;
+    }
+
+    std::map<std::string, std::variant<int32_t, double>> HDAStarSearchImpl::get_statistics() const
+    {
+        std::map<std::string, std::variant<int32_t, double>> statistics;
+        statistics["expanded"] = expanded_.load();
+        statistics["generated"] = generated_.load();
+        statistics["evaluated"] = evaluated_.load();
+        statistics["reopened"] = reopened_.load();
+        statistics["sent"] = sent_.load();
+        statistics["workers"] = static_cast<int32_t>(heuristics_.size());
+        statistics["max_depth"] = max_depth_.load();
+        statistics["max_g_value"] = max_g_value_.load();
+        statistics["max_f_value"] = max_f_value_.load();
+        return statistics;
+    }
+
+    std::size_t HDAStarSearchImpl::get_owner(const std::size_t* blocks, std::size_t num_blocks) const
+    {
+        // The state repositories of the workers index their tables by the low bits of the same hash, the owner is chosen by the high bits so that
+        // the states of a worker are still spread over all buckets
+
+        const auto hash = static_cast<uint64_t>(mimir::formalism::StateRepositoryImpl::hash(blocks, num_blocks));
+        return static_cast<std::size_t>(((hash >> 32) * heuristics_.size()) >> 32);
+    }
+
+    void HDAStarSearchImpl::insert_state(Worker& worker,
+                                         const std::size_t* blocks,
+                                         std::size_t num_blocks,
+                                         std::size_t parent_worker,
+                                         mimir::formalism::StateId parent_id,
+                                         const mimir::formalism::Action& action,
+                                         float g_value,
+                                         uint32_t depth)
+    {
+        // A path that is not cheaper than the incumbent plan cannot be part of a cheaper plan
+
+        if (g_value >= incumbent_g_value_.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+
+        mimir::formalism::StateId id;
+        const auto is_new = worker.state_repository->insert(blocks, num_blocks, id);
+
+        if (is_new)
+        {
+            worker.parent_workers.emplace_back(static_cast<uint32_t>(parent_worker));
+            worker.parent_ids.emplace_back(parent_id);
+            worker.actions.emplace_back(action);
+            worker.depths.emplace_back(depth);
+            worker.g_values.emplace_back(g_value);
+            worker.h_values.emplace_back(static_cast<float>(worker.heuristic->evaluate(worker.state_repository->get_state(id))));
+            worker.closed.emplace_back(1);
+            ++worker.evaluated;
+        }
+        else if (g_value < worker.g_values[id])
+        {
+            worker.parent_workers[id] = static_cast<uint32_t>(parent_worker);
+            worker.parent_ids[id] = parent_id;
+            worker.actions[id] = action;
+            worker.depths[id] = depth;
+            worker.g_values[id] = g_value;
+        }
+        else
+        {
+            return;
+        }
+
+        const auto h_value = worker.h_values[id];
+        const auto f_value = g_value + h_value;
+
+        if (HeuristicBase::is_dead_end(h_value))
+        {
+            return;
+        }
+
+        if (!worker.closed[id])
+        {
+            worker.open_list->decrease_key(static_cast<int32_t>(id), f_value, h_value);
+        }
+        else if (f_value < incumbent_g_value_.load(std::memory_order_relaxed))
+        {
+            // States are expanded in the order of their f-values within a worker only, so closed states are reopened
+
+            worker.closed[id] = 0;
+            worker.open_list->insert(static_cast<int32_t>(id), f_value, h_value);
+
+            if (is_new)
+            {
+                ++worker.generated;
+            }
+            else
+            {
+                ++worker.reopened;
+            }
+        }
+    }
+
+    void HDAStarSearchImpl::flush_batches(Worker& worker, std::vector<std::unique_ptr<Worker>>& workers)
+    {
+        for (std::size_t receiver = 0; receiver < workers.size(); ++receiver)
+        {
+            auto& outbox = worker.outboxes[receiver];
+
+            if (!outbox.messages.empty())
+            {
+                // The batch counts as work until it is received, so the search cannot terminate while it is in transit
+
+                worker.sent += static_cast<int32_t>(outbox.messages.size());
+                work_.fetch_add(1);
+                workers[receiver]->inbox.push(std::move(outbox));
+                outbox = Worker::Batch();
+            }
+        }
+    }
+
+    void HDAStarSearchImpl::publish_statistics(Worker& worker)
+    {
+        update_maximum(max_g_value_, worker.max_g_value);
+        update_maximum(max_f_value_, worker.max_f_value);
+        update_maximum(max_depth_, worker.max_depth);
+        expanded_ += worker.expanded;
+        generated_ += worker.generated;
+        evaluated_ += worker.evaluated;
+        reopened_ += worker.reopened;
+        sent_ += worker.sent;
+        worker.expanded = 0;
+        worker.generated = 0;
+        worker.evaluated = 0;
+        worker.reopened = 0;
+        worker.sent = 0;
+    }
+
+    void HDAStarSearchImpl::run_worker(std::size_t worker_index, std::vector<std::unique_ptr<Worker>>& workers)
+    {
+        auto& worker = *workers[worker_index];
+        const auto is_thread_safe = successor_generator_->is_thread_safe();
+        Worker::Batch batch;
+        std::vector<std::size_t> succ_blocks;  // Scratch buffer, successors are only interned by their owners
+        bool is_busy = true;
+        int32_t num_expansions = 0;
+        float last_f_value = -1;  // Used to notify handlers
+
+        while (!stop_.load(std::memory_order_relaxed))
+        {
+            while (worker.inbox.pop(batch))
+            {
+                // The worker becomes busy before the batch stops counting as work
+
+                if (!is_busy)
+                {
+                    work_.fetch_add(1);
+                    is_busy = true;
+                }
+
+                for (const auto& message : batch.messages)
+                {
+                    insert_state(worker,
+                                 batch.blocks.data() + message.block_offset,
+                                 message.num_blocks,
+                                 message.parent_worker,
+                                 message.parent_id,
+                                 message.action,
+                                 message.g_value,
+                                 message.depth);
+                }
+
+                work_.fetch_sub(1);
+            }
+
+            if (worker.open_list->size() == 0)
+            {
+                flush_batches(worker, workers);
+                publish_statistics(worker);
+
+                if (is_busy)
+                {
+                    work_.fetch_sub(1);
+                    is_busy = false;
+                }
+
+                if (work_.load() == 0)
+                {
+                    break;
+                }
+
+                std::this_thread::yield();
+                continue;
+            }
+
+            const auto index = static_cast<mimir::formalism::StateId>(worker.open_list->pop());
+            const auto g_value = worker.g_values[index];
+            const auto f_value = g_value + worker.h_values[index];
+            worker.closed[index] = 1;
+
+            // The state stays closed until a cheaper path to it arrives
+
+            if (f_value >= incumbent_g_value_.load(std::memory_order_relaxed))
+            {
+                continue;
+            }
+
+            worker.max_depth = std::max(worker.max_depth, static_cast<int32_t>(worker.depths[index]));
+            worker.max_g_value = std::max(worker.max_g_value, static_cast<double>(g_value));
+            worker.max_f_value = std::max(worker.max_f_value, static_cast<double>(f_value));
+
+            if ((worker_index == 0) && (last_f_value < f_value))
+            {
+                // Handlers are only notified on the calling thread, which runs the first worker, and only this thread reads the abort flag that
+                // they set. The other workers see it through the atomic stop flag.
+
+                last_f_value = f_value;
+                publish_statistics(worker);
+                notify_handlers();
+
+                if (should_abort)
+                {
+                    stop_.store(true);
+                    break;
+                }
+            }
+
+            const auto state = worker.state_repository->get_state(index);
+
+            if (mimir::formalism::literals_hold(problem_->goal, state))
+            {
+                std::lock_guard<std::mutex> lock(incumbent_mutex_);
+
+                if (g_value < incumbent_g_value_.load())
+                {
+                    incumbent_g_value_.store(g_value);
+                    incumbent_worker_ = worker_index;
+                    incumbent_id_ = index;
+                }
+
+                continue;
+            }
+
+            ++worker.expanded;
+
+            mimir::formalism::ActionList applicable_actions;
+
+            if (is_thread_safe)
+            {
+                applicable_actions = successor_generator_->get_applicable_actions(state);
+            }
+            else
+            {
+                std::lock_guard<std::mutex> lock(successor_generator_mutex_);
+                applicable_actions = successor_generator_->get_applicable_actions(state);
+            }
+
+            const auto state_blocks = worker.state_repository->get_blocks(index);
+            const auto num_state_blocks = worker.state_repository->get_num_blocks(index);
+            const auto succ_depth = worker.depths[index] + 1;
+
+            for (const auto& action : applicable_actions)
+            {
+                mimir::formalism::apply_into(action, state_blocks, num_state_blocks, succ_blocks);
+                const auto succ_g_value = g_value + static_cast<float>(action->cost);
+                const auto owner = get_owner(succ_blocks.data(), succ_blocks.size());
+
+                if (owner == worker_index)
+                {
+                    insert_state(worker, succ_blocks.data(), succ_blocks.size(), worker_index, index, action, succ_g_value, succ_depth);
+                }
+                else if (succ_g_value < incumbent_g_value_.load(std::memory_order_relaxed))
+                {
+                    auto& outbox = worker.outboxes[owner];
+                    outbox.messages.emplace_back(Worker::Message { static_cast<uint32_t>(outbox.blocks.size()),
+                                                                   static_cast<uint32_t>(succ_blocks.size()),
+                                                                   static_cast<uint32_t>(worker_index),
+                                                                   index,
+                                                                   action,
+                                                                   succ_g_value,
+                                                                   succ_depth });
+                    outbox.blocks.insert(outbox.blocks.end(), succ_blocks.begin(), succ_blocks.end());
+                }
+            }
+
+            if (++num_expansions % flush_interval == 0)
+            {
+                flush_batches(worker, workers);
+                publish_statistics(worker);
+            }
+        }
+
+        publish_statistics(worker);
+    }
+
+    SearchResult HDAStarSearchImpl::plan(mimir::formalism::ActionList& out_plan)
+    {
+        reset_statistics();
+
+        const auto num_workers = heuristics_.size();
+        std::vector<std::unique_ptr<Worker>> workers;
+
+        for (const auto& heuristic : heuristics_)
+        {
+            workers.emplace_back(std::make_unique<Worker>(problem_, heuristic, num_workers));
+        }
+
+        incumbent_g_value_ = std::numeric_limits<float>::infinity();
+        work_ = static_cast<int64_t>(num_workers);
+        stop_ = false;
+
+        {  // The owner of the initial state evaluates it
+            const auto& initial_blocks = this->initial_state->get_blocks();
+            auto& owner = *workers[get_owner(initial_blocks.data(), initial_blocks.size())];
+            insert_state(owner, initial_blocks.data(), initial_blocks.size(), Worker::no_parent, 0, nullptr, 0.0f, 0);
+        }
+
+        std::exception_ptr exception;
+        std::mutex exception_mutex;
+
+        const auto run = [this, &workers, &exception, &exception_mutex](std::size_t worker_index)
+        {
+            try
+            {
+                run_worker(worker_index, workers);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(exception_mutex);
+
+                if (!exception)
+                {
+                    exception = std::current_exception();
+                }
+
+                stop_ = true;
+            }
+        };
+
+        std::vector<std::thread> threads;
+
+        for (std::size_t worker_index = 1; worker_index < num_workers; ++worker_index)
+        {
+            threads.emplace_back(run, worker_index);
+        }
+
+        run(0);
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        if (exception)
+        {
+            std::rethrow_exception(exception);
+        }
+
+        if (should_abort)
+        {
+            return SearchResult::ABORTED;
+        }
+
+        if (HeuristicBase::is_dead_end(incumbent_g_value_.load()))
+        {
+            return SearchResult::UNSOLVABLE;
+        }
+
+        // Follow the parents across the workers, the path can only have become cheaper since the incumbent was found
+
+        out_plan.clear();
+        auto worker_index = incumbent_worker_;
+        auto id = incumbent_id_;
+
+        while (workers[worker_index]->parent_workers[id] != Worker::no_parent)
+        {
+            const auto& worker = *workers[worker_index];
+            out_plan.emplace_back(worker.actions[id]);
+            worker_index = worker.parent_workers[id];
+            id = worker.parent_ids[id];
+        }
+
+        std::reverse(out_plan.begin(), out_plan.end());
+        return SearchResult::SOLVED;
+    }
+
+    HDAStarSearch create_hda_star(const mimir::formalism::ProblemDescription& problem,
+                                  const mimir::planners::SuccessorGenerator& successor_generator,
+                                  const std::vector<mimir::planners::Heuristic>& heuristics)
+    {
+        return std::make_shared<HDAStarSearchImpl>(problem, successor_generator, heuristics);
+    }
+}  // namespace mimir::planners
@@ -15,23 +15,37 @@
  * along with this program. If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include "../../../include/mimir/formalism/fixed_bitset.hpp"
 #include "../../../include/mimir/generators/grounded_successor_generator.hpp"
+#include "../../../include/mimir/search/heuristics/cost_kernels.hpp"
 #include "../../../include/mimir/search/heuristics/h2_heuristic.hpp"
 
 #include <algorithm>
-#include <cmath>
-#include <deque>
-#include <iterator>
-#include <limits>
+#include <stdexcept>
+#include <type_traits>
 
 namespace mimir::planners
 {
-    H2Heuristic::H2Heuristic(const mimir::formalism::ProblemDescription& problem, const mimir::planners::SuccessorGenerator& successor_generator) :
+    H2Heuristic::H2Heuristic(const mimir::formalism::ProblemDescription& problem,
+                             const mimir::planners::SuccessorGenerator& successor_generator,
+                             bool prune_mutex_pairs) :
         problem_(problem),
-        actions_(),
+        num_static_ranks_(static_cast<uint32_t>(problem->get_static_atoms().size())),
+        num_atoms_(problem->num_ranks() - num_static_ranks_),
+        precondition_begin_(),
+        preconditions_(),
+        add_effect_begin_(),
+        add_effects_(),
+        delete_effect_begin_(),
+        delete_effects_(),
+        action_costs_(),
         goal_(),
-        h1_table_(),
-        h2_table_()
+        is_pruned_(false),
+        pair_words_(),
+        pair_word_ranks_(),
+        table_(),
+        state_atoms_(),
+        batch_table_()
     {
         const auto grounded_successor_generator = std::dynamic_pointer_cast<mimir::planners::GroundedSuccessorGenerator>(successor_generator);
 
@@ -40,19 +54,7 @@ namespace mimir::planners
             throw std::invalid_argument("successor generator must be grounded");
         }
 
-        const auto num_ranks = static_cast<int32_t>(problem->num_ranks());
-
-        // Pre-allocate memory for ht1 and ht2
-
-        h1_table_.resize(num_ranks);
-        h2_table_.resize(num_ranks);
-
-        for (int32_t i = 0; i < num_ranks; ++i)
-        {
-            h2_table_[i].resize(num_ranks);
-        }
-
-        // Convert the goal to the internal format
+        // Convert the goal to the internal format, static atoms are true in every state and are left out
 
         for (const auto& literal : problem->goal)
         {
@@ -61,212 +63,482 @@ namespace mimir::planners
                 throw std::invalid_argument("negative literals in the goal are not supported");
             }
 
-            goal_.push_back(problem->get_rank(literal->atom));
+            const auto rank = problem->get_rank(literal->atom);
+
+            if (rank >= num_static_ranks_)
+            {
+                goal_.emplace_back(rank - num_static_ranks_);
+            }
         }
 
-        // Convert all actions to the internal format
+        std::sort(goal_.begin(), goal_.end());
+        goal_.erase(std::unique(goal_.begin(), goal_.end()), goal_.end());
+
+        // Convert all actions to the internal format, the effects of conditional effects are treated as unconditional effects
 
         const auto& actions = grounded_successor_generator->get_actions();
+        std::vector<uint32_t> precondition;
+        std::vector<uint32_t> add_effect;
+        std::vector<uint32_t> delete_effect;
+        precondition_begin_.emplace_back(0);
+        add_effect_begin_.emplace_back(0);
+        delete_effect_begin_.emplace_back(0);
+
+        const auto add_literals = [this, &add_effect, &delete_effect](const mimir::formalism::LiteralList& literals)
+        {
+            for (const auto& literal : literals)
+            {
+                const auto rank = problem_->get_rank(literal->atom);
+
+                if (rank >= num_static_ranks_)
+                {
+                    (literal->negated ? delete_effect : add_effect).emplace_back(rank - num_static_ranks_);
+                }
+            }
+        };
+
+        const auto append_sorted = [](std::vector<uint32_t>& atoms, std::vector<uint32_t>& out_atoms, std::vector<uint32_t>& out_begin)
+        {
+            std::sort(atoms.begin(), atoms.end());
+            atoms.erase(std::unique(atoms.begin(), atoms.end()), atoms.end());
+            out_atoms.insert(out_atoms.end(), atoms.begin(), atoms.end());
+            out_begin.emplace_back(static_cast<uint32_t>(out_atoms.size()));
+        };
 
         for (const auto& action : actions)
         {
-            std::vector<int32_t> precondition;
-            std::vector<int32_t> add_effect;
-            std::vector<int32_t> delete_effect;
-            std::vector<int32_t> delete_effect_complement;
+            precondition.clear();
+            add_effect.clear();
+            delete_effect.clear();
 
             for (const auto& literal : action->get_precondition())
             {
-                if (!literal->negated)
+                const auto rank = problem->get_rank(literal->atom);
+
+                if (!literal->negated && (rank >= num_static_ranks_))
                 {
-                    precondition.emplace_back(problem->get_rank(literal->atom));
+                    precondition.emplace_back(rank - num_static_ranks_);
                 }
             }
 
-            for (const auto& literal : action->get_unconditional_effect())
+            add_literals(action->get_unconditional_effect());
+
+            for (const auto& [antecedent, consequence] : action->get_conditional_effect())
             {
-                if (literal->negated)
-                {
-                    delete_effect.emplace_back(problem->get_rank(literal->atom));
-                }
-                else
-                {
-                    add_effect.emplace_back(problem->get_rank(literal->atom));
-                }
+                add_literals(consequence);
             }
 
-            for (const auto& [antecedent, consequence] : action->get_conditional_effect())
+            append_sorted(precondition, preconditions_, precondition_begin_);
+            append_sorted(add_effect, add_effects_, add_effect_begin_);
+            append_sorted(delete_effect, delete_effects_, delete_effect_begin_);
+            action_costs_.emplace_back(static_cast<float>(action->cost));
+        }
+
+        table_.resize(static_cast<std::size_t>(num_atoms_) * (num_atoms_ + 1) / 2);
+
+        if (prune_mutex_pairs)
+        {
+            this->prune_mutex_pairs();
+        }
+    }
+
+    std::size_t H2Heuristic::get_index(uint32_t atom1, uint32_t atom2) const
+    {
+        if (atom1 < atom2)
+        {
+            std::swap(atom1, atom2);
+        }
+
+        const auto index = static_cast<std::size_t>(atom1) * (atom1 + 1) / 2 + atom2;
+
+        if (!is_pruned_)
+        {
+            return index;
+        }
+
+        constexpr std::size_t bits_per_word = sizeof(std::size_t) * 8;
+        const auto word = pair_words_[index / bits_per_word];
+        const auto bit = static_cast<std::size_t>(1) << (index % bits_per_word);
+
+        if ((word & bit) == 0)
+        {
+            return no_pair;
+        }
+
+        return pair_word_ranks_[index / bits_per_word] + mimir::formalism::kernels::popcount_word(word & (bit - 1));
+    }
+
+    float H2Heuristic::eval(const uint32_t* first, const uint32_t* last) const
+    {
+        float v = 0;
+
+        for (auto atom1 = first; atom1 != last; ++atom1)
+        {
+            for (auto atom2 = atom1; atom2 != last; ++atom2)
             {
-                for (const auto& literal : consequence)
+                const auto index = get_index(*atom1, *atom2);
+
+                if (index == no_pair)
                 {
-                    if (literal->negated)
-                    {
-                        delete_effect.emplace_back(problem->get_rank(literal->atom));
-                    }
-                    else
-                    {
-                        add_effect.emplace_back(problem->get_rank(literal->atom));
-                    }
+                    return static_cast<float>(DEAD_END);
                 }
-            }
 
-            for (int32_t rank = 0; rank < num_ranks; ++rank)
-            {
-                if (std::find(delete_effect.begin(), delete_effect.end(), rank) == delete_effect.end())
+                v = std::max(v, table_[index]);
+
+                if (is_dead_end(v))
                 {
-                    delete_effect_complement.emplace_back(rank);
+                    return v;
                 }
             }
-
-            actions_.emplace_back(precondition, add_effect, delete_effect_complement, action->cost);
         }
+
+        return v;
     }
 
-    double H2Heuristic::eval(const std::vector<int32_t>& ranks) const
+    float H2Heuristic::eval(const uint32_t* first, const uint32_t* last, uint32_t atom) const
     {
-        double v = 0;
+        const auto atom_index = get_index(atom, atom);
 
-        for (std::size_t i = 0; i < ranks.size(); i++)
+        if (atom_index == no_pair)
         {
-            v = std::max(v, h1_table_[ranks[i]]);
+            return static_cast<float>(DEAD_END);
+        }
+
+        float v = table_[atom_index];
 
-            if (is_dead_end(v))
+        for (auto other = first; (other != last) && !is_dead_end(v); ++other)
+        {
+            const auto index = get_index(atom, *other);
+
+            if (index == no_pair)
             {
-                return DEAD_END;
+                return static_cast<float>(DEAD_END);
             }
 
-            for (std::size_t j = i + 1; j < ranks.size(); j++)
+            v = std::max(v, table_[index]);
+        }
+
+        return v;
+    }
+
+    void H2Heuristic::update(uint32_t atom1, uint32_t atom2, float value, bool& changed) const
+    {
+        const auto index = get_index(atom1, atom2);
+
+        // Pairs without an entry are mutex and keep their infinite cost
+
+        if ((index != no_pair) && (table_[index] > value))
+        {
+            table_[index] = value;
+            changed = true;
+        }
+    }
+
+    void H2Heuristic::fill_table(const std::vector<uint32_t>& state_atoms) const
+    {
+        std::fill(table_.begin(), table_.end(), static_cast<float>(DEAD_END));
+
+        for (std::size_t i = 0; i < state_atoms.size(); ++i)
+        {
+            for (std::size_t j = i; j < state_atoms.size(); ++j)
             {
-                v = std::max(v, h2_table_[ranks[i]][ranks[j]]);
+                const auto index = get_index(state_atoms[i], state_atoms[j]);
 
-                if (is_dead_end(v))
+                if (index != no_pair)
                 {
-                    return DEAD_END;
+                    table_[index] = 0;
                 }
             }
         }
 
-        return v;
+        const auto num_actions = action_costs_.size();
+        bool changed;
+
+        do
+        {
+            changed = false;
+
+            for (std::size_t action_index = 0; action_index < num_actions; ++action_index)
+            {
+                const auto precondition_first = preconditions_.data() + precondition_begin_[action_index];
+                const auto precondition_last = preconditions_.data() + precondition_begin_[action_index + 1];
+                const auto add_first = add_effects_.data() + add_effect_begin_[action_index];
+                const auto add_last = add_effects_.data() + add_effect_begin_[action_index + 1];
+                const auto delete_first = delete_effects_.data() + delete_effect_begin_[action_index];
+                const auto delete_last = delete_effects_.data() + delete_effect_begin_[action_index + 1];
+                const auto cost = action_costs_[action_index];
+                const auto cost1 = eval(precondition_first, precondition_last);
+
+                if (is_dead_end(cost1))
+                {
+                    continue;
+                }
+
+                for (auto add = add_first; add != add_last; ++add)
+                {
+                    for (auto other_add = add; other_add != add_last; ++other_add)
+                    {
+                        update(*add, *other_add, cost1 + cost, changed);
+                    }
+                }
+
+                // Pair the added atoms with every atom that is not deleted, the delete effects are sorted and walked alongside
+
+                auto delete_effect = delete_first;
+
+                for (uint32_t atom2 = 0; atom2 < num_atoms_; ++atom2)
+                {
+                    while ((delete_effect != delete_last) && (*delete_effect < atom2))
+                    {
+                        ++delete_effect;
+                    }
+
+                    if ((delete_effect != delete_last) && (*delete_effect == atom2))
+                    {
+                        continue;
+                    }
+
+                    const auto cost2 = std::max(cost1, eval(precondition_first, precondition_last, atom2));
+
+                    if (is_dead_end(cost2))
+                    {
+                        continue;
+                    }
+
+                    for (auto add = add_first; add != add_last; ++add)
+                    {
+                        if (*add != atom2)
+                        {
+                            update(*add, atom2, cost2 + cost, changed);
+                        }
+                    }
+                }
+            }
+        } while (changed);
     }
 
-    double H2Heuristic::eval(const std::vector<int32_t>& ranks, int32_t rank) const
+    void H2Heuristic::prune_mutex_pairs()
     {
-        double v = 0;
+        // Compute h^2 of the initial state with the full table, every pair with an infinite cost is a mutex
 
-        v = std::max(v, h1_table_[rank]);
+        std::vector<uint32_t> initial_atoms;
 
-        if (is_dead_end(v))
+        for (const auto& atom : problem_->initial)
         {
-            return DEAD_END;
-        }
+            const auto rank = problem_->get_rank(atom);
 
-        for (std::size_t i = 0; i < ranks.size(); i++)
-        {
-            if (rank == ranks[i])
+            if ((rank >= num_static_ranks_) && (rank - num_static_ranks_ < num_atoms_))
             {
-                continue;
+                initial_atoms.emplace_back(rank - num_static_ranks_);
             }
+        }
+
+        fill_table(initial_atoms);
 
-            v = std::max(v, h2_table_[rank][ranks[i]]);
+        constexpr std::size_t bits_per_word = sizeof(std::size_t) * 8;
+        pair_words_.assign((table_.size() + bits_per_word - 1) / bits_per_word, 0);
+        pair_word_ranks_.assign(pair_words_.size(), 0);
 
-            if (is_dead_end(v))
+        for (std::size_t index = 0; index < table_.size(); ++index)
+        {
+            if (!is_dead_end(table_[index]))
             {
-                return DEAD_END;
+                pair_words_[index / bits_per_word] |= static_cast<std::size_t>(1) << (index % bits_per_word);
             }
         }
 
-        return v;
+        std::size_t num_pairs = 0;
+
+        for (std::size_t word_index = 0; word_index < pair_words_.size(); ++word_index)
+        {
+            pair_word_ranks_[word_index] = num_pairs;
+            num_pairs += mimir::formalism::kernels::popcount_word(pair_words_[word_index]);
+        }
+
+        is_pruned_ = true;
+        std::vector<float>(num_pairs).swap(table_);
     }
 
-    void H2Heuristic::update(int32_t rank, double value, bool& changed) const
+    double H2Heuristic::evaluate(const mimir::formalism::State& state) const
     {
-        if (h1_table_[rank] > value)
+        if (state->get_problem() != problem_)
         {
-            h1_table_[rank] = value;
-            changed = true;
+            throw std::invalid_argument("heuristic is constructed for a different problem");
         }
+
+        // Ranks that did not exist when the heuristic was constructed cannot be reached by its actions
+
+        state_atoms_.clear();
+
+        for (const auto rank : state->get_ranks())
+        {
+            if ((rank >= num_static_ranks_) && (rank - num_static_ranks_ < num_atoms_))
+            {
+                state_atoms_.emplace_back(rank - num_static_ranks_);
+            }
+        }
+
+        fill_table(state_atoms_);
+        return eval(goal_.data(), goal_.data() + goal_.size());
     }
 
-    void H2Heuristic::update(int32_t rank1, int32_t rank2, double value, bool& changed) const
+    void H2Heuristic::eval_batch(const uint32_t* first, const uint32_t* last, float* out_values) const
     {
-        if (h2_table_[rank1][rank2] > value)
+        cost_kernels::fill(out_values, 0.0f);
+
+        for (auto atom1 = first; atom1 != last; ++atom1)
         {
-            h2_table_[rank1][rank2] = value;
-            h2_table_[rank2][rank1] = value;
-            changed = true;
+            for (auto atom2 = atom1; atom2 != last; ++atom2)
+            {
+                const auto index = get_index(*atom1, *atom2);
+
+                if (index == no_pair)
+                {
+                    cost_kernels::fill(out_values, cost_kernels::infinity);
+                    return;
+                }
+
+                cost_kernels::max_into(out_values, batch_table_.data() + index * cost_kernels::num_lanes);
+            }
         }
     }
 
-    void H2Heuristic::fill_tables(const mimir::formalism::State& state) const
+    void H2Heuristic::eval_batch(const uint32_t* first, const uint32_t* last, uint32_t atom, float* out_values) const
     {
-        const auto num_atoms = h1_table_.size();
+        const auto atom_index = get_index(atom, atom);
 
-        for (std::size_t i = 0; i < num_atoms; ++i)
+        if (atom_index == no_pair)
         {
-            h1_table_[i] = DEAD_END;
+            cost_kernels::fill(out_values, cost_kernels::infinity);
+            return;
+        }
+
+        std::copy_n(batch_table_.data() + atom_index * cost_kernels::num_lanes, cost_kernels::num_lanes, out_values);
+
+        for (auto other = first; other != last; ++other)
+        {
+            const auto index = get_index(atom, *other);
 
-            for (std::size_t j = 0; j < num_atoms; ++j)
+            if (index == no_pair)
             {
-                h2_table_[i][j] = DEAD_END;
+                cost_kernels::fill(out_values, cost_kernels::infinity);
+                return;
             }
+
+            cost_kernels::max_into(out_values, batch_table_.data() + index * cost_kernels::num_lanes);
         }
+    }
 
-        const auto& state_atoms = state->get_atoms();
-        std::vector<int32_t> state_ids;
+    void H2Heuristic::update_batch(uint32_t atom1, uint32_t atom2, const float* values, bool& changed) const
+    {
+        const auto index = get_index(atom1, atom2);
 
-        for (const auto& atom : state_atoms)
+        if (index != no_pair)
         {
-            state_ids.emplace_back(problem_->get_rank(atom));
+            changed |= cost_kernels::min_into(batch_table_.data() + index * cost_kernels::num_lanes, values);
         }
+    }
+
+    void H2Heuristic::fill_batch_table(const mimir::formalism::StateList& states, std::size_t first, std::size_t num_states) const
+    {
+        constexpr auto num_lanes = cost_kernels::num_lanes;
+        batch_table_.assign(table_.size() * num_lanes, cost_kernels::infinity);
 
-        for (std::size_t i = 0; i < state_ids.size(); ++i)
+        // Lanes without a state keep infinite costs for all pairs
+
+        for (std::size_t lane = 0; lane < num_states; ++lane)
         {
-            h1_table_[state_ids[i]] = 0;
+            state_atoms_.clear();
 
-            for (std::size_t j = 0; j < state_ids.size(); ++j)
+            for (const auto rank : states[first + lane]->get_ranks())
             {
-                h2_table_[state_ids[i]][state_ids[j]] = 0;
+                if ((rank >= num_static_ranks_) && (rank - num_static_ranks_ < num_atoms_))
+                {
+                    state_atoms_.emplace_back(rank - num_static_ranks_);
+                }
+            }
+
+            for (std::size_t i = 0; i < state_atoms_.size(); ++i)
+            {
+                for (std::size_t j = i; j < state_atoms_.size(); ++j)
+                {
+                    const auto index = get_index(state_atoms_[i], state_atoms_[j]);
+
+                    if (index != no_pair)
+                    {
+                        batch_table_[index * num_lanes + lane] = 0.0f;
+                    }
+                }
             }
         }
 
+        // The same pass over the actions as for a single state, with the costs of all lanes updated together
+
+        const auto num_actions = action_costs_.size();
+        float cost1[num_lanes];
+        float cost2[num_lanes];
+        float values[num_lanes];
         bool changed;
 
         do
         {
             changed = false;
 
-            for (std::size_t action_index = 0; action_index < actions_.size(); ++action_index)
+            for (std::size_t action_index = 0; action_index < num_actions; ++action_index)
             {
-                const auto& [precondition, add_effect, delete_effect_complement, cost] = actions_[action_index];
-                const auto cost1 = eval(precondition);
-
-                if (is_dead_end(cost1))
+                const auto precondition_first = preconditions_.data() + precondition_begin_[action_index];
+                const auto precondition_last = preconditions_.data() + precondition_begin_[action_index + 1];
+                const auto add_first = add_effects_.data() + add_effect_begin_[action_index];
+                const auto add_last = add_effects_.data() + add_effect_begin_[action_index + 1];
+                const auto delete_first = delete_effects_.data() + delete_effect_begin_[action_index];
+                const auto delete_last = delete_effects_.data() + delete_effect_begin_[action_index + 1];
+                const auto cost = action_costs_[action_index];
+                eval_batch(precondition_first, precondition_last, cost1);
+
+                if (cost_kernels::all_infinite(cost1))
                 {
                     continue;
                 }
 
-                for (std::size_t i = 0; i < add_effect.size(); i++)
+                cost_kernels::add_scalar(cost1, cost, values);
+
+                for (auto add = add_first; add != add_last; ++add)
                 {
-                    const auto rank1 = add_effect[i];
-                    update(rank1, cost1 + cost, changed);
+                    for (auto other_add = add; other_add != add_last; ++other_add)
+                    {
+                        update_batch(*add, *other_add, values, changed);
+                    }
+                }
+
+                auto delete_effect = delete_first;
 
-                    for (std::size_t j = i + 1; j < add_effect.size(); j++)
+                for (uint32_t atom2 = 0; atom2 < num_atoms_; ++atom2)
+                {
+                    while ((delete_effect != delete_last) && (*delete_effect < atom2))
                     {
-                        const auto rank2 = add_effect[j];
+                        ++delete_effect;
+                    }
 
-                        if (rank1 != rank2)
-                        {
-                            update(rank1, rank2, cost1 + cost, changed);
-                        }
+                    if ((delete_effect != delete_last) && (*delete_effect == atom2))
+                    {
+                        continue;
                     }
 
-                    for (const auto rank2 : delete_effect_complement)
+                    eval_batch(precondition_first, precondition_last, atom2, cost2);
+                    cost_kernels::max_into(cost2, cost1);
+
+                    if (cost_kernels::all_infinite(cost2))
                     {
-                        const auto cost2 = std::max(cost1, eval(precondition, rank2));
+                        continue;
+                    }
+
+                    cost_kernels::add_scalar(cost2, cost, values);
 
-                        if (!is_dead_end(cost2))
+                    for (auto add = add_first; add != add_last; ++add)
+                    {
+                        if (*add != atom2)
                         {
-                            update(rank1, rank2, cost2 + cost, changed);
+                            update_batch(*add, atom2, values, changed);
                         }
                     }
                 }
@@ -274,20 +546,58 @@ namespace mimir::planners
         } while (changed);
     }
 
-    double H2Heuristic::evaluate(const mimir::formalism::State& state) const
+    std::vector<double> H2Heuristic::evaluate(const mimir::formalism::StateList& states) const
     {
-        if (state->get_problem() != problem_)
+        constexpr auto num_lanes = cost_kernels::num_lanes;
+        std::vector<double> values;
+        values.reserve(states.size());
+
+        for (const auto& state : states)
         {
-            throw std::invalid_argument("heuristic is constructed for a different problem");
+            if (state->get_problem() != problem_)
+            {
+                throw std::invalid_argument("heuristic is constructed for a different problem");
+            }
+        }
+
+        float goal_costs[num_lanes];
+
+        for (std::size_t first = 0; first < states.size(); first += num_lanes)
+        {
+            const auto num_states = std::min(num_lanes, states.size() - first);
+
+            if (num_states == 1)
+            {
+                values.emplace_back(evaluate(states[first]));
+                continue;
+            }
+
+            fill_batch_table(states, first, num_states);
+            eval_batch(goal_.data(), goal_.data() + goal_.size(), goal_costs);
+            values.insert(values.end(), goal_costs, goal_costs + num_states);
         }
 
-        fill_tables(state);
-        return eval(goal_);
+        // The batch table is eight times the size of the table, so it is only kept while a batch is evaluated
+
+        std::vector<float>().swap(batch_table_);
+        return values;
+    }
+
+    std::size_t H2Heuristic::get_table_size() const { return table_.size(); }
+
+    std::size_t H2Heuristic::get_memory_usage() const
+    {
+        const auto bytes = [](const auto& vector) { return vector.capacity() * sizeof(typename std::decay_t<decltype(vector)>::value_type); };
+
+        return bytes(precondition_begin_) + bytes(preconditions_) + bytes(add_effect_begin_) + bytes(add_effects_) + bytes(delete_effect_begin_)
+               + bytes(delete_effects_) + bytes(action_costs_) + bytes(goal_) + bytes(pair_words_) + bytes(pair_word_ranks_) + bytes(table_)
+               + bytes(state_atoms_) + bytes(batch_table_);
     }
 
     std::shared_ptr<H2Heuristic> create_h2_heuristic(const mimir::formalism::ProblemDescription& problem,
-                                                     const mimir::planners::SuccessorGenerator& successor_generator)
+                                                     const mimir::planners::SuccessorGenerator& successor_generator,
+                                                     bool prune_mutex_pairs)
     {
-        return std::make_shared<H2Heuristic>(problem, successor_generator);
+        return std::make_shared<H2Heuristic>(problem, successor_generator, prune_mutex_pairs);
     }
 }  // namespace planners
@@ -0,0 +1,300 @@
+/*
+ * Copyright (C) 2023 Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "../../../include/mimir/generators/grounded_successor_generator.hpp"
+#include "../../../include/mimir/search/heuristics/pdb_base.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <unordered_set>
+
+namespace mimir::planners
+{
+    namespace
+    {
+        // The projection of an action onto a pattern: the abstract successor of s is (s & ~delete_effect) | add_effect
+
+        struct AbstractOperator
+        {
+            std::size_t positive_precondition;
+            std::size_t negative_precondition;
+            std::size_t add_effect;
+            std::size_t delete_effect;
+            double cost;
+        };
+
+        constexpr std::size_t max_pattern_size = 32;
+        constexpr std::size_t max_conditional_effects = 16;
+    }  // namespace
+
+    PDBBase::PDBBase(const mimir::formalism::ProblemDescription& problem, const mimir::planners::SuccessorGenerator& successor_generator) :
+        problem_(problem),
+        successor_generator_(successor_generator),
+        relevant_actions_(problem->num_ranks())
+    {
+        const auto grounded_successor_generator = std::dynamic_pointer_cast<mimir::planners::GroundedSuccessorGenerator>(successor_generator);
+
+        if (!grounded_successor_generator)
+        {
+            throw std::invalid_argument("successor generator must be grounded");
+        }
+
+        std::vector<uint32_t> affected_ranks;
+
+        for (const auto& action : grounded_successor_generator->get_actions())
+        {
+            affected_ranks.clear();
+
+            for (const auto& literal : action->get_unconditional_effect())
+            {
+                affected_ranks.emplace_back(problem->get_rank(literal->atom));
+            }
+
+            for (const auto& [antecedent, consequence] : action->get_conditional_effect())
+            {
+                for (const auto& literal : consequence)
+                {
+                    affected_ranks.emplace_back(problem->get_rank(literal->atom));
+                }
+            }
+
+            std::sort(affected_ranks.begin(), affected_ranks.end());
+            affected_ranks.erase(std::unique(affected_ranks.begin(), affected_ranks.end()), affected_ranks.end());
+
+            for (const auto rank : affected_ranks)
+            {
+                relevant_actions_[rank].emplace_back(action);
+            }
+        }
+    }
+
+    std::vector<double> PDBBase::compute_table(const std::vector<int32_t>& pattern) const
+    {
+        if (pattern.size() >= max_pattern_size)
+        {
+            throw std::invalid_argument("pattern is too large");
+        }
+
+        const auto num_abstract_states = static_cast<std::size_t>(1) << pattern.size();
+        const auto all_atoms = num_abstract_states - 1;
+        std::vector<int32_t> rank_to_position(problem_->num_ranks(), -1);
+
+        for (std::size_t position = 0; position < pattern.size(); ++position)
+        {
+            rank_to_position.at(pattern[position]) = static_cast<int32_t>(position);
+        }
+
+        const auto add_literals = [this, &rank_to_position](const mimir::formalism::LiteralList& literals, std::size_t& positive, std::size_t& negative)
+        {
+            for (const auto& literal : literals)
+            {
+                const auto position = rank_to_position[problem_->get_rank(literal->atom)];
+
+                if (position >= 0)
+                {
+                    (literal->negated ? negative : positive) |= static_cast<std::size_t>(1) << position;
+                }
+            }
+        };
+
+        // Project the actions that affect the pattern, every action yields one operator per subset of its conditional effects that affect the pattern
+
+        std::unordered_set<const mimir::formalism::ActionImpl*> visited_actions;
+        std::vector<AbstractOperator> operators;
+
+        for (const auto rank : pattern)
+        {
+            for (const auto& action : relevant_actions_[rank])
+            {
+                if (!visited_actions.insert(action.get()).second)
+                {
+                    continue;
+                }
+
+                AbstractOperator unconditional_operator { 0, 0, 0, 0, action->cost };
+                add_literals(action->get_precondition(), unconditional_operator.positive_precondition, unconditional_operator.negative_precondition);
+                add_literals(action->get_unconditional_effect(), unconditional_operator.add_effect, unconditional_operator.delete_effect);
+
+                std::vector<AbstractOperator> conditional_effects;
+
+                for (const auto& [antecedent, consequence] : action->get_conditional_effect())
+                {
+                    AbstractOperator conditional_effect { 0, 0, 0, 0, 0.0 };
+                    add_literals(consequence, conditional_effect.add_effect, conditional_effect.delete_effect);
+
+                    if ((conditional_effect.add_effect | conditional_effect.delete_effect) != 0)
+                    {
+                        add_literals(antecedent, conditional_effect.positive_precondition, conditional_effect.negative_precondition);
+                        conditional_effects.emplace_back(conditional_effect);
+                    }
+                }
+
+                if (conditional_effects.size() > max_conditional_effects)
+                {
+                    throw std::invalid_argument("action has too many conditional effects that affect the pattern");
+                }
+
+                for (std::size_t subset = 0; subset < (static_cast<std::size_t>(1) << conditional_effects.size()); ++subset)
+                {
+                    auto abstract_operator = unconditional_operator;
+
+                    for (std::size_t index = 0; index < conditional_effects.size(); ++index)
+                    {
+                        if ((subset >> index) & 1)
+                        {
+                            abstract_operator.positive_precondition |= conditional_effects[index].positive_precondition;
+                            abstract_operator.negative_precondition |= conditional_effects[index].negative_precondition;
+                            abstract_operator.add_effect |= conditional_effects[index].add_effect;
+                            abstract_operator.delete_effect |= conditional_effects[index].delete_effect;
+                        }
+                    }
+
+                    // Atoms that are both deleted and added end up true
+
+                    abstract_operator.delete_effect &= ~abstract_operator.add_effect;
+
+                    if (((abstract_operator.positive_precondition & abstract_operator.negative_precondition) == 0)
+                        && ((abstract_operator.add_effect | abstract_operator.delete_effect) != 0))
+                    {
+                        operators.emplace_back(abstract_operator);
+                    }
+                }
+            }
+        }
+
+        // Every abstract state that satisfies the projected goal has distance zero
+
+        std::vector<double> distances(num_abstract_states, DEAD_END);
+        std::priority_queue<std::pair<double, std::size_t>, std::vector<std::pair<double, std::size_t>>, std::greater<std::pair<double, std::size_t>>>
+            queue;
+        std::size_t positive_goal = 0;
+        std::size_t negative_goal = 0;
+        add_literals(problem_->goal, positive_goal, negative_goal);
+
+        const auto for_each_subset = [](std::size_t base, std::size_t free_atoms, const auto& function)
+        {
+            auto subset = static_cast<std::size_t>(0);
+
+            do
+            {
+                function(base | subset);
+                subset = (subset - free_atoms) & free_atoms;
+            } while (subset != 0);
+        };
+
+        if ((positive_goal & negative_goal) == 0)
+        {
+            for_each_subset(positive_goal,
+                            all_atoms & ~(positive_goal | negative_goal),
+                            [&distances, &queue](std::size_t index)
+                            {
+                                distances[index] = 0.0;
+                                queue.emplace(0.0, index);
+                            });
+        }
+
+        // Regress through the operators: a predecessor agrees with the successor on the unaffected atoms, satisfies the precondition, and takes any
+        // value on the affected atoms that the precondition leaves open
+
+        while (!queue.empty())
+        {
+            const auto [distance, index] = queue.top();
+            queue.pop();
+
+            if (distance > distances[index])
+            {
+                continue;
+            }
+
+            for (const auto& abstract_operator : operators)
+            {
+                const auto affected_atoms = abstract_operator.add_effect | abstract_operator.delete_effect;
+
+                if (((index & abstract_operator.add_effect) != abstract_operator.add_effect) || ((index & abstract_operator.delete_effect) != 0)
+                    || ((index & abstract_operator.positive_precondition & ~affected_atoms) != (abstract_operator.positive_precondition & ~affected_atoms))
+                    || ((index & abstract_operator.negative_precondition & ~affected_atoms) != 0))
+                {
+                    continue;
+                }
+
+                const auto predecessor_distance = distance + abstract_operator.cost;
+
+                for_each_subset((index & ~affected_atoms) | (abstract_operator.positive_precondition & affected_atoms),
+                                affected_atoms & ~(abstract_operator.positive_precondition | abstract_operator.negative_precondition),
+                                [&distances, &queue, predecessor_distance](std::size_t predecessor_index)
+                                {
+                                    if (predecessor_distance < distances[predecessor_index])
+                                    {
+                                        distances[predecessor_index] = predecessor_distance;
+                                        queue.emplace(predecessor_distance, predecessor_index);
+                                    }
+                                });
+            }
+        }
+
+        return distances;
+    }
+
+    std::size_t PDBBase::get_index(const mimir::formalism::State& state, const std::vector<int32_t>& pattern) const
+    {
+        std::size_t index = 0;
+
+        for (std::size_t position = 0; position < pattern.size(); ++position)
+        {
+            if (mimir::formalism::is_in_state(static_cast<uint32_t>(pattern[position]), state))
+            {
+                index |= static_cast<std::size_t>(1) << position;
+            }
+        }
+
+        return index;
+    }
+
+    bool PDBBase::are_additive(const std::vector<int32_t>& first_pattern, const std::vector<int32_t>& second_pattern) const
+    {
+        std::unordered_set<const mimir::formalism::ActionImpl*> first_actions;
+
+        for (const auto rank : first_pattern)
+        {
+            for (const auto& action : relevant_actions_[rank])
+            {
+                first_actions.insert(action.get());
+            }
+        }
+
+        for (const auto rank : second_pattern)
+        {
+            for (const auto& action : relevant_actions_[rank])
+            {
+                if (first_actions.count(action.get()) > 0)
+                {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    const mimir::formalism::ActionList& PDBBase::get_relevant_actions(uint32_t rank) const { return relevant_actions_.at(rank); }
+
+    const mimir::formalism::ProblemDescription& PDBBase::get_problem() const { return problem_; }
+
+    const mimir::planners::SuccessorGenerator& PDBBase::get_successor_generator() const { return successor_generator_; }
+}  // namespace planners
@@ -0,0 +1,356 @@
+/*
+ * Copyright (C) 2023 Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "../../../include/mimir/algorithms/murmurhash3.hpp"
+#include "../../../include/mimir/search/heuristics/pdb_builder.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+#include <utility>
+
+namespace mimir::planners
+{
+    namespace
+    {
+        constexpr uint32_t table_magic = 0x4244504d;  // "MPDB"
+
+        template<typename T>
+        void write_value(std::ostream& stream, const T& value)
+        {
+            stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        template<typename T>
+        bool read_value(std::istream& stream, T& out_value)
+        {
+            return static_cast<bool>(stream.read(reinterpret_cast<char*>(&out_value), sizeof(T)));
+        }
+
+        std::string get_hash(const std::string& text)
+        {
+            uint64_t hash[2];
+            MurmurHash3_x64_128(text.data(), static_cast<int>(text.size()), 0, hash);
+            std::ostringstream stream;
+            stream << std::hex << std::setfill('0') << std::setw(16) << hash[0] << std::setw(16) << hash[1];
+            return stream.str();
+        }
+
+        // Atom ranks depend on the order in which atoms were created, so patterns are identified by their atoms
+
+        std::string get_pattern_key(const mimir::formalism::ProblemDescription& problem, const std::vector<int32_t>& pattern)
+        {
+            std::ostringstream stream;
+
+            for (const auto rank : pattern)
+            {
+                stream << problem->get_atom(static_cast<uint32_t>(rank)) << ";";
+            }
+
+            return stream.str();
+        }
+    }  // namespace
+
+    DistanceTable::DistanceTable() : distances_() {}
+
+    DistanceTable::DistanceTable(const std::vector<double>& distances) : distances_()
+    {
+        double max_distance = 0.0;
+        bool is_integral = true;
+
+        for (const auto distance : distances)
+        {
+            if (!HeuristicBase::is_dead_end(distance))
+            {
+                max_distance = std::max(max_distance, distance);
+                is_integral &= (distance >= 0.0) && (distance == std::floor(distance));
+            }
+        }
+
+        const auto narrow = [&distances](auto max_value)
+        {
+            using ValueType = decltype(max_value);
+            std::vector<ValueType> table(distances.size());
+
+            for (std::size_t index = 0; index < distances.size(); ++index)
+            {
+                table[index] = HeuristicBase::is_dead_end(distances[index]) ? max_value : static_cast<ValueType>(distances[index]);
+            }
+
+            return table;
+        };
+
+        if (is_integral && (max_distance < std::numeric_limits<uint8_t>::max()))
+        {
+            distances_ = narrow(std::numeric_limits<uint8_t>::max());
+        }
+        else if (is_integral && (max_distance < std::numeric_limits<uint16_t>::max()))
+        {
+            distances_ = narrow(std::numeric_limits<uint16_t>::max());
+        }
+        else
+        {
+            distances_ = distances;
+        }
+    }
+
+    double DistanceTable::get(std::size_t index) const
+    {
+        if (const auto narrow_table = std::get_if<std::vector<uint8_t>>(&distances_))
+        {
+            const auto distance = (*narrow_table)[index];
+            return (distance == std::numeric_limits<uint8_t>::max()) ? HeuristicBase::DEAD_END : distance;
+        }
+
+        if (const auto wide_table = std::get_if<std::vector<uint16_t>>(&distances_))
+        {
+            const auto distance = (*wide_table)[index];
+            return (distance == std::numeric_limits<uint16_t>::max()) ? HeuristicBase::DEAD_END : distance;
+        }
+
+        return std::get<std::vector<double>>(distances_)[index];
+    }
+
+    std::size_t DistanceTable::size() const
+    {
+        return std::visit([](const auto& distances) { return distances.size(); }, distances_);
+    }
+
+    std::size_t DistanceTable::get_memory_usage() const
+    {
+        return std::visit([](const auto& distances) { return distances.capacity() * sizeof(typename std::decay_t<decltype(distances)>::value_type); },
+                          distances_);
+    }
+
+    void DistanceTable::write(std::ostream& stream) const
+    {
+        write_value(stream, table_magic);
+        write_value(stream, static_cast<uint8_t>(distances_.index()));
+        std::visit(
+            [&stream](const auto& distances)
+            {
+                write_value(stream, static_cast<uint64_t>(distances.size()));
+                stream.write(reinterpret_cast<const char*>(distances.data()), distances.size() * sizeof(distances.front()));
+            },
+            distances_);
+    }
+
+    bool DistanceTable::read(std::istream& stream)
+    {
+        uint32_t magic;
+        uint8_t type;
+        uint64_t size;
+
+        if (!read_value(stream, magic) || (magic != table_magic) || !read_value(stream, type) || !read_value(stream, size))
+        {
+            return false;
+        }
+
+        const auto read_distances = [&stream, size](auto&& distances)
+        {
+            distances.resize(size);
+            return static_cast<bool>(stream.read(reinterpret_cast<char*>(distances.data()), size * sizeof(distances.front())));
+        };
+
+        switch (type)
+        {
+            case 0:
+                distances_ = std::vector<uint8_t>();
+                return read_distances(std::get<0>(distances_));
+            case 1:
+                distances_ = std::vector<uint16_t>();
+                return read_distances(std::get<1>(distances_));
+            case 2:
+                distances_ = std::vector<double>();
+                return read_distances(std::get<2>(distances_));
+            default:
+                return false;
+        }
+    }
+
+    PDBBuilder::PDBBuilder(std::size_t num_threads, std::size_t memory_budget, const std::string& cache_directory) :
+        thread_pool_(std::make_unique<mimir::algorithms::ThreadPool>(num_threads)),
+        memory_budget_(memory_budget),
+        cache_directory_(cache_directory),
+        event_handlers_(),
+        memory_usage_(0),
+        num_scheduled_(0),
+        num_built_(0),
+        num_loaded_(0),
+        num_rejected_(0)
+    {
+    }
+
+    std::string PDBBuilder::get_cache_path(const std::string& problem_hash, const std::string& pattern_key) const
+    {
+        return cache_directory_ + "/pdb_" + problem_hash + "_" + get_hash(pattern_key) + ".bin";
+    }
+
+    void PDBBuilder::notify_handlers() const
+    {
+        for (const auto& handler : event_handlers_)
+        {
+            handler();
+        }
+    }
+
+    void PDBBuilder::register_handler(const std::function<void()>& handler) { event_handlers_.emplace_back(handler); }
+
+    std::vector<std::optional<DistanceTable>> PDBBuilder::build(const PDBBase& pdb, const std::vector<std::vector<int32_t>>& patterns)
+    {
+        std::vector<std::optional<DistanceTable>> tables(patterns.size());
+        std::vector<std::size_t> reserved_bytes(patterns.size(), 0);
+        std::vector<bool> is_loaded(patterns.size(), false);
+        const auto batch_size = thread_pool_->num_threads();
+        std::string problem_hash;
+
+        if (!cache_directory_.empty())
+        {
+            std::ostringstream problem_text;
+            problem_text << pdb.get_problem()->domain << pdb.get_problem();
+            problem_hash = get_hash(problem_text.str());
+        }
+
+        for (std::size_t first = 0; first < patterns.size(); first += batch_size)
+        {
+            const auto last = std::min(first + batch_size, patterns.size());
+
+            // Reserve the working set of the search before it starts, in the order of the patterns, so that rejections do not depend on the scheduling.
+            // The search holds a distance and about one queue entry per abstract state, and the distances are still alive while they are narrowed.
+
+            for (auto index = first; index < last; ++index)
+            {
+                const auto num_abstract_states = (patterns[index].size() < 32) ? (static_cast<std::size_t>(1) << patterns[index].size()) : 0;
+                const auto num_bytes_per_state = sizeof(double) + sizeof(std::pair<double, std::size_t>);
+
+                if ((num_abstract_states == 0)
+                    || (num_abstract_states > (memory_budget_ - std::min(memory_budget_, memory_usage_)) / num_bytes_per_state))
+                {
+                    ++num_rejected_;
+                    continue;
+                }
+
+                reserved_bytes[index] = num_abstract_states * num_bytes_per_state;
+                memory_usage_ += reserved_bytes[index];
+            }
+
+            num_scheduled_ += static_cast<int32_t>(last - first);
+
+            thread_pool_->run(last - first,
+                              [&](std::size_t offset)
+                              {
+                                  const auto index = first + offset;
+
+                                  if (reserved_bytes[index] == 0)
+                                  {
+                                      return;
+                                  }
+
+                                  std::string path;
+                                  std::string pattern_key;
+
+                                  if (!cache_directory_.empty())
+                                  {
+                                      pattern_key = get_pattern_key(pdb.get_problem(), patterns[index]);
+                                      path = get_cache_path(problem_hash, pattern_key);
+                                      std::ifstream stream(path, std::ios::binary);
+                                      uint64_t key_size;
+
+                                      if (stream && read_value(stream, key_size) && (key_size == pattern_key.size()))
+                                      {
+                                          std::string stored_key(key_size, '\0');
+                                          DistanceTable table;
+
+                                          if (stream.read(stored_key.data(), key_size) && (stored_key == pattern_key) && table.read(stream))
+                                          {
+                                              tables[index] = std::move(table);
+                                              is_loaded[index] = true;
+                                              return;
+                                          }
+                                      }
+                                  }
+
+                                  tables[index] = DistanceTable(pdb.compute_table(patterns[index]));
+
+                                  if (!cache_directory_.empty())
+                                  {
+                                      // Write to a file of this thread first, so that concurrent runs never read a partial table
+
+                                      std::ostringstream thread_id;
+                                      thread_id << std::this_thread::get_id();
+                                      const auto temporary_path = path + "." + thread_id.str() + ".tmp";
+
+                                      {
+                                          std::ofstream stream(temporary_path, std::ios::binary);
+                                          write_value(stream, static_cast<uint64_t>(pattern_key.size()));
+                                          stream.write(pattern_key.data(), pattern_key.size());
+                                          tables[index]->write(stream);
+                                      }
+
+                                      if (std::rename(temporary_path.c_str(), path.c_str()) != 0)
+                                      {
+                                          std::remove(temporary_path.c_str());
+                                      }
+                                  }
+                              });
+
+            // Release the working sets and charge the actual sizes of the tables
+
+            for (auto index = first; index < last; ++index)
+            {
+                if (reserved_bytes[index] == 0)
+                {
+                    continue;
+                }
+
+                memory_usage_ -= reserved_bytes[index];
+                const auto num_bytes = tables[index]->get_memory_usage();
+
+                if (num_bytes > memory_budget_ - std::min(memory_budget_, memory_usage_))
+                {
+                    tables[index].reset();
+                    ++num_rejected_;
+                    continue;
+                }
+
+                memory_usage_ += num_bytes;
+                ++(is_loaded[index] ? num_loaded_ : num_built_);
+            }
+
+            notify_handlers();
+        }
+
+        return tables;
+    }
+
+    void PDBBuilder::release(const DistanceTable& table) { memory_usage_ -= std::min(memory_usage_, table.get_memory_usage()); }
+
+    std::size_t PDBBuilder::num_threads() const { return thread_pool_->num_threads(); }
+
+    std::map<std::string, std::variant<int32_t, double>> PDBBuilder::get_statistics() const
+    {
+        return { { "scheduled", num_scheduled_ },
+                 { "built", num_built_ },
+                 { "loaded", num_loaded_ },
+                 { "rejected", num_rejected_ },
+                 { "memory", static_cast<double>(memory_usage_) } };
+    }
+}  // namespace planners
@@ -0,0 +1,559 @@
+/*
+ * Copyright (C) 2023 Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "../../../include/mimir/search/heuristics/pdb_heuristic.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <map>
+#include <random>
+#include <set>
+#include <stdexcept>
+
+namespace mimir::planners
+{
+    namespace
+    {
+        // Bron-Kerbosch with pivoting, the collections are small so the sets are plain sorted vectors
+
+        void enumerate_maximal_cliques(const std::vector<std::vector<bool>>& is_adjacent,
+                                       std::vector<std::size_t>& clique,
+                                       std::vector<std::size_t> candidates,
+                                       std::vector<std::size_t> excluded,
+                                       std::vector<std::vector<std::size_t>>& out_cliques)
+        {
+            if (candidates.empty() && excluded.empty())
+            {
+                out_cliques.emplace_back(clique);
+                return;
+            }
+
+            const auto pivot = candidates.empty() ? excluded.front() : candidates.front();
+            const auto branches = candidates;
+
+            for (const auto vertex : branches)
+            {
+                if (is_adjacent[pivot][vertex])
+                {
+                    continue;
+                }
+
+                std::vector<std::size_t> next_candidates;
+                std::vector<std::size_t> next_excluded;
+                std::copy_if(candidates.begin(),
+                             candidates.end(),
+                             std::back_inserter(next_candidates),
+                             [&is_adjacent, vertex](std::size_t other) { return is_adjacent[vertex][other]; });
+                std::copy_if(excluded.begin(),
+                             excluded.end(),
+                             std::back_inserter(next_excluded),
+                             [&is_adjacent, vertex](std::size_t other) { return is_adjacent[vertex][other]; });
+
+                clique.emplace_back(vertex);
+                enumerate_maximal_cliques(is_adjacent, clique, std::move(next_candidates), std::move(next_excluded), out_cliques);
+                clique.pop_back();
+
+                candidates.erase(std::find(candidates.begin(), candidates.end(), vertex));
+                excluded.emplace_back(vertex);
+            }
+        }
+    }  // namespace
+
+    PDBHeuristic::PDBHeuristic(const mimir::formalism::ProblemDescription& problem,
+                               const mimir::planners::SuccessorGenerator& successor_generator,
+                               const std::vector<std::vector<int32_t>>& patterns) :
+        PDBBase(problem, successor_generator),
+        patterns_(),
+        tables_(),
+        additive_subsets_(),
+        num_abstract_states_(0)
+    {
+        PDBBuilder builder;
+        auto tables = builder.build(*this, patterns);
+
+        for (std::size_t index = 0; index < patterns.size(); ++index)
+        {
+            // The builder has no memory budget, so it only rejects patterns that have too many abstract states
+
+            if (!tables[index])
+            {
+                throw std::invalid_argument("pattern is too large");
+            }
+
+            add_pattern(patterns[index], std::move(*tables[index]));
+        }
+
+        additive_subsets_ = compute_additive_subsets();
+    }
+
+    PDBHeuristic::PDBHeuristic(const mimir::formalism::ProblemDescription& problem,
+                               const mimir::planners::SuccessorGenerator& successor_generator,
+                               const std::vector<std::vector<int32_t>>& patterns,
+                               PDBBuilder& builder) :
+        PDBBase(problem, successor_generator),
+        patterns_(),
+        tables_(),
+        additive_subsets_(),
+        num_abstract_states_(0)
+    {
+        auto tables = builder.build(*this, patterns);
+
+        for (std::size_t index = 0; index < patterns.size(); ++index)
+        {
+            if (tables[index])
+            {
+                add_pattern(patterns[index], std::move(*tables[index]));
+            }
+        }
+
+        additive_subsets_ = compute_additive_subsets();
+    }
+
+    PDBHeuristic::PDBHeuristic(const mimir::formalism::ProblemDescription& problem,
+                               const mimir::planners::SuccessorGenerator& successor_generator,
+                               std::size_t max_pattern_states,
+                               std::size_t max_collection_states,
+                               std::size_t num_samples) :
+        PDBBase(problem, successor_generator),
+        patterns_(),
+        tables_(),
+        additive_subsets_(),
+        num_abstract_states_(0)
+    {
+        PDBBuilder builder;
+        hill_climb(max_pattern_states, max_collection_states, num_samples, builder);
+    }
+
+    PDBHeuristic::PDBHeuristic(const mimir::formalism::ProblemDescription& problem,
+                               const mimir::planners::SuccessorGenerator& successor_generator,
+                               std::size_t max_pattern_states,
+                               std::size_t max_collection_states,
+                               std::size_t num_samples,
+                               PDBBuilder& builder) :
+        PDBBase(problem, successor_generator),
+        patterns_(),
+        tables_(),
+        additive_subsets_(),
+        num_abstract_states_(0)
+    {
+        hill_climb(max_pattern_states, max_collection_states, num_samples, builder);
+    }
+
+    std::vector<std::vector<std::size_t>> PDBHeuristic::compute_additive_subsets() const
+    {
+        const auto num_patterns = patterns_.size();
+        std::vector<std::vector<bool>> is_adjacent(num_patterns, std::vector<bool>(num_patterns, false));
+
+        for (std::size_t first = 0; first < num_patterns; ++first)
+        {
+            for (std::size_t second = first + 1; second < num_patterns; ++second)
+            {
+                is_adjacent[first][second] = is_adjacent[second][first] = are_additive(patterns_[first], patterns_[second]);
+            }
+        }
+
+        std::vector<std::size_t> candidates(num_patterns);
+
+        for (std::size_t index = 0; index < num_patterns; ++index)
+        {
+            candidates[index] = index;
+        }
+
+        std::vector<std::vector<std::size_t>> cliques;
+        std::vector<std::size_t> clique;
+        enumerate_maximal_cliques(is_adjacent, clique, std::move(candidates), {}, cliques);
+        return cliques;
+    }
+
+    void PDBHeuristic::add_pattern(const std::vector<int32_t>& pattern, DistanceTable&& table)
+    {
+        num_abstract_states_ += static_cast<std::size_t>(1) << pattern.size();
+        patterns_.emplace_back(pattern);
+        tables_.emplace_back(std::move(table));
+    }
+
+    void PDBHeuristic::hill_climb(std::size_t max_pattern_states, std::size_t max_collection_states, std::size_t num_samples, PDBBuilder& builder)
+    {
+        const auto& problem = get_problem();
+        const auto& successor_generator = get_successor_generator();
+
+        const auto fits = [&](std::size_t pattern_size)
+        {
+            const auto num_states = static_cast<std::size_t>(1) << pattern_size;
+            return (pattern_size < 32) && (num_states <= max_pattern_states) && (num_abstract_states_ + num_states <= max_collection_states);
+        };
+
+        // Start with one pattern per dynamic goal atom
+
+        std::vector<std::vector<int32_t>> goal_patterns;
+
+        for (const auto& literal : problem->goal)
+        {
+            const auto rank = static_cast<int32_t>(problem->get_rank(literal->atom));
+            const auto is_known = std::any_of(goal_patterns.begin(), goal_patterns.end(), [rank](const auto& pattern) { return pattern.front() == rank; });
+
+            if (!problem->is_static(rank) && !is_known)
+            {
+                goal_patterns.push_back({ rank });
+            }
+        }
+
+        auto goal_tables = builder.build(*this, goal_patterns);
+
+        for (std::size_t index = 0; index < goal_patterns.size(); ++index)
+        {
+            if (!goal_tables[index])
+            {
+                continue;
+            }
+
+            if (fits(1))
+            {
+                add_pattern(goal_patterns[index], std::move(*goal_tables[index]));
+            }
+            else
+            {
+                builder.release(*goal_tables[index]);
+            }
+        }
+
+        additive_subsets_ = compute_additive_subsets();
+
+        // Sample states by random walks from the initial state, whose length is drawn uniformly up to twice the heuristic value of the initial state
+
+        const auto initial_state = mimir::formalism::create_state(problem->initial, problem);
+        const auto initial_value = evaluate(initial_state);
+
+        if (is_dead_end(initial_value))
+        {
+            return;
+        }
+
+        std::mt19937_64 random(0);
+        std::uniform_int_distribution<std::size_t> length_distribution(0, 2 * static_cast<std::size_t>(std::max(1.0, std::ceil(initial_value))));
+        mimir::formalism::StateList samples;
+
+        for (std::size_t sample_index = 0; sample_index < num_samples; ++sample_index)
+        {
+            auto state = initial_state;
+
+            for (auto length = length_distribution(random); length > 0; --length)
+            {
+                const auto applicable_actions = successor_generator->get_applicable_actions(state);
+
+                if (applicable_actions.empty())
+                {
+                    break;
+                }
+
+                state = mimir::formalism::apply(applicable_actions[std::uniform_int_distribution<std::size_t>(0, applicable_actions.size() - 1)(random)],
+                                                state);
+            }
+
+            samples.emplace_back(state);
+        }
+
+        // The distances of the samples in every pattern, and their heuristic values for the current collection
+
+        std::vector<std::vector<double>> sample_distances;
+        std::vector<double> sample_values;
+
+        const auto add_sample_distances = [&](std::size_t pattern_index)
+        {
+            std::vector<double> distances;
+
+            for (const auto& sample : samples)
+            {
+                distances.emplace_back(tables_[pattern_index].get(get_index(sample, patterns_[pattern_index])));
+            }
+
+            sample_distances.emplace_back(std::move(distances));
+        };
+
+        for (std::size_t pattern_index = 0; pattern_index < patterns_.size(); ++pattern_index)
+        {
+            add_sample_distances(pattern_index);
+        }
+
+        // The tables of the extensions are kept between iterations, keyed by their sorted atoms, and extensions that the builder rejected are not
+        // built again
+
+        std::map<std::vector<int32_t>, std::pair<std::vector<int32_t>, DistanceTable>> candidate_tables;
+        std::set<std::vector<int32_t>> rejected_candidates;
+
+        const auto release_candidate = [&builder, &candidate_tables](auto candidate_table)
+        {
+            builder.release(candidate_table->second.second);
+            return candidate_tables.erase(candidate_table);
+        };
+
+        while (true)
+        {
+            for (auto candidate_table = candidate_tables.begin(); candidate_table != candidate_tables.end();)
+            {
+                candidate_table = fits(candidate_table->second.first.size()) ? std::next(candidate_table) : release_candidate(candidate_table);
+            }
+
+            sample_values.assign(samples.size(), 0.0);
+
+            for (std::size_t sample_index = 0; sample_index < samples.size(); ++sample_index)
+            {
+                for (const auto& subset : additive_subsets_)
+                {
+                    double value = 0.0;
+
+                    for (const auto pattern_index : subset)
+                    {
+                        value += sample_distances[pattern_index][sample_index];
+                    }
+
+                    sample_values[sample_index] = std::max(sample_values[sample_index], value);
+                }
+            }
+
+            // Extend every pattern by an atom of the precondition of an action that affects it
+
+            std::vector<std::vector<int32_t>> new_candidates;
+            std::set<std::vector<int32_t>> new_keys;
+
+            for (const auto& pattern : patterns_)
+            {
+                if (!fits(pattern.size() + 1))
+                {
+                    continue;
+                }
+
+                std::vector<int32_t> relevant_ranks;
+
+                for (const auto rank : pattern)
+                {
+                    for (const auto& action : get_relevant_actions(rank))
+                    {
+                        for (const auto& literal : action->get_precondition())
+                        {
+                            relevant_ranks.emplace_back(static_cast<int32_t>(problem->get_rank(literal->atom)));
+                        }
+
+                        for (const auto& [antecedent, consequence] : action->get_conditional_effect())
+                        {
+                            for (const auto& literal : antecedent)
+                            {
+                                relevant_ranks.emplace_back(static_cast<int32_t>(problem->get_rank(literal->atom)));
+                            }
+                        }
+                    }
+                }
+
+                std::sort(relevant_ranks.begin(), relevant_ranks.end());
+                relevant_ranks.erase(std::unique(relevant_ranks.begin(), relevant_ranks.end()), relevant_ranks.end());
+
+                for (const auto rank : relevant_ranks)
+                {
+                    if (problem->is_static(rank) || (std::find(pattern.begin(), pattern.end(), rank) != pattern.end()))
+                    {
+                        continue;
+                    }
+
+                    auto candidate = pattern;
+                    candidate.emplace_back(rank);
+                    auto key = candidate;
+                    std::sort(key.begin(), key.end());
+
+                    if ((candidate_tables.count(key) == 0) && (rejected_candidates.count(key) == 0) && new_keys.insert(key).second)
+                    {
+                        new_candidates.emplace_back(std::move(candidate));
+                    }
+                }
+            }
+
+            auto new_tables = builder.build(*this, new_candidates);
+
+            for (std::size_t index = 0; index < new_candidates.size(); ++index)
+            {
+                auto key = new_candidates[index];
+                std::sort(key.begin(), key.end());
+
+                if (new_tables[index])
+                {
+                    candidate_tables.emplace(std::move(key), std::make_pair(std::move(new_candidates[index]), std::move(*new_tables[index])));
+                }
+                else
+                {
+                    rejected_candidates.emplace(std::move(key));
+                }
+            }
+
+            // Pick the candidate that increases the heuristic value of the most samples, its distances are added to the sums of the additive
+            // subsets after restricting them to the patterns that are additive with it
+
+            std::size_t best_num_improved = 0;
+            auto best_candidate = candidate_tables.end();
+
+            for (auto candidate_table = candidate_tables.begin(); candidate_table != candidate_tables.end(); ++candidate_table)
+            {
+                const auto& [candidate, table] = candidate_table->second;
+
+                if (!fits(candidate.size()))
+                {
+                    continue;
+                }
+
+                std::vector<bool> is_additive(patterns_.size());
+
+                for (std::size_t pattern_index = 0; pattern_index < patterns_.size(); ++pattern_index)
+                {
+                    is_additive[pattern_index] = are_additive(candidate, patterns_[pattern_index]);
+                }
+
+                std::size_t num_improved = 0;
+
+                for (std::size_t sample_index = 0; sample_index < samples.size(); ++sample_index)
+                {
+                    if (is_dead_end(sample_values[sample_index]))
+                    {
+                        continue;
+                    }
+
+                    const auto distance = table.get(get_index(samples[sample_index], candidate));
+                    auto value = distance;
+
+                    for (const auto& subset : additive_subsets_)
+                    {
+                        double subset_value = distance;
+
+                        for (const auto pattern_index : subset)
+                        {
+                            subset_value += is_additive[pattern_index] ? sample_distances[pattern_index][sample_index] : 0.0;
+                        }
+
+                        value = std::max(value, subset_value);
+                    }
+
+                    num_improved += (value > sample_values[sample_index]) ? 1 : 0;
+                }
+
+                if (num_improved > best_num_improved)
+                {
+                    best_num_improved = num_improved;
+                    best_candidate = candidate_table;
+                }
+            }
+
+            if (best_candidate == candidate_tables.end())
+            {
+                break;
+            }
+
+            // The table of the chosen extension moves into the collection and stays charged to the builder
+
+            add_pattern(best_candidate->second.first, std::move(best_candidate->second.second));
+            candidate_tables.erase(best_candidate);
+            additive_subsets_ = compute_additive_subsets();
+            add_sample_distances(patterns_.size() - 1);
+        }
+
+        for (auto candidate_table = candidate_tables.begin(); candidate_table != candidate_tables.end();)
+        {
+            candidate_table = release_candidate(candidate_table);
+        }
+    }
+
+    double PDBHeuristic::evaluate(const mimir::formalism::State& state) const
+    {
+        if (state->get_problem() != get_problem())
+        {
+            throw std::invalid_argument("heuristic is constructed for a different problem");
+        }
+
+        std::vector<double> distances(patterns_.size());
+
+        for (std::size_t pattern_index = 0; pattern_index < patterns_.size(); ++pattern_index)
+        {
+            distances[pattern_index] = tables_[pattern_index].get(get_index(state, patterns_[pattern_index]));
+
+            if (is_dead_end(distances[pattern_index]))
+            {
+                return DEAD_END;
+            }
+        }
+
+        double value = 0.0;
+
+        for (const auto& subset : additive_subsets_)
+        {
+            double subset_value = 0.0;
+
+            for (const auto pattern_index : subset)
+            {
+                subset_value += distances[pattern_index];
+            }
+
+            value = std::max(value, subset_value);
+        }
+
+        return value;
+    }
+
+    const std::vector<std::vector<int32_t>>& PDBHeuristic::get_patterns() const { return patterns_; }
+
+    std::size_t PDBHeuristic::get_memory_usage() const
+    {
+        std::size_t bytes = 0;
+
+        for (const auto& table : tables_)
+        {
+            bytes += table.get_memory_usage();
+        }
+
+        return bytes;
+    }
+
+    std::shared_ptr<PDBHeuristic> create_pdb_heuristic(const mimir::formalism::ProblemDescription& problem,
+                                                       const mimir::planners::SuccessorGenerator& successor_generator,
+                                                       const std::vector<std::vector<int32_t>>& patterns)
+    {
+        return std::make_shared<PDBHeuristic>(problem, successor_generator, patterns);
+    }
+
+    std::shared_ptr<PDBHeuristic> create_pdb_heuristic(const mimir::formalism::ProblemDescription& problem,
+                                                       const mimir::planners::SuccessorGenerator& successor_generator,
+                                                       const std::vector<std::vector<int32_t>>& patterns,
+                                                       PDBBuilder& builder)
+    {
+        return std::make_shared<PDBHeuristic>(problem, successor_generator, patterns, builder);
+    }
+
+    std::shared_ptr<PDBHeuristic> create_hill_climbing_pdb_heuristic(const mimir::formalism::ProblemDescription& problem,
+                                                                     const mimir::planners::SuccessorGenerator& successor_generator,
+                                                                     std::size_t max_pattern_states,
+                                                                     std::size_t max_collection_states,
+                                                                     std::size_t num_samples)
+    {
+        return std::make_shared<PDBHeuristic>(problem, successor_generator, max_pattern_states, max_collection_states, num_samples);
+    }
+
+    std::shared_ptr<PDBHeuristic> create_hill_climbing_pdb_heuristic(const mimir::formalism::ProblemDescription& problem,
+                                                                     const mimir::planners::SuccessorGenerator& successor_generator,
+                                                                     std::size_t max_pattern_states,
+                                                                     std::size_t max_collection_states,
+                                                                     std::size_t num_samples,
+                                                                     PDBBuilder& builder)
+    {
+        return std::make_shared<PDBHeuristic>(problem, successor_generator, max_pattern_states, max_collection_states, num_samples, builder);
+    }
+}  // namespace planners
@@ -0,0 +1,634 @@
+/*
+ * Copyright (C) 2023 Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "../../../include/mimir/generators/grounded_successor_generator.hpp"
+#include "../../../include/mimir/search/heuristics/cost_kernels.hpp"
+#include "../../../include/mimir/search/heuristics/relaxation_heuristic.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+
+namespace mimir::planners
+{
+    inline std::size_t get_lowest_bit_position(std::size_t word)
+    {
+#if defined(_MSC_VER)
+        unsigned long position;
+        _BitScanForward64(&position, word);
+        return static_cast<std::size_t>(position);
+#else
+        return static_cast<std::size_t>(__builtin_ctzll(word));
+#endif
+    }
+
+    RelaxationHeuristic::RelaxationHeuristic(const mimir::formalism::ProblemDescription& problem,
+                                             const mimir::planners::SuccessorGenerator& successor_generator,
+                                             RelaxationType type) :
+        type_(type),
+        problem_(problem),
+        actions_(),
+        num_static_ranks_(static_cast<uint32_t>(problem->get_static_atoms().size())),
+        num_ranks_(problem->num_ranks()),
+        precondition_begin_(),
+        preconditions_(),
+        effect_begin_(),
+        effects_(),
+        operator_costs_(),
+        operator_actions_(),
+        operators_without_precondition_(),
+        precondition_of_begin_(),
+        precondition_of_(),
+        goal_(),
+        is_goal_(num_ranks_, false),
+        has_integer_costs_(true),
+        costs_(num_ranks_),
+        supporters_(num_ranks_),
+        num_unsatisfied_(),
+        operator_values_(),
+        queue_(),
+        buckets_(),
+        is_marked_rank_(num_ranks_, false),
+        is_marked_action_(),
+        relaxed_plan_(),
+        open_ranks_(),
+        batch_costs_(),
+        rank_sweeps_(num_ranks_),
+        operator_sweeps_()
+    {
+        const auto grounded_successor_generator = std::dynamic_pointer_cast<mimir::planners::GroundedSuccessorGenerator>(successor_generator);
+
+        if (!grounded_successor_generator)
+        {
+            throw std::invalid_argument("successor generator must be grounded");
+        }
+
+        // Static atoms are true in every state, so they are left out of the goal and the preconditions
+
+        for (const auto& literal : problem->goal)
+        {
+            if (literal->negated)
+            {
+                throw std::invalid_argument("negative literals in the goal are not supported");
+            }
+
+            const auto rank = problem->get_rank(literal->atom);
+
+            if ((rank >= num_static_ranks_) && !is_goal_[rank])
+            {
+                is_goal_[rank] = true;
+                goal_.emplace_back(rank);
+            }
+        }
+
+        // Every action yields one operator for its unconditional effects and one for each conditional effect, negative literals are ignored
+
+        const auto& actions = grounded_successor_generator->get_actions();
+        std::vector<uint32_t> precondition;
+        std::vector<uint32_t> effect;
+        actions_ = actions;
+        precondition_begin_.emplace_back(0);
+        effect_begin_.emplace_back(0);
+
+        const auto add_positive_ranks = [this](const mimir::formalism::LiteralList& literals, std::vector<uint32_t>& out_ranks)
+        {
+            for (const auto& literal : literals)
+            {
+                const auto rank = problem_->get_rank(literal->atom);
+
+                if (!literal->negated && (rank >= num_static_ranks_))
+                {
+                    out_ranks.emplace_back(rank);
+                }
+            }
+        };
+
+        const auto add_operator = [this, &precondition, &effect](uint32_t action_index, double cost)
+        {
+            if (effect.empty())
+            {
+                return;
+            }
+
+            std::sort(precondition.begin(), precondition.end());
+            precondition.erase(std::unique(precondition.begin(), precondition.end()), precondition.end());
+
+            if (precondition.empty())
+            {
+                operators_without_precondition_.emplace_back(static_cast<uint32_t>(operator_costs_.size()));
+            }
+
+            preconditions_.insert(preconditions_.end(), precondition.begin(), precondition.end());
+            effects_.insert(effects_.end(), effect.begin(), effect.end());
+            precondition_begin_.emplace_back(static_cast<uint32_t>(preconditions_.size()));
+            effect_begin_.emplace_back(static_cast<uint32_t>(effects_.size()));
+            operator_costs_.emplace_back(cost);
+            operator_actions_.emplace_back(action_index);
+        };
+
+        for (uint32_t action_index = 0; action_index < actions.size(); ++action_index)
+        {
+            const auto& action = actions[action_index];
+
+            precondition.clear();
+            effect.clear();
+            add_positive_ranks(action->get_precondition(), precondition);
+            add_positive_ranks(action->get_unconditional_effect(), effect);
+            add_operator(action_index, action->cost);
+
+            for (const auto& [antecedent, consequence] : action->get_conditional_effect())
+            {
+                precondition.clear();
+                effect.clear();
+                add_positive_ranks(action->get_precondition(), precondition);
+                add_positive_ranks(antecedent, precondition);
+                add_positive_ranks(consequence, effect);
+                add_operator(action_index, action->cost);
+            }
+        }
+
+        // Invert the preconditions, so that settling an atom visits the operators that depend on it
+
+        const auto num_operators = operator_costs_.size();
+        precondition_of_begin_.assign(num_ranks_ + 1, 0);
+
+        for (const auto rank : preconditions_)
+        {
+            ++precondition_of_begin_[rank + 1];
+        }
+
+        for (uint32_t rank = 0; rank < num_ranks_; ++rank)
+        {
+            precondition_of_begin_[rank + 1] += precondition_of_begin_[rank];
+        }
+
+        precondition_of_.resize(preconditions_.size());
+        auto positions = precondition_of_begin_;
+
+        for (uint32_t operator_index = 0; operator_index < num_operators; ++operator_index)
+        {
+            for (auto index = precondition_begin_[operator_index]; index < precondition_begin_[operator_index + 1]; ++index)
+            {
+                precondition_of_[positions[preconditions_[index]]++] = operator_index;
+            }
+        }
+
+        num_unsatisfied_.resize(num_operators);
+        operator_values_.resize(num_operators);
+        operator_sweeps_.resize(num_operators);
+        is_marked_action_.resize(actions.size(), false);
+
+        for (const auto cost : operator_costs_)
+        {
+            has_integer_costs_ &= (cost >= 0.0) && (cost == std::floor(cost));
+        }
+    }
+
+    void RelaxationHeuristic::enqueue(uint32_t rank, double cost, uint32_t supporter) const
+    {
+        if (cost < costs_[rank])
+        {
+            costs_[rank] = cost;
+            supporters_[rank] = supporter;
+
+            if (has_integer_costs_)
+            {
+                const auto bucket = static_cast<std::size_t>(cost);
+
+                if (bucket >= buckets_.size())
+                {
+                    buckets_.resize(bucket + 1);
+                }
+
+                buckets_[bucket].emplace_back(rank);
+            }
+            else
+            {
+                queue_.emplace_back(cost, rank);
+                std::push_heap(queue_.begin(), queue_.end(), std::greater<std::pair<double, uint32_t>>());
+            }
+        }
+    }
+
+    void RelaxationHeuristic::settle(uint32_t rank, double cost) const
+    {
+        for (auto index = precondition_of_begin_[rank]; index < precondition_of_begin_[rank + 1]; ++index)
+        {
+            const auto operator_index = precondition_of_[index];
+            auto& operator_value = operator_values_[operator_index];
+            operator_value = (type_ == RelaxationType::MAX) ? std::max(operator_value, cost) : (operator_value + cost);
+
+            if (--num_unsatisfied_[operator_index] == 0)
+            {
+                const auto effect_cost = operator_value + operator_costs_[operator_index];
+
+                for (auto effect_index = effect_begin_[operator_index]; effect_index < effect_begin_[operator_index + 1]; ++effect_index)
+                {
+                    enqueue(effects_[effect_index], effect_cost, operator_index);
+                }
+            }
+        }
+    }
+
+    bool RelaxationHeuristic::explore(const mimir::formalism::State& state) const
+    {
+        std::fill(costs_.begin(), costs_.end(), DEAD_END);
+        std::fill(supporters_.begin(), supporters_.end(), no_operator);
+        std::fill(operator_values_.begin(), operator_values_.end(), 0.0);
+        queue_.clear();
+
+        for (std::size_t operator_index = 0; operator_index < num_unsatisfied_.size(); ++operator_index)
+        {
+            num_unsatisfied_[operator_index] = precondition_begin_[operator_index + 1] - precondition_begin_[operator_index];
+        }
+
+        // The atoms of the state are read from its bitset, ranks that did not exist when the operators were compiled cannot be reached by them
+
+        const auto& blocks = state->get_blocks();
+        constexpr std::size_t bits_per_block = sizeof(std::size_t) * 8;
+
+        for (std::size_t block_index = 0; block_index < blocks.size(); ++block_index)
+        {
+            auto block = blocks[block_index];
+
+            while (block != 0)
+            {
+                const auto rank = static_cast<uint32_t>(block_index * bits_per_block + get_lowest_bit_position(block));
+                block &= block - 1;
+
+                if ((rank >= num_static_ranks_) && (rank < num_ranks_))
+                {
+                    enqueue(rank, 0.0, no_operator);
+                }
+            }
+        }
+
+        for (const auto operator_index : operators_without_precondition_)
+        {
+            for (auto index = effect_begin_[operator_index]; index < effect_begin_[operator_index + 1]; ++index)
+            {
+                enqueue(effects_[index], operator_costs_[operator_index], operator_index);
+            }
+        }
+
+        auto num_unreached_goals = goal_.size();
+
+        if (has_integer_costs_)
+        {
+            // Settling an atom can add atoms to the current bucket, and resize the buckets, so they are accessed by index
+
+            for (std::size_t bucket = 0; (bucket < buckets_.size()) && (num_unreached_goals > 0); ++bucket)
+            {
+                const auto cost = static_cast<double>(bucket);
+
+                for (std::size_t index = 0; (index < buckets_[bucket].size()) && (num_unreached_goals > 0); ++index)
+                {
+                    const auto rank = buckets_[bucket][index];
+
+                    // The atom was settled with a lower cost before
+
+                    if (cost > costs_[rank])
+                    {
+                        continue;
+                    }
+
+                    if (is_goal_[rank])
+                    {
+                        --num_unreached_goals;
+                    }
+
+                    settle(rank, cost);
+                }
+            }
+
+            for (auto& ranks : buckets_)
+            {
+                ranks.clear();
+            }
+        }
+        else
+        {
+            while (!queue_.empty() && (num_unreached_goals > 0))
+            {
+                std::pop_heap(queue_.begin(), queue_.end(), std::greater<std::pair<double, uint32_t>>());
+                const auto [cost, rank] = queue_.back();
+                queue_.pop_back();
+
+                if (cost > costs_[rank])
+                {
+                    continue;
+                }
+
+                if (is_goal_[rank])
+                {
+                    --num_unreached_goals;
+                }
+
+                settle(rank, cost);
+            }
+        }
+
+        return num_unreached_goals == 0;
+    }
+
+    double RelaxationHeuristic::extract_relaxed_plan() const
+    {
+        for (const auto action_index : relaxed_plan_)
+        {
+            is_marked_action_[action_index] = false;
+        }
+
+        std::fill(is_marked_rank_.begin(), is_marked_rank_.end(), false);
+        relaxed_plan_.clear();
+        open_ranks_.assign(goal_.begin(), goal_.end());
+        double value = 0.0;
+
+        // Walk back from the goal along the best supporters, every action of the relaxed plan counts once
+
+        while (!open_ranks_.empty())
+        {
+            const auto rank = open_ranks_.back();
+            open_ranks_.pop_back();
+
+            if (is_marked_rank_[rank])
+            {
+                continue;
+            }
+
+            is_marked_rank_[rank] = true;
+            const auto operator_index = supporters_[rank];
+
+            if (operator_index == no_operator)
+            {
+                continue;
+            }
+
+            const auto action_index = operator_actions_[operator_index];
+
+            if (!is_marked_action_[action_index])
+            {
+                is_marked_action_[action_index] = true;
+                relaxed_plan_.emplace_back(action_index);
+                value += operator_costs_[operator_index];
+            }
+
+            for (auto index = precondition_begin_[operator_index]; index < precondition_begin_[operator_index + 1]; ++index)
+            {
+                open_ranks_.emplace_back(preconditions_[index]);
+            }
+        }
+
+        return value;
+    }
+
+    double RelaxationHeuristic::evaluate(const mimir::formalism::State& state) const
+    {
+        if (state->get_problem() != problem_)
+        {
+            throw std::invalid_argument("heuristic is constructed for a different problem");
+        }
+
+        if (!explore(state))
+        {
+            return DEAD_END;
+        }
+
+        double value = 0.0;
+
+        switch (type_)
+        {
+            case RelaxationType::MAX:
+            {
+                for (const auto rank : goal_)
+                {
+                    value = std::max(value, costs_[rank]);
+                }
+
+                return value;
+            }
+
+            case RelaxationType::ADD:
+            {
+                for (const auto rank : goal_)
+                {
+                    value += costs_[rank];
+                }
+
+                return value;
+            }
+
+            case RelaxationType::FF:
+            {
+                return extract_relaxed_plan();
+            }
+
+            default:
+            {
+                throw std::runtime_error("relaxation type is not yet implemented");
+            }
+        }
+    }
+
+    void RelaxationHeuristic::explore_batch(const mimir::formalism::StateList& states, std::size_t first, std::size_t num_states) const
+    {
+        constexpr auto num_lanes = cost_kernels::num_lanes;
+        batch_costs_.assign(static_cast<std::size_t>(num_ranks_) * num_lanes, cost_kernels::infinity);
+        std::fill(rank_sweeps_.begin(), rank_sweeps_.end(), 0);
+        std::fill(operator_sweeps_.begin(), operator_sweeps_.end(), 0);
+
+        // Lanes without a state keep infinite costs for all atoms, so they never make an operator applicable
+
+        constexpr std::size_t bits_per_block = sizeof(std::size_t) * 8;
+
+        for (std::size_t lane = 0; lane < num_states; ++lane)
+        {
+            const auto& blocks = states[first + lane]->get_blocks();
+
+            for (std::size_t block_index = 0; block_index < blocks.size(); ++block_index)
+            {
+                auto block = blocks[block_index];
+
+                while (block != 0)
+                {
+                    const auto rank = static_cast<uint32_t>(block_index * bits_per_block + get_lowest_bit_position(block));
+                    block &= block - 1;
+
+                    if ((rank >= num_static_ranks_) && (rank < num_ranks_))
+                    {
+                        batch_costs_[rank * num_lanes + lane] = 0.0f;
+                    }
+                }
+            }
+        }
+
+        // Apply the operators in sweeps until no cost decreases, an operator is skipped if none of its preconditions decreased since it was last
+        // applied. Operators without preconditions are only applied in the first sweep.
+
+        const auto num_operators = operator_costs_.size();
+        float values[num_lanes];
+        float effect_costs[num_lanes];
+        uint32_t sweep = 0;
+        bool changed;
+
+        do
+        {
+            ++sweep;
+            changed = false;
+
+            for (std::size_t operator_index = 0; operator_index < num_operators; ++operator_index)
+            {
+                const auto precondition_first = precondition_begin_[operator_index];
+                const auto precondition_last = precondition_begin_[operator_index + 1];
+                const auto last_sweep = operator_sweeps_[operator_index];
+                bool is_outdated = (last_sweep == 0);
+
+                for (auto index = precondition_first; (index < precondition_last) && !is_outdated; ++index)
+                {
+                    is_outdated = rank_sweeps_[preconditions_[index]] >= last_sweep;
+                }
+
+                if (!is_outdated)
+                {
+                    continue;
+                }
+
+                operator_sweeps_[operator_index] = sweep;
+                cost_kernels::fill(values, 0.0f);
+
+                for (auto index = precondition_first; index < precondition_last; ++index)
+                {
+                    const auto precondition_costs = batch_costs_.data() + preconditions_[index] * num_lanes;
+
+                    if (type_ == RelaxationType::MAX)
+                    {
+                        cost_kernels::max_into(values, precondition_costs);
+                    }
+                    else
+                    {
+                        cost_kernels::add_into(values, precondition_costs);
+                    }
+                }
+
+                if (cost_kernels::all_infinite(values))
+                {
+                    continue;
+                }
+
+                cost_kernels::add_scalar(values, static_cast<float>(operator_costs_[operator_index]), effect_costs);
+
+                for (auto index = effect_begin_[operator_index]; index < effect_begin_[operator_index + 1]; ++index)
+                {
+                    const auto rank = effects_[index];
+
+                    if (cost_kernels::min_into(batch_costs_.data() + rank * num_lanes, effect_costs))
+                    {
+                        rank_sweeps_[rank] = sweep;
+                        changed = true;
+                    }
+                }
+            }
+        } while (changed);
+    }
+
+    std::vector<double> RelaxationHeuristic::evaluate(const mimir::formalism::StateList& states) const
+    {
+        // h_FF needs the best supporters of every state, which are not kept for batches
+
+        if (type_ == RelaxationType::FF)
+        {
+            return HeuristicBase::evaluate(states);
+        }
+
+        constexpr auto num_lanes = cost_kernels::num_lanes;
+        std::vector<double> values;
+        values.reserve(states.size());
+
+        for (const auto& state : states)
+        {
+            if (state->get_problem() != problem_)
+            {
+                throw std::invalid_argument("heuristic is constructed for a different problem");
+            }
+        }
+
+        for (std::size_t first = 0; first < states.size(); first += num_lanes)
+        {
+            const auto num_states = std::min(num_lanes, states.size() - first);
+
+            // A sweep visits every operator, while the search of a single state stops at the goal, so small batches are evaluated one by one
+
+            if (num_states < num_lanes / 2)
+            {
+                for (std::size_t index = first; index < first + num_states; ++index)
+                {
+                    values.emplace_back(evaluate(states[index]));
+                }
+
+                continue;
+            }
+
+            explore_batch(states, first, num_states);
+
+            for (std::size_t lane = 0; lane < num_states; ++lane)
+            {
+                double value = 0.0;
+
+                for (const auto rank : goal_)
+                {
+                    const auto cost = static_cast<double>(batch_costs_[rank * num_lanes + lane]);
+                    value = (type_ == RelaxationType::MAX) ? std::max(value, cost) : (value + cost);
+                }
+
+                values.emplace_back(value);
+            }
+        }
+
+        return values;
+    }
+
+    RelaxationType RelaxationHeuristic::get_type() const { return type_; }
+
+    const std::vector<uint32_t>& RelaxationHeuristic::get_relaxed_plan() const { return relaxed_plan_; }
+
+    mimir::formalism::ActionList RelaxationHeuristic::get_preferred_actions(const mimir::formalism::State& state) const
+    {
+        mimir::formalism::ActionList preferred_actions;
+
+        if (type_ == RelaxationType::FF)
+        {
+            for (const auto action_index : relaxed_plan_)
+            {
+                const auto& action = actions_[action_index];
+
+                if (mimir::formalism::is_applicable(action, state))
+                {
+                    preferred_actions.emplace_back(action);
+                }
+            }
+        }
+
+        return preferred_actions;
+    }
+
+    std::shared_ptr<RelaxationHeuristic> create_relaxation_heuristic(const mimir::formalism::ProblemDescription& problem,
+                                                                     const mimir::planners::SuccessorGenerator& successor_generator,
+                                                                     RelaxationType type)
+    {
+        return std::make_shared<RelaxationHeuristic>(problem, successor_generator, type);
+    }
+}  // namespace planners
@@ -0,0 +1,203 @@
+#include "../../include/mimir/formalism/state_repository.hpp"
+#include "../../include/mimir/search/lazy_best_first_search.hpp"
+#include "../../include/mimir/search/openlists/alternation_open_list.hpp"
+#include "../../include/mimir/search/search_space.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+namespace mimir::planners
+{
+    LazyBestFirstSearchImpl::LazyBestFirstSearchImpl(const mimir::formalism::ProblemDescription& problem,
+                                                     const mimir::planners::SuccessorGenerator& successor_generator,
+                                                     const mimir::planners::Heuristic& heuristic,
+                                                     const mimir::planners::OpenList& open_list,
+                                                     const mimir::planners::OpenList& preferred_open_list,
+                                                     double g_weight,
+                                                     int32_t preferred_boost) :
+        SearchBase(problem),
+        problem_(problem),
+        successor_generator_(successor_generator),
+        heuristic_(heuristic),
+        open_list_(open_list),
+        preferred_open_list_(preferred_open_list),
+        g_weight_(g_weight),
+        preferred_boost_(preferred_boost),
+        max_g_value_(-1),
+        min_h_value_(HeuristicBase::DEAD_END),
+        max_depth_(-1),
+        expanded_(0),
+        generated_(0),
+        evaluated_(0),
+        preferred_(0)
+    {
+        // A transition that is popped from one list stays in the other, so it is popped twice, which lists that hold every item once do not allow
+
+        if (preferred_open_list_ && (open_list_->supports_decrease_key() || preferred_open_list_->supports_decrease_key()))
+        {
+            throw std::invalid_argument("lazy search with preferred operators needs open lists that do not support decrease_key");
+        }
+    }
+
+    void LazyBestFirstSearchImpl::reset_statistics()
+    {
+        max_g_value_ = -1;
+        min_h_value_ = HeuristicBase::DEAD_END;
+        max_depth_ = -1;
+        expanded_ = 0;
+        generated_ = 0;
+        evaluated_ = 0;
+        preferred_ = 0;
+    }
+
+    std::map<std::string, std::variant<int32_t, double>> LazyBestFirstSearchImpl::get_statistics() const
+    {
+        std::map<std::string, std::variant<int32_t, double>> statistics;
+        statistics["expanded"] = expanded_;
+        statistics["generated"] = generated_;
+        statistics["evaluated"] = evaluated_;
+        statistics["preferred"] = preferred_;
+        statistics["max_depth"] = max_depth_;
+        statistics["max_g_value"] = max_g_value_;
+        statistics["min_h_value"] = min_h_value_;
+        return statistics;
+    }
+
+    SearchResult LazyBestFirstSearchImpl::plan(mimir::formalism::ActionList& out_plan)
+    {
+        if ((open_list_->size() > 0) || (preferred_open_list_ && (preferred_open_list_->size() > 0)))
+        {
+            throw std::runtime_error("open list is not initially empty");
+        }
+
+        reset_statistics();
+
+        struct Transition
+        {
+            uint32_t action_id;
+            mimir::formalism::StateId predecessor_index;
+        };
+
+        // The nodes are indexed by the ids of their states in the repository, and the items of the open lists are indices of transitions. A state is
+        // interned when it is generated, and evaluated right after, so every state in the repository is closed.
+        const auto state_repository = mimir::formalism::create_state_repository(problem_);
+        const auto search_space = create_search_space();
+        std::vector<Transition> transition_list;
+        std::vector<std::size_t> succ_words;  // Scratch buffer, successors are only interned if they are new
+
+        // Transitions are inserted into the lists directly, and popped from an alternation of the regular and the preferred list if there is one
+
+        const auto alternation_open_list = preferred_open_list_ ? create_alternation_open_list({ open_list_, preferred_open_list_ }) : nullptr;
+        const auto open_list = alternation_open_list ? OpenList(alternation_open_list) : open_list_;
+
+        auto state = this->initial_state;
+        mimir::formalism::StateId initial_index;
+        state_repository->insert(state, initial_index);
+        search_space->add_root_node(initial_index);
+        auto index = initial_index;
+
+        while (true)
+        {
+            const auto h_value = heuristic_->evaluate(state);
+            search_space->set_h_value(index, h_value);
+            search_space->set_closed(index, true);
+            ++evaluated_;
+
+            if (should_abort)
+            {
+                return SearchResult::ABORTED;
+            }
+
+            if (!HeuristicBase::is_dead_end(h_value))
+            {
+                const auto g_value = search_space->get_g_value(index);
+                max_depth_ = std::max(max_depth_, static_cast<int32_t>(search_space->get_depth(index)));
+                max_g_value_ = std::max(max_g_value_, static_cast<double>(g_value));
+
+                if (h_value < min_h_value_)
+                {
+                    min_h_value_ = h_value;
+                    notify_handlers();
+
+                    if (preferred_open_list_)
+                    {
+                        alternation_open_list->boost(1, preferred_boost_);
+                    }
+                }
+
+                if (mimir::formalism::literals_hold(problem_->goal, state))
+                {
+                    out_plan = search_space->get_plan(index);
+                    return SearchResult::SOLVED;
+                }
+
+                ++expanded_;
+
+                // The preferred operators are only valid right after the evaluation of the state
+
+                const auto applicable_actions = successor_generator_->get_applicable_actions(state);
+                const auto preferred_actions = preferred_open_list_ ? heuristic_->get_preferred_actions(state) : mimir::formalism::ActionList();
+                const auto priority = g_weight_ * g_value + h_value;
+                const auto is_equal = std::equal_to<mimir::formalism::Action>();
+
+                for (const auto& action : applicable_actions)
+                {
+                    const auto transition_index = static_cast<int32_t>(transition_list.size());
+                    transition_list.emplace_back(Transition { search_space->get_action_id(action), index });
+                    open_list_->insert(transition_index, priority);
+                    ++generated_;
+
+                    // The heuristic may ground its own copies of the actions, so they are compared by value
+
+                    if (std::any_of(preferred_actions.begin(),
+                                    preferred_actions.end(),
+                                    [&is_equal, &action](const auto& preferred_action) { return is_equal(preferred_action, action); }))
+                    {
+                        preferred_open_list_->insert(transition_index, priority);
+                        ++preferred_;
+                    }
+                }
+            }
+
+            // Pop transitions until one leads to a state that was not generated before
+
+            while (true)
+            {
+                if (open_list->size() == 0)
+                {
+                    return SearchResult::UNSOLVABLE;
+                }
+
+                const auto& transition = transition_list[open_list->pop()];
+                const auto& action = search_space->get_action_by_id(transition.action_id);
+                const auto predecessor_index = transition.predecessor_index;
+
+                mimir::formalism::apply_into(action,
+                                             state_repository->get_blocks(predecessor_index),
+                                             state_repository->get_num_blocks(predecessor_index),
+                                             succ_words);
+                mimir::formalism::StateId succ_id;
+
+                if (state_repository->insert(succ_words.data(), succ_words.size(), succ_id))
+                {
+                    search_space->add_node(succ_id, predecessor_index, action, search_space->get_g_value(predecessor_index) + static_cast<float>(action->cost));
+                    index = succ_id;
+                    state = state_repository->get_state(succ_id);
+                    break;
+                }
+            }
+        }
+    }
+
+    LazyBestFirstSearch create_lazy_best_first_search(const mimir::formalism::ProblemDescription& problem,
+                                                      const mimir::planners::SuccessorGenerator& successor_generator,
+                                                      const mimir::planners::Heuristic& heuristic,
+                                                      const mimir::planners::OpenList& open_list,
+                                                      const mimir::planners::OpenList& preferred_open_list,
+                                                      double g_weight,
+                                                      int32_t preferred_boost)
+    {
+        return std::make_shared<LazyBestFirstSearchImpl>(problem, successor_generator, heuristic, open_list, preferred_open_list, g_weight, preferred_boost);
+    }
+}  // namespace mimir::planners
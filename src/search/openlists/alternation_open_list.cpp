@@ -0,0 +1,110 @@
+#include "../../../include/mimir/search/openlists/alternation_open_list.hpp"
+
+#include <stdexcept>
+
+namespace mimir::planners
+{
+    template<typename T>
+    AlternationOpenList<T>::AlternationOpenList(const std::vector<std::shared_ptr<OpenListBase<T>>>& open_lists) :
+        open_lists_(open_lists),
+        counters_(open_lists.size(), 0)
+    {
+        if (open_lists.empty())
+        {
+            throw std::invalid_argument("an alternation open list needs at least one sub-list");
+        }
+
+        for (const auto& open_list : open_lists)
+        {
+            if (!open_list)
+            {
+                throw std::invalid_argument("the sub-lists of an alternation open list must not be null");
+            }
+
+            // An item that is popped from one sub-list stays in the others, so sub-lists that hold every item at most once cannot take it again
+
+            if (open_list->supports_decrease_key())
+            {
+                throw std::invalid_argument("the sub-lists of an alternation open list must not support decrease_key");
+            }
+        }
+    }
+
+    template<typename T>
+    void AlternationOpenList<T>::insert(const T& item, double priority)
+    {
+        for (const auto& open_list : open_lists_)
+        {
+            open_list->insert(item, priority);
+        }
+    }
+
+    template<typename T>
+    void AlternationOpenList<T>::insert(const T& item, double priority, double tie_breaker)
+    {
+        for (const auto& open_list : open_lists_)
+        {
+            open_list->insert(item, priority, tie_breaker);
+        }
+    }
+
+    template<typename T>
+    void AlternationOpenList<T>::insert_into(std::size_t index, const T& item, double priority)
+    {
+        open_lists_.at(index)->insert(item, priority);
+    }
+
+    template<typename T>
+    void AlternationOpenList<T>::insert_into(std::size_t index, const T& item, double priority, double tie_breaker)
+    {
+        open_lists_.at(index)->insert(item, priority, tie_breaker);
+    }
+
+    template<typename T>
+    void AlternationOpenList<T>::boost(std::size_t index, int32_t amount)
+    {
+        counters_.at(index) -= amount;
+    }
+
+    template<typename T>
+    T AlternationOpenList<T>::pop()
+    {
+        std::size_t best_index = open_lists_.size();
+
+        for (std::size_t index = 0; index < open_lists_.size(); ++index)
+        {
+            if ((open_lists_[index]->size() > 0) && ((best_index == open_lists_.size()) || (counters_[index] < counters_[best_index])))
+            {
+                best_index = index;
+            }
+        }
+
+        if (best_index == open_lists_.size())
+        {
+            throw std::runtime_error("open list is empty");
+        }
+
+        ++counters_[best_index];
+        return open_lists_[best_index]->pop();
+    }
+
+    template<typename T>
+    std::size_t AlternationOpenList<T>::size()
+    {
+        std::size_t size = 0;
+
+        for (const auto& open_list : open_lists_)
+        {
+            size += open_list->size();
+        }
+
+        return size;
+    }
+
+    template class AlternationOpenList<int32_t>;
+
+    std::shared_ptr<AlternationOpenList<int32_t>> create_alternation_open_list(const std::vector<OpenList>& open_lists)
+    {
+        return std::make_shared<AlternationOpenList<int32_t>>(open_lists);
+    }
+}  // namespace planners
@@ -0,0 +1,115 @@
+#include "../../../include/mimir/search/openlists/bucket_open_list.hpp"
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace mimir::planners
+{
+    static std::size_t get_bucket_index(double value)
+    {
+        if (!(value >= 0.0) || (value != std::floor(value)) || (value > static_cast<double>(std::numeric_limits<int32_t>::max())))
+        {
+            throw std::invalid_argument("priorities of a bucket open list must be non-negative integers");
+        }
+
+        return static_cast<std::size_t>(value);
+    }
+
+    template<typename T>
+    BucketOpenList<T>::BucketOpenList() : buckets_(), min_priority_(0), size_(0)
+    {
+    }
+
+    template<typename T>
+    void BucketOpenList<T>::insert(const T& item, double priority)
+    {
+        insert(item, priority, 0.0);
+    }
+
+    template<typename T>
+    void BucketOpenList<T>::insert(const T& item, double priority, double tie_breaker)
+    {
+        const auto priority_index = get_bucket_index(priority);
+        const auto tie_breaker_index = get_bucket_index(tie_breaker);
+
+        // Buckets are only added between the existing ones and the new priority, so they span the range of the priorities in the list, and the
+        // lists of a bucket span the range of its tie-breakers in the same way
+
+        if (buckets_.empty())
+        {
+            min_priority_ = priority_index;
+        }
+
+        if (priority_index < min_priority_)
+        {
+            buckets_.insert(buckets_.begin(), min_priority_ - priority_index, Bucket());
+            min_priority_ = priority_index;
+        }
+
+        if (priority_index - min_priority_ >= buckets_.size())
+        {
+            buckets_.resize(priority_index - min_priority_ + 1);
+        }
+
+        auto& bucket = buckets_[priority_index - min_priority_];
+
+        if (bucket.items.empty())
+        {
+            bucket.min_tie_breaker = tie_breaker_index;
+        }
+
+        if (tie_breaker_index < bucket.min_tie_breaker)
+        {
+            bucket.items.insert(bucket.items.begin(), bucket.min_tie_breaker - tie_breaker_index, std::vector<T>());
+            bucket.min_tie_breaker = tie_breaker_index;
+        }
+
+        if (tie_breaker_index - bucket.min_tie_breaker >= bucket.items.size())
+        {
+            bucket.items.resize(tie_breaker_index - bucket.min_tie_breaker + 1);
+        }
+
+        bucket.items[tie_breaker_index - bucket.min_tie_breaker].emplace_back(item);
+        ++size_;
+    }
+
+    template<typename T>
+    T BucketOpenList<T>::pop()
+    {
+        if (size_ == 0)
+        {
+            throw std::runtime_error("open list is empty");
+        }
+
+        auto& bucket = buckets_.front();
+        auto& items = bucket.items.front();
+        const auto item = items.back();
+        items.pop_back();
+        --size_;
+
+        // Drop the empty lists and buckets in front, so that the first ones hold the lowest tie-breaker and priority again
+
+        while (!bucket.items.empty() && bucket.items.front().empty())
+        {
+            bucket.items.pop_front();
+            ++bucket.min_tie_breaker;
+        }
+
+        while (!buckets_.empty() && buckets_.front().items.empty())
+        {
+            buckets_.pop_front();
+            ++min_priority_;
+        }
+
+        return item;
+    }
+
+    template<typename T>
+    std::size_t BucketOpenList<T>::size()
+    {
+        return size_;
+    }
+
+    std::shared_ptr<BucketOpenList<int32_t>> create_bucket_open_list() { return std::make_shared<BucketOpenList<int32_t>>(); }
+}  // namespace planners
@@ -0,0 +1,132 @@
+#include "../../../include/mimir/search/openlists/epsilon_greedy_open_list.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+namespace mimir::planners
+{
+    template<typename T>
+    EpsilonGreedyOpenList<T>::EpsilonGreedyOpenList(double epsilon, uint64_t seed) : heap_(), epsilon_(epsilon), random_(seed), counter_(0)
+    {
+        if (!(epsilon >= 0.0) || (epsilon > 1.0))
+        {
+            throw std::invalid_argument("epsilon must be a probability");
+        }
+    }
+
+    template<typename T>
+    bool EpsilonGreedyOpenList<T>::is_less(const Entry& lhs, const Entry& rhs)
+    {
+        if (lhs.priority != rhs.priority)
+        {
+            return lhs.priority < rhs.priority;
+        }
+
+        if (lhs.tie_breaker != rhs.tie_breaker)
+        {
+            return lhs.tie_breaker < rhs.tie_breaker;
+        }
+
+        return lhs.counter < rhs.counter;
+    }
+
+    template<typename T>
+    void EpsilonGreedyOpenList<T>::sift_up(std::size_t position)
+    {
+        while (position > 0)
+        {
+            const auto parent = (position - 1) / 2;
+
+            if (!is_less(heap_[position], heap_[parent]))
+            {
+                break;
+            }
+
+            std::swap(heap_[position], heap_[parent]);
+            position = parent;
+        }
+    }
+
+    template<typename T>
+    void EpsilonGreedyOpenList<T>::sift_down(std::size_t position)
+    {
+        while (true)
+        {
+            const auto left = 2 * position + 1;
+            const auto right = left + 1;
+            auto smallest = position;
+
+            if ((left < heap_.size()) && is_less(heap_[left], heap_[smallest]))
+            {
+                smallest = left;
+            }
+
+            if ((right < heap_.size()) && is_less(heap_[right], heap_[smallest]))
+            {
+                smallest = right;
+            }
+
+            if (smallest == position)
+            {
+                break;
+            }
+
+            std::swap(heap_[position], heap_[smallest]);
+            position = smallest;
+        }
+    }
+
+    template<typename T>
+    void EpsilonGreedyOpenList<T>::insert(const T& item, double priority)
+    {
+        insert(item, priority, 0.0);
+    }
+
+    template<typename T>
+    void EpsilonGreedyOpenList<T>::insert(const T& item, double priority, double tie_breaker)
+    {
+        heap_.emplace_back(Entry { priority, tie_breaker, counter_++, item });
+        sift_up(heap_.size() - 1);
+    }
+
+    template<typename T>
+    T EpsilonGreedyOpenList<T>::pop()
+    {
+        if (heap_.empty())
+        {
+            throw std::runtime_error("open list is empty");
+        }
+
+        std::size_t position = 0;
+
+        if ((epsilon_ > 0.0) && (std::uniform_real_distribution<double>(0.0, 1.0)(random_) < epsilon_))
+        {
+            position = std::uniform_int_distribution<std::size_t>(0, heap_.size() - 1)(random_);
+        }
+
+        // Move the last entry into the gap, it may have to move in either direction if the gap is not at the root
+
+        const auto item = heap_[position].item;
+        heap_[position] = heap_.back();
+        heap_.pop_back();
+
+        if (position < heap_.size())
+        {
+            sift_up(position);
+            sift_down(position);
+        }
+
+        return item;
+    }
+
+    template<typename T>
+    std::size_t EpsilonGreedyOpenList<T>::size()
+    {
+        return heap_.size();
+    }
+
+    std::shared_ptr<EpsilonGreedyOpenList<int32_t>> create_epsilon_greedy_open_list(double epsilon, uint64_t seed)
+    {
+        return std::make_shared<EpsilonGreedyOpenList<int32_t>>(epsilon, seed);
+    }
+}  // namespace planners
@@ -0,0 +1,189 @@
+#include "../../../include/mimir/search/openlists/indexed_heap_open_list.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace mimir::planners
+{
+    template<typename T>
+    IndexedHeapOpenList<T>::IndexedHeapOpenList(std::size_t arity) : arity_(arity), heap_(), positions_()
+    {
+        if (arity < 2)
+        {
+            throw std::invalid_argument("the arity of a heap must be at least 2");
+        }
+    }
+
+    template<typename T>
+    bool IndexedHeapOpenList<T>::is_less(const Entry& lhs, const Entry& rhs)
+    {
+        if (lhs.priority != rhs.priority)
+        {
+            return lhs.priority < rhs.priority;
+        }
+
+        if (lhs.tie_breaker != rhs.tie_breaker)
+        {
+            return lhs.tie_breaker < rhs.tie_breaker;
+        }
+
+        return lhs.item < rhs.item;
+    }
+
+    template<typename T>
+    void IndexedHeapOpenList<T>::move_entry(std::size_t position, const Entry& entry)
+    {
+        heap_[position] = entry;
+        positions_[static_cast<std::size_t>(entry.item)] = static_cast<uint32_t>(position);
+    }
+
+    // Both sifts move the entries on the path by one step and write the given entry once, at its final position
+
+    template<typename T>
+    void IndexedHeapOpenList<T>::sift_up(std::size_t position, const Entry& entry)
+    {
+        while (position > 0)
+        {
+            const auto parent = (position - 1) / arity_;
+
+            if (!is_less(entry, heap_[parent]))
+            {
+                break;
+            }
+
+            move_entry(position, heap_[parent]);
+            position = parent;
+        }
+
+        move_entry(position, entry);
+    }
+
+    template<typename T>
+    void IndexedHeapOpenList<T>::sift_down(std::size_t position, const Entry& entry)
+    {
+        while (true)
+        {
+            const auto first_child = arity_ * position + 1;
+
+            if (first_child >= heap_.size())
+            {
+                break;
+            }
+
+            const auto last_child = std::min(first_child + arity_, heap_.size());
+            auto best_child = first_child;
+
+            for (auto child = first_child + 1; child < last_child; ++child)
+            {
+                if (is_less(heap_[child], heap_[best_child]))
+                {
+                    best_child = child;
+                }
+            }
+
+            if (!is_less(heap_[best_child], entry))
+            {
+                break;
+            }
+
+            move_entry(position, heap_[best_child]);
+            position = best_child;
+        }
+
+        move_entry(position, entry);
+    }
+
+    template<typename T>
+    void IndexedHeapOpenList<T>::insert(const T& item, double priority)
+    {
+        insert(item, priority, 0.0);
+    }
+
+    template<typename T>
+    void IndexedHeapOpenList<T>::insert(const T& item, double priority, double tie_breaker)
+    {
+        if (item < 0)
+        {
+            throw std::invalid_argument("items of an indexed heap must be non-negative");
+        }
+
+        const auto index = static_cast<std::size_t>(item);
+
+        if (index >= positions_.size())
+        {
+            positions_.resize(index + 1, no_position);
+        }
+        else if (positions_[index] != no_position)
+        {
+            throw std::invalid_argument("item is already in the open list");
+        }
+
+        heap_.emplace_back();
+        sift_up(heap_.size() - 1, Entry { priority, tie_breaker, item });
+    }
+
+    template<typename T>
+    bool IndexedHeapOpenList<T>::supports_decrease_key() const
+    {
+        return true;
+    }
+
+    template<typename T>
+    void IndexedHeapOpenList<T>::decrease_key(const T& item, double priority, double tie_breaker)
+    {
+        if (!contains(item))
+        {
+            throw std::invalid_argument("item is not in the open list");
+        }
+
+        const auto position = positions_[static_cast<std::size_t>(item)];
+        const Entry entry { priority, tie_breaker, item };
+
+        if (is_less(heap_[position], entry))
+        {
+            throw std::invalid_argument("the new key of the item is higher");
+        }
+
+        sift_up(position, entry);
+    }
+
+    template<typename T>
+    bool IndexedHeapOpenList<T>::contains(const T& item) const
+    {
+        return (item >= 0) && (static_cast<std::size_t>(item) < positions_.size()) && (positions_[static_cast<std::size_t>(item)] != no_position);
+    }
+
+    template<typename T>
+    T IndexedHeapOpenList<T>::pop()
+    {
+        if (heap_.empty())
+        {
+            throw std::runtime_error("open list is empty");
+        }
+
+        const auto item = heap_.front().item;
+        const auto last_entry = heap_.back();
+        heap_.pop_back();
+        positions_[static_cast<std::size_t>(item)] = no_position;
+
+        if (!heap_.empty())
+        {
+            sift_down(0, last_entry);
+        }
+
+        return item;
+    }
+
+    template<typename T>
+    std::size_t IndexedHeapOpenList<T>::size()
+    {
+        return heap_.size();
+    }
+
+    template class IndexedHeapOpenList<int32_t>;
+
+    std::shared_ptr<IndexedHeapOpenList<int32_t>> create_indexed_heap_open_list(std::size_t arity)
+    {
+        return std::make_shared<IndexedHeapOpenList<int32_t>>(arity);
+    }
+}  // namespace planners
@@ -0,0 +1,109 @@
+#include "../../../include/mimir/search/openlists/tie_breaking_open_list.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace mimir::planners
+{
+    template<typename T>
+    TieBreakingOpenList<T>::TieBreakingOpenList(std::size_t num_keys) : num_keys_(num_keys), keys_(), free_slots_(), heap_(), counter_(0)
+    {
+        if (num_keys == 0)
+        {
+            throw std::invalid_argument("a tie-breaking open list needs at least one key");
+        }
+    }
+
+    template<typename T>
+    bool TieBreakingOpenList<T>::is_greater(const Entry& lhs, const Entry& rhs) const
+    {
+        const auto lhs_keys = keys_.data() + lhs.slot * num_keys_;
+        const auto rhs_keys = keys_.data() + rhs.slot * num_keys_;
+
+        for (std::size_t index = 0; index < num_keys_; ++index)
+        {
+            if (lhs_keys[index] != rhs_keys[index])
+            {
+                return lhs_keys[index] > rhs_keys[index];
+            }
+        }
+
+        return lhs.counter > rhs.counter;
+    }
+
+    template<typename T>
+    void TieBreakingOpenList<T>::push(const T& item, const double* keys, std::size_t num_keys)
+    {
+        if (num_keys > num_keys_)
+        {
+            throw std::invalid_argument("too many keys for the tie-breaking open list");
+        }
+
+        std::size_t slot;
+
+        if (free_slots_.empty())
+        {
+            slot = keys_.size() / num_keys_;
+            keys_.resize(keys_.size() + num_keys_);
+        }
+        else
+        {
+            slot = free_slots_.back();
+            free_slots_.pop_back();
+        }
+
+        const auto slot_keys = keys_.begin() + slot * num_keys_;
+        std::copy(keys, keys + num_keys, slot_keys);
+        std::fill(slot_keys + num_keys, slot_keys + num_keys_, 0.0);
+
+        heap_.emplace_back(Entry { slot, counter_++, item });
+        std::push_heap(heap_.begin(), heap_.end(), [this](const Entry& lhs, const Entry& rhs) { return is_greater(lhs, rhs); });
+    }
+
+    template<typename T>
+    void TieBreakingOpenList<T>::insert(const T& item, double priority)
+    {
+        push(item, &priority, 1);
+    }
+
+    template<typename T>
+    void TieBreakingOpenList<T>::insert(const T& item, double priority, double tie_breaker)
+    {
+        const double keys[] = { priority, tie_breaker };
+        push(item, keys, std::min<std::size_t>(2, num_keys_));
+    }
+
+    template<typename T>
+    void TieBreakingOpenList<T>::insert(const T& item, const std::vector<double>& keys)
+    {
+        push(item, keys.data(), keys.size());
+    }
+
+    template<typename T>
+    T TieBreakingOpenList<T>::pop()
+    {
+        if (heap_.empty())
+        {
+            throw std::runtime_error("open list is empty");
+        }
+
+        std::pop_heap(heap_.begin(), heap_.end(), [this](const Entry& lhs, const Entry& rhs) { return is_greater(lhs, rhs); });
+        const auto entry = heap_.back();
+        heap_.pop_back();
+        free_slots_.emplace_back(entry.slot);
+        return entry.item;
+    }
+
+    template<typename T>
+    std::size_t TieBreakingOpenList<T>::size()
+    {
+        return heap_.size();
+    }
+
+    template class TieBreakingOpenList<int32_t>;
+
+    std::shared_ptr<TieBreakingOpenList<int32_t>> create_tie_breaking_open_list(std::size_t num_keys)
+    {
+        return std::make_shared<TieBreakingOpenList<int32_t>>(num_keys);
+    }
+}  // namespace planners
@@ -0,0 +1,153 @@
+#include "../../include/mimir/search/search_space.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace mimir::planners
+{
+    SearchSpaceImpl::SearchSpaceImpl() :
+        parent_ids_(),
+        action_ids_(),
+        depths_(),
+        g_values_(),
+        h_values_(),
+        status_(),
+        actions_(),
+        action_id_by_address_()
+    {
+    }
+
+    void SearchSpaceImpl::set_bit(mimir::formalism::StateId id, uint8_t bit, bool value)
+    {
+        status_[id] = value ? (status_[id] | bit) : (status_[id] & ~bit);
+    }
+
+    void SearchSpaceImpl::add_root_node(mimir::formalism::StateId id)
+    {
+        if ((id != 0) || (size() > 0))
+        {
+            throw std::invalid_argument("the root node must be the first node");
+        }
+
+        parent_ids_.emplace_back(no_id);
+        action_ids_.emplace_back(no_id);
+        depths_.emplace_back(0);
+        g_values_.emplace_back(0.0f);
+        h_values_.emplace_back(-1.0f);
+        status_.emplace_back(0);
+    }
+
+    void SearchSpaceImpl::add_node(mimir::formalism::StateId id,
+                                   mimir::formalism::StateId parent_id,
+                                   const mimir::formalism::Action& action,
+                                   float g_value)
+    {
+        if (id != size())
+        {
+            throw std::invalid_argument("nodes must be added in the order in which their states are interned");
+        }
+
+        parent_ids_.emplace_back(parent_id);
+        action_ids_.emplace_back(get_action_id(action));
+        depths_.emplace_back(depths_[parent_id] + 1);
+        g_values_.emplace_back(g_value);
+        h_values_.emplace_back(-1.0f);
+        status_.emplace_back(0);
+    }
+
+    void SearchSpaceImpl::set_parent(mimir::formalism::StateId id,
+                                     mimir::formalism::StateId parent_id,
+                                     const mimir::formalism::Action& action,
+                                     float g_value)
+    {
+        parent_ids_[id] = parent_id;
+        action_ids_[id] = get_action_id(action);
+        depths_[id] = depths_[parent_id] + 1;
+        g_values_[id] = g_value;
+    }
+
+    uint32_t SearchSpaceImpl::get_parent_id(mimir::formalism::StateId id) const { return parent_ids_[id]; }
+
+    mimir::formalism::Action SearchSpaceImpl::get_action(mimir::formalism::StateId id) const
+    {
+        const auto action_id = action_ids_[id];
+        return (action_id == no_id) ? nullptr : actions_[action_id];
+    }
+
+    uint32_t SearchSpaceImpl::get_depth(mimir::formalism::StateId id) const { return depths_[id]; }
+
+    float SearchSpaceImpl::get_g_value(mimir::formalism::StateId id) const { return g_values_[id]; }
+
+    float SearchSpaceImpl::get_h_value(mimir::formalism::StateId id) const { return h_values_[id]; }
+
+    void SearchSpaceImpl::set_h_value(mimir::formalism::StateId id, double h_value)
+    {
+        h_values_[id] = static_cast<float>(h_value);
+        set_bit(id, evaluated_bit, true);
+    }
+
+    bool SearchSpaceImpl::is_evaluated(mimir::formalism::StateId id) const { return (status_[id] & evaluated_bit) != 0; }
+
+    bool SearchSpaceImpl::is_closed(mimir::formalism::StateId id) const { return (status_[id] & closed_bit) != 0; }
+
+    void SearchSpaceImpl::set_closed(mimir::formalism::StateId id, bool closed) { set_bit(id, closed_bit, closed); }
+
+    uint32_t SearchSpaceImpl::get_action_id(const mimir::formalism::Action& action)
+    {
+        const auto [it, inserted] = action_id_by_address_.emplace(action.get(), static_cast<uint32_t>(actions_.size()));
+
+        if (inserted)
+        {
+            actions_.emplace_back(action);
+        }
+
+        return it->second;
+    }
+
+    const mimir::formalism::Action& SearchSpaceImpl::get_action_by_id(uint32_t action_id) const { return actions_[action_id]; }
+
+    mimir::formalism::ActionList SearchSpaceImpl::get_plan(mimir::formalism::StateId id) const
+    {
+        mimir::formalism::ActionList plan;
+
+        for (auto current_id = id; action_ids_[current_id] != no_id; current_id = parent_ids_[current_id])
+        {
+            plan.emplace_back(actions_[action_ids_[current_id]]);
+        }
+
+        std::reverse(plan.begin(), plan.end());
+        return plan;
+    }
+
+    std::size_t SearchSpaceImpl::size() const { return parent_ids_.size(); }
+
+    std::size_t SearchSpaceImpl::memory_usage() const
+    {
+        // The bucket size is an estimate: the key, the id, the stored hash and the distance to the ideal bucket.
+
+        std::size_t memory = 0;
+        memory += parent_ids_.capacity() * sizeof(uint32_t);
+        memory += action_ids_.capacity() * sizeof(uint32_t);
+        memory += depths_.capacity() * sizeof(uint32_t);
+        memory += g_values_.capacity() * sizeof(float);
+        memory += h_values_.capacity() * sizeof(float);
+        memory += status_.capacity() * sizeof(uint8_t);
+        memory += actions_.capacity() * sizeof(mimir::formalism::Action);
+        memory += action_id_by_address_.bucket_count() * (sizeof(const mimir::formalism::ActionImpl*) + sizeof(uint32_t) + sizeof(uint32_t) + sizeof(int16_t));
+        return memory;
+    }
+
+    void SearchSpaceImpl::clear()
+    {
+        parent_ids_.clear();
+        action_ids_.clear();
+        depths_.clear();
+        g_values_.clear();
+        h_values_.clear();
+        status_.clear();
+        actions_.clear();
+        action_id_by_address_.clear();
+    }
+
+    SearchSpace create_search_space() { return std::make_shared<SearchSpaceImpl>(); }
+}  // namespace mimir::planners
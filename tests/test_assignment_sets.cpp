@@ -0,0 +1,146 @@
+#include "../include/mimir/formalism/domain.hpp"
+#include "../include/mimir/formalism/problem.hpp"
+#include "../include/mimir/generators/assignment_sets.hpp"
+#include "../include/mimir/generators/complete_state_space.hpp"
+#include "../include/mimir/generators/grounded_successor_generator.hpp"
+#include "../include/mimir/generators/lifted_successor_generator.hpp"
+#include "../include/mimir/generators/successor_generator.hpp"
+#include "../include/mimir/generators/successor_generator_factory.hpp"
+#include "../include/mimir/pddl/parsers.hpp"
+
+// Test instances
+
+#include "instances/blocks/domain.hpp"
+#include "instances/blocks/problem.hpp"
+#include "instances/gripper/domain.hpp"
+#include "instances/gripper/problem.hpp"
+#include "instances/spanner/domain.hpp"
+#include "instances/spanner/problem.hpp"
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace test
+{
+    class AssignmentSetsTest : public testing::TestWithParam<std::tuple<std::string, std::string>>
+    {
+    };
+
+    TEST_P(AssignmentSetsTest, Parameterized)
+    {
+        const auto domain_text = std::get<0>(GetParam());
+        const auto problem_text = std::get<1>(GetParam());
+
+        std::istringstream domain_stream(domain_text);
+        std::istringstream problem_stream(problem_text);
+
+        const auto domain = mimir::parsers::DomainParser::parse(domain_stream);
+        const auto problem = mimir::parsers::ProblemParser::parse(domain, "", problem_stream);
+
+        const auto successor_generator = mimir::planners::create_sucessor_generator(problem, mimir::planners::SuccessorGeneratorType::GROUNDED);
+        const auto state_space = mimir::planners::create_complete_state_space(problem, successor_generator);
+        const auto& states = state_space->get_states();
+        const auto num_objects = static_cast<int32_t>(problem->objects.size());
+
+        // Move the same sets through every state, in both directions, and compare them with sets built from scratch
+
+        mimir::planners::AssignmentSets incremental_sets(domain, problem);
+
+        for (std::size_t index = 0; index < 2 * states.size(); ++index)
+        {
+            const auto& state = (index < states.size()) ? states[index] : states[2 * states.size() - index - 1];
+            const auto ranks = state->get_dynamic_ranks();
+
+            mimir::planners::AssignmentSets fresh_sets(domain, problem, ranks);
+            ASSERT_THROW(fresh_sets.update(ranks), std::logic_error);
+            incremental_sets.update(ranks);
+            ASSERT_EQ(incremental_sets.get_ranks(), ranks);
+
+            for (const auto& predicate : domain->predicates)
+            {
+                const auto arity = static_cast<int32_t>(predicate->arity);
+
+                for (int32_t first_position = 0; first_position < arity; ++first_position)
+                {
+                    for (int32_t first_object = 0; first_object < num_objects; ++first_object)
+                    {
+                        ASSERT_EQ(incremental_sets.contains(predicate->id, first_position, first_object, -1, -1, arity),
+                                  fresh_sets.contains(predicate->id, first_position, first_object, -1, -1, arity));
+
+                        for (int32_t second_position = first_position + 1; second_position < arity; ++second_position)
+                        {
+                            for (int32_t second_object = 0; second_object < num_objects; ++second_object)
+                            {
+                                ASSERT_EQ(incremental_sets.contains(predicate->id, first_position, first_object, second_position, second_object, arity),
+                                          fresh_sets.contains(predicate->id, first_position, first_object, second_position, second_object, arity));
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        // Lifted successor generation with persistent sets yields the same actions as the grounded generator
+
+        const auto lifted_generator = mimir::planners::create_sucessor_generator(problem, mimir::planners::SuccessorGeneratorType::LIFTED);
+        const auto grounded_generator = std::dynamic_pointer_cast<mimir::planners::GroundedSuccessorGenerator>(successor_generator);
+        std::vector<uint32_t> action_ids;
+
+        for (const auto& state : states)
+        {
+            const auto grounded_actions = successor_generator->get_applicable_actions(state);
+            ASSERT_EQ(lifted_generator->get_applicable_actions(state).size(), grounded_actions.size());
+
+            // The compiled decision tree reports the same actions by their ids
+
+            const auto& blocks = state->get_blocks();
+            grounded_generator->get_applicable_action_ids(blocks.data(), blocks.size(), action_ids);
+            ASSERT_EQ(action_ids.size(), grounded_actions.size());
+
+            for (std::size_t index = 0; index < action_ids.size(); ++index)
+            {
+                ASSERT_EQ(grounded_generator->get_actions().at(action_ids[index]), grounded_actions[index]);
+                ASSERT_TRUE(mimir::formalism::is_applicable(grounded_actions[index], state));
+            }
+        }
+
+        // Processing the schemas in parallel yields the same actions in the same order
+
+        const auto parallel_generator = std::dynamic_pointer_cast<mimir::planners::LiftedSuccessorGenerator>(
+            mimir::planners::create_sucessor_generator(problem, mimir::planners::SuccessorGeneratorType::LIFTED, 4));
+        ASSERT_TRUE(parallel_generator);
+        ASSERT_EQ(parallel_generator->get_num_threads(), std::min(static_cast<std::size_t>(4), domain->action_schemas.size()));
+        std::equal_to<mimir::formalism::Action> action_equals;
+
+        // A tiny action cache constantly evicts actions, which must not change the result either
+
+        const mimir::planners::LiftedSuccessorGenerator evicting_generator(problem, 1, domain->action_schemas.size());
+
+        for (const auto& state : states)
+        {
+            const auto sequential_actions = lifted_generator->get_applicable_actions(state);
+            const auto parallel_actions = parallel_generator->get_applicable_actions(state);
+            const auto evicting_actions = evicting_generator.get_applicable_actions(state);
+            ASSERT_EQ(evicting_actions.size(), sequential_actions.size());
+            mimir::formalism::ActionList timed_actions;
+            ASSERT_TRUE(parallel_generator->get_applicable_actions(std::chrono::high_resolution_clock::time_point::max(), state, timed_actions));
+            ASSERT_EQ(parallel_actions.size(), sequential_actions.size());
+            ASSERT_EQ(timed_actions.size(), sequential_actions.size());
+
+            for (std::size_t index = 0; index < sequential_actions.size(); ++index)
+            {
+                ASSERT_TRUE(action_equals(parallel_actions[index], sequential_actions[index]));
+                ASSERT_TRUE(action_equals(timed_actions[index], sequential_actions[index]));
+                ASSERT_TRUE(action_equals(evicting_actions[index], sequential_actions[index]));
+            }
+        }
+    }
+
+    INSTANTIATE_TEST_SUITE_P(ParamTest,
+                             AssignmentSetsTest,
+                             testing::Values(std::make_tuple(blocks::domain, blocks::problem),
+                                             std::make_tuple(gripper::domain, gripper::problem),
+                                             std::make_tuple(spanner::domain, spanner::problem)));
+}  // namespace test
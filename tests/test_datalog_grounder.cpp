@@ -0,0 +1,178 @@
+#include "../include/mimir/formalism/action_schema.hpp"
+#include "../include/mimir/formalism/domain.hpp"
+#include "../include/mimir/formalism/problem.hpp"
+#include "../include/mimir/generators/datalog_grounder.hpp"
+#include "../include/mimir/generators/lifted_successor_generator.hpp"
+#include "../include/mimir/pddl/parsers.hpp"
+
+// Test instances
+
+#include "instances/blocks/domain.hpp"
+#include "instances/blocks/problem.hpp"
+#include "instances/gripper/domain.hpp"
+#include "instances/gripper/problem.hpp"
+#include "instances/spanner/domain.hpp"
+#include "instances/spanner/problem.hpp"
+#include "instances/spider/domain.hpp"
+#include "instances/spider/problem.hpp"
+
+#include <gtest/gtest.h>
+#include <set>
+#include <sstream>
+#include <string>
+
+namespace test
+{
+    class DatalogGrounderTest : public testing::TestWithParam<std::tuple<std::string, std::string>>
+    {
+    };
+
+    using GroundActionKey = std::pair<std::string, std::vector<uint32_t>>;
+
+    GroundActionKey get_key(const mimir::formalism::Action& action)
+    {
+        std::vector<uint32_t> argument_ids;
+
+        for (const auto& argument : action->get_arguments())
+        {
+            argument_ids.emplace_back(argument->id);
+        }
+
+        return { action->schema->name, argument_ids };
+    }
+
+    // The ground actions of the fixpoint of the relaxed problem, computed by applying all applicable actions until the state no longer changes
+
+    std::set<GroundActionKey> get_reference_keys(const mimir::formalism::ProblemDescription& problem)
+    {
+        const auto relaxed_domain = relax(problem->domain, true, true);
+        const auto relaxed_problem =
+            mimir::formalism::create_problem(problem->name, relaxed_domain, problem->objects, problem->initial, problem->goal, problem->atom_costs);
+        const mimir::planners::LiftedSuccessorGenerator successor_generator(relaxed_problem);
+        std::equal_to<mimir::formalism::State> equals;
+        auto state = mimir::formalism::create_state(relaxed_problem->initial, relaxed_problem);
+        mimir::formalism::ActionList relaxed_actions;
+
+        while (true)
+        {
+            relaxed_actions = successor_generator.get_applicable_actions(state);
+            auto next_state = state;
+
+            for (const auto& action : relaxed_actions)
+            {
+                next_state = mimir::formalism::apply(action, next_state);
+            }
+
+            if (equals(state, next_state))
+            {
+                break;
+            }
+
+            state = next_state;
+        }
+
+        std::set<GroundActionKey> keys;
+        const auto& static_atoms = problem->get_static_atoms();
+        const auto& static_predicates = problem->domain->static_predicates;
+
+        for (const auto& relaxed_action : relaxed_actions)
+        {
+            bool is_statically_applicable = true;
+
+            for (const auto& schema : problem->domain->action_schemas)
+            {
+                if (schema->name == relaxed_action->schema->name)
+                {
+                    auto arguments = relaxed_action->get_arguments();
+                    const auto action = mimir::formalism::create_action(problem, schema, std::move(arguments), relaxed_action->cost);
+
+                    for (const auto& literal : action->get_precondition())
+                    {
+                        const auto is_static = std::count(static_predicates.begin(), static_predicates.end(), literal->atom->predicate) > 0;
+                        is_statically_applicable &= !(is_static && (static_atoms.contains(literal->atom) == literal->negated));
+                    }
+                }
+            }
+
+            if (is_statically_applicable)
+            {
+                keys.emplace(get_key(relaxed_action));
+            }
+        }
+
+        return keys;
+    }
+
+    TEST_P(DatalogGrounderTest, Parameterized)
+    {
+        const auto domain_text = std::get<0>(GetParam());
+        const auto problem_text = std::get<1>(GetParam());
+
+        std::istringstream domain_stream(domain_text);
+        std::istringstream problem_stream(problem_text);
+
+        const auto domain = mimir::parsers::DomainParser::parse(domain_stream);
+        const auto problem = mimir::parsers::ProblemParser::parse(domain, "", problem_stream);
+
+        mimir::planners::DatalogGrounder grounder(problem);
+        mimir::formalism::ActionList actions;
+        ASSERT_TRUE(grounder.ground(std::chrono::high_resolution_clock::time_point::max(), actions));
+        ASSERT_GT(grounder.get_num_rounds(), 0);
+
+        // Every action is derived exactly once, and the same actions as by the fixpoint of the lifted successor generator
+
+        std::set<GroundActionKey> keys;
+
+        for (const auto& action : actions)
+        {
+            ASSERT_TRUE(keys.emplace(get_key(action)).second);
+        }
+
+        ASSERT_EQ(keys, get_reference_keys(problem));
+
+        // Grounding again yields the same actions in the same order
+
+        mimir::formalism::ActionList other_actions;
+        ASSERT_TRUE(grounder.ground(std::chrono::high_resolution_clock::time_point::max(), other_actions));
+        ASSERT_EQ(other_actions.size(), actions.size());
+
+        for (std::size_t index = 0; index < actions.size(); ++index)
+        {
+            ASSERT_EQ(get_key(other_actions[index]), get_key(actions[index]));
+        }
+
+        // Grounding another instance of the problem in parallel yields the same actions, and ranks their atoms in the same order
+
+        std::istringstream parallel_problem_stream(problem_text);
+        const auto parallel_problem = mimir::parsers::ProblemParser::parse(domain, "", parallel_problem_stream);
+        mimir::planners::DatalogGrounder parallel_grounder(parallel_problem, 4);
+        mimir::formalism::ActionList parallel_actions;
+        ASSERT_TRUE(parallel_grounder.ground(std::chrono::high_resolution_clock::time_point::max(), parallel_actions));
+        ASSERT_EQ(parallel_actions.size(), actions.size());
+        ASSERT_EQ(parallel_problem->num_ranks(), problem->num_ranks());
+
+        for (std::size_t index = 0; index < actions.size(); ++index)
+        {
+            ASSERT_EQ(get_key(parallel_actions[index]), get_key(actions[index]));
+            ASSERT_EQ(parallel_actions[index]->get_precondition().size(), actions[index]->get_precondition().size());
+
+            for (std::size_t literal_index = 0; literal_index < actions[index]->get_precondition().size(); ++literal_index)
+            {
+                ASSERT_EQ(parallel_problem->get_rank(parallel_actions[index]->get_precondition()[literal_index]->atom),
+                          problem->get_rank(actions[index]->get_precondition()[literal_index]->atom));
+            }
+        }
+
+        // An expired time limit stops the grounder
+
+        mimir::formalism::ActionList timed_out_actions;
+        ASSERT_FALSE(grounder.ground(std::chrono::high_resolution_clock::time_point::min(), timed_out_actions));
+    }
+
+    INSTANTIATE_TEST_SUITE_P(ParamTest,
+                             DatalogGrounderTest,
+                             testing::Values(std::make_tuple(blocks::domain, blocks::problem),
+                                             std::make_tuple(gripper::domain, gripper::problem),
+                                             std::make_tuple(spanner::domain, spanner::problem),
+                                             std::make_tuple(spider::domain, spider::problem)));
+}  // namespace test
@@ -0,0 +1,89 @@
+#include "../include/mimir/formalism/bitset.hpp"
+#include "../include/mimir/formalism/fixed_bitset.hpp"
+
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+namespace test
+{
+    class FixedBitsetTest : public testing::TestWithParam<std::size_t>
+    {
+    };
+
+    // Compare the kernels with a scalar reference, odd word counts also cover the scalar tail of the vectorized loops
+
+    TEST_P(FixedBitsetTest, Parameterized)
+    {
+        const auto num_words = GetParam();
+        const auto num_bits = num_words * mimir::formalism::FixedBitset::block_size;
+        std::mt19937_64 random(num_words);
+        std::bernoulli_distribution distribution(0.3);
+
+        for (int32_t repetition = 0; repetition < 32; ++repetition)
+        {
+            mimir::formalism::FixedBitset left(num_bits), right(num_bits), add_effect(num_bits);
+            mimir::formalism::Bitset reference_left(num_bits, false), reference_right(num_bits, false), reference_delete(num_bits, true),
+                reference_add(num_bits, false);
+            std::size_t count = 0;
+
+            for (std::size_t position = 0; position < num_bits; ++position)
+            {
+                if (distribution(random))
+                {
+                    left.set(position);
+                    reference_left.set(position);
+                    ++count;
+                }
+
+                if (distribution(random))
+                {
+                    right.set(position);
+                    reference_right.set(position);
+                    reference_delete.unset(position);
+                }
+
+                if (distribution(random))
+                {
+                    add_effect.set(position);
+                    reference_add.set(position);
+                }
+            }
+
+            ASSERT_EQ(left.count(), count);
+            ASSERT_EQ(left.none(), count == 0);
+            ASSERT_TRUE(left == left);
+            ASSERT_EQ(left == right, reference_left == reference_right);
+            ASSERT_EQ(left.is_subset_of(right), reference_right == (reference_left | reference_right));
+            ASSERT_EQ(left.intersects(right), !((reference_left & reference_right) == mimir::formalism::Bitset(num_bits, false)));
+
+            auto bitwise_and = left;
+            bitwise_and &= right;
+            auto bitwise_or = left;
+            bitwise_or |= right;
+            auto bitwise_andnot = left;
+            bitwise_andnot.andnot(right);
+            auto applied = left;
+            applied.apply_effect(right, add_effect);
+
+            const auto reference_and = reference_left & reference_right;
+            const auto reference_or = reference_left | reference_right;
+            const auto reference_andnot = reference_left & reference_delete;
+            const auto reference_applied = (reference_left & reference_delete) | reference_add;
+
+            for (std::size_t position = 0; position < num_bits; ++position)
+            {
+                ASSERT_EQ(bitwise_and.get(position), reference_and.get(position));
+                ASSERT_EQ(bitwise_or.get(position), reference_or.get(position));
+                ASSERT_EQ(bitwise_andnot.get(position), reference_andnot.get(position));
+                ASSERT_EQ(applied.get(position), reference_applied.get(position));
+            }
+
+            ASSERT_TRUE(bitwise_and.is_subset_of(left));
+            ASSERT_TRUE(left.is_subset_of(bitwise_or));
+            ASSERT_FALSE(bitwise_andnot.intersects(right));
+        }
+    }
+
+    INSTANTIATE_TEST_SUITE_P(ParamTest, FixedBitsetTest, testing::Values(1, 2, 3, 4, 5, 7, 8, 9, 16, 17));
+}  // namespace test
@@ -64,4 +64,41 @@ namespace test
 
         ASSERT_EQ(cost, 0);
     }
+
+    TEST(Ground, UniqueAtoms)
+    {
+        std::istringstream domain_stream(gripper::domain);
+        std::istringstream problem_stream(gripper::problem);
+
+        const auto domain = mimir::parsers::DomainParser::parse(domain_stream);
+        const auto problem = mimir::parsers::ProblemParser::parse(domain, "", problem_stream);
+        const auto other_problem = problem->replace_initial(problem->initial);
+        std::equal_to<mimir::formalism::Atom> atom_equals;
+
+        for (const auto& atom : problem->initial)
+        {
+            // The problem hands out a single atom and literal per ground atom, and parsed atoms keep their rank
+
+            const auto rank = problem->get_rank(atom);
+            const auto unique_atom = problem->create_atom(atom->predicate, mimir::formalism::ObjectList(atom->arguments));
+            ASSERT_EQ(unique_atom, problem->create_atom(atom->predicate, mimir::formalism::ObjectList(atom->arguments)));
+            ASSERT_EQ(problem->get_rank(unique_atom), rank);
+            ASSERT_EQ(problem->get_atom(rank), unique_atom);
+            ASSERT_TRUE(atom_equals(unique_atom, atom));
+            ASSERT_EQ(problem->create_literal(atom, true), problem->create_literal(unique_atom, true));
+            ASSERT_NE(problem->create_literal(atom, true), problem->create_literal(atom, false));
+
+            // Another problem ranks the same atoms on its own
+
+            ASSERT_EQ(other_problem->get_rank(unique_atom), other_problem->get_rank(atom));
+        }
+
+        for (const auto& first_atom : problem->initial)
+        {
+            for (const auto& second_atom : problem->initial)
+            {
+                ASSERT_EQ(atom_equals(first_atom, second_atom), problem->get_rank(first_atom) == problem->get_rank(second_atom));
+            }
+        }
+    }
 }  // namespace test
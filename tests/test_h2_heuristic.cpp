@@ -0,0 +1,208 @@
+#include "../include/mimir/formalism/domain.hpp"
+#include "../include/mimir/formalism/problem.hpp"
+#include "../include/mimir/generators/complete_state_space.hpp"
+#include "../include/mimir/generators/grounded_successor_generator.hpp"
+#include "../include/mimir/generators/successor_generator_factory.hpp"
+#include "../include/mimir/pddl/parsers.hpp"
+#include "../include/mimir/search/heuristics/h2_heuristic.hpp"
+
+// Test instances
+
+#include "instances/blocks/domain.hpp"
+#include "instances/blocks/problem.hpp"
+#include "instances/gripper/domain.hpp"
+#include "instances/gripper/problem.hpp"
+#include "instances/spanner/domain.hpp"
+#include "instances/spanner/problem.hpp"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <limits>
+#include <sstream>
+#include <string>
+
+namespace test
+{
+    class H2HeuristicTest : public testing::TestWithParam<std::tuple<std::string, std::string>>
+    {
+    };
+
+    // Computes h^2 with a dense table over all ranks by applying all actions until the costs of the pairs no longer change
+
+    double get_reference_value(const mimir::formalism::ActionList& actions, const mimir::formalism::State& state)
+    {
+        const auto problem = state->get_problem();
+        const auto num_ranks = problem->num_ranks();
+        const auto infinity = std::numeric_limits<double>::infinity();
+        std::vector<std::vector<double>> costs(num_ranks, std::vector<double>(num_ranks, infinity));
+        const auto ranks = state->get_ranks();
+
+        for (const auto rank1 : ranks)
+        {
+            for (const auto rank2 : ranks)
+            {
+                costs[rank1][rank2] = 0.0;
+            }
+        }
+
+        const auto get_cost = [&costs](const std::vector<uint32_t>& ranks)
+        {
+            double cost = 0.0;
+
+            for (const auto rank1 : ranks)
+            {
+                for (const auto rank2 : ranks)
+                {
+                    cost = std::max(cost, costs[rank1][rank2]);
+                }
+            }
+
+            return cost;
+        };
+
+        bool changed = true;
+
+        while (changed)
+        {
+            changed = false;
+
+            for (const auto& action : actions)
+            {
+                std::vector<uint32_t> precondition;
+                std::vector<uint32_t> add_effect;
+                std::vector<bool> is_deleted(num_ranks, false);
+
+                for (const auto& literal : action->get_precondition())
+                {
+                    if (!literal->negated)
+                    {
+                        precondition.emplace_back(problem->get_rank(literal->atom));
+                    }
+                }
+
+                auto effects = action->get_unconditional_effect();
+
+                for (const auto& [antecedent, consequence] : action->get_conditional_effect())
+                {
+                    effects.insert(effects.end(), consequence.begin(), consequence.end());
+                }
+
+                for (const auto& literal : effects)
+                {
+                    const auto rank = problem->get_rank(literal->atom);
+
+                    if (literal->negated)
+                    {
+                        is_deleted[rank] = true;
+                    }
+                    else
+                    {
+                        add_effect.emplace_back(rank);
+                    }
+                }
+
+                const auto precondition_cost = get_cost(precondition);
+
+                const auto update = [&costs, &changed](uint32_t rank1, uint32_t rank2, double cost)
+                {
+                    if (cost < costs[rank1][rank2])
+                    {
+                        costs[rank1][rank2] = cost;
+                        costs[rank2][rank1] = cost;
+                        changed = true;
+                    }
+                };
+
+                for (const auto rank1 : add_effect)
+                {
+                    for (const auto rank2 : add_effect)
+                    {
+                        update(rank1, rank2, precondition_cost + action->cost);
+                    }
+
+                    for (uint32_t rank2 = 0; rank2 < num_ranks; ++rank2)
+                    {
+                        if (!is_deleted[rank2])
+                        {
+                            auto extended_precondition = precondition;
+                            extended_precondition.emplace_back(rank2);
+                            update(rank1, rank2, get_cost(extended_precondition) + action->cost);
+                        }
+                    }
+                }
+            }
+        }
+
+        std::vector<uint32_t> goal;
+
+        for (const auto& literal : problem->goal)
+        {
+            goal.emplace_back(problem->get_rank(literal->atom));
+        }
+
+        return get_cost(goal);
+    }
+
+    TEST_P(H2HeuristicTest, Parameterized)
+    {
+        const auto domain_text = std::get<0>(GetParam());
+        const auto problem_text = std::get<1>(GetParam());
+
+        std::istringstream domain_stream(domain_text);
+        std::istringstream problem_stream(problem_text);
+
+        const auto domain = mimir::parsers::DomainParser::parse(domain_stream);
+        const auto problem = mimir::parsers::ProblemParser::parse(domain, "", problem_stream);
+
+        const auto successor_generator = mimir::planners::create_sucessor_generator(problem, mimir::planners::SuccessorGeneratorType::GROUNDED);
+        const auto grounded_generator = std::dynamic_pointer_cast<mimir::planners::GroundedSuccessorGenerator>(successor_generator);
+        const auto& actions = grounded_generator->get_actions();
+        const auto state_space = mimir::planners::create_complete_state_space(problem, successor_generator);
+
+        const auto h2 = mimir::planners::create_h2_heuristic(problem, successor_generator);
+        const auto pruned_h2 = mimir::planners::create_h2_heuristic(problem, successor_generator, true);
+
+        ASSERT_LE(pruned_h2->get_table_size(), h2->get_table_size());
+
+        for (const auto& state : state_space->get_states())
+        {
+            const auto value = h2->evaluate(state);
+            const auto pruned_value = pruned_h2->evaluate(state);
+            const auto distance = state_space->get_distance_to_goal_state(state);
+
+            ASSERT_EQ(value, get_reference_value(actions, state));
+            ASSERT_LE(value, pruned_value);
+
+            if (distance < 0)
+            {
+                continue;
+            }
+
+            ASSERT_LE(pruned_value, distance);
+        }
+
+        // Batched evaluation yields the same values as evaluating the states one by one
+
+        const auto& states = state_space->get_states();
+        const auto memory_usage = h2->get_memory_usage();
+        const auto values = h2->evaluate(states);
+        const auto pruned_values = pruned_h2->evaluate(states);
+        ASSERT_EQ(values.size(), states.size());
+
+        // The table of a batch is released once the batch is evaluated
+        ASSERT_EQ(h2->get_memory_usage(), memory_usage);
+        ASSERT_EQ(pruned_values.size(), states.size());
+
+        for (std::size_t index = 0; index < states.size(); ++index)
+        {
+            ASSERT_EQ(values[index], h2->evaluate(states[index]));
+            ASSERT_EQ(pruned_values[index], pruned_h2->evaluate(states[index]));
+        }
+    }
+
+    INSTANTIATE_TEST_SUITE_P(ParamTest,
+                             H2HeuristicTest,
+                             testing::Values(std::make_tuple(blocks::domain, blocks::problem),
+                                             std::make_tuple(gripper::domain, gripper::problem),
+                                             std::make_tuple(spanner::domain, spanner::problem)));
+}  // namespace test
@@ -0,0 +1,126 @@
+#include "../include/mimir/algorithms/kpkc.hpp"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+namespace test
+{
+    class KPKCTest : public testing::TestWithParam<std::tuple<std::size_t, std::size_t, double>>
+    {
+    };
+
+    std::vector<std::vector<std::size_t>> sort_cliques(std::vector<std::vector<std::size_t>> cliques)
+    {
+        for (auto& clique : cliques)
+        {
+            std::sort(clique.begin(), clique.end());
+        }
+
+        std::sort(cliques.begin(), cliques.end());
+        return cliques;
+    }
+
+    // Try every combination of one vertex per partition
+
+    void find_cliques_by_brute_force(const mimir::algorithms::FlatAdjacencyMatrix& adjacency_matrix,
+                                     const std::vector<std::vector<std::size_t>>& partitions,
+                                     std::vector<std::size_t>& partial_clique,
+                                     std::vector<std::vector<std::size_t>>& out_cliques)
+    {
+        if (partial_clique.size() == partitions.size())
+        {
+            out_cliques.push_back(partial_clique);
+            return;
+        }
+
+        for (const auto vertex : partitions[partial_clique.size()])
+        {
+            if (std::all_of(partial_clique.begin(),
+                            partial_clique.end(),
+                            [&adjacency_matrix, vertex](std::size_t other_vertex) { return adjacency_matrix.has_edge(vertex, other_vertex); }))
+            {
+                partial_clique.push_back(vertex);
+                find_cliques_by_brute_force(adjacency_matrix, partitions, partial_clique, out_cliques);
+                partial_clique.pop_back();
+            }
+        }
+    }
+
+    TEST_P(KPKCTest, Parameterized)
+    {
+        const auto k = std::get<0>(GetParam());
+        const auto partition_size = std::get<1>(GetParam());
+        const auto edge_probability = std::get<2>(GetParam());
+
+        std::vector<std::vector<std::size_t>> partitions(k);
+        const auto num_vertices = k * partition_size;
+
+        for (std::size_t vertex = 0; vertex < num_vertices; ++vertex)
+        {
+            partitions[vertex / partition_size].push_back(vertex);
+        }
+
+        std::mt19937_64 random(k * partition_size);
+        std::bernoulli_distribution has_edge(edge_probability);
+        const auto no_time_limit = std::chrono::high_resolution_clock::time_point::max();
+        mimir::algorithms::KPartiteCliqueEnumerator enumerator(partitions);
+        mimir::algorithms::FlatAdjacencyMatrix flat_matrix(num_vertices);
+
+        for (int32_t repetition = 0; repetition < 8; ++repetition)
+        {
+            flat_matrix.clear();
+
+            for (std::size_t first_vertex = 0; first_vertex < num_vertices; ++first_vertex)
+            {
+                for (std::size_t second_vertex = first_vertex + 1; second_vertex < num_vertices; ++second_vertex)
+                {
+                    if (((first_vertex / partition_size) != (second_vertex / partition_size)) && has_edge(random))
+                    {
+                        flat_matrix.add_edge(first_vertex, second_vertex);
+                    }
+                }
+            }
+
+            std::vector<std::vector<std::size_t>> expected_cliques;
+            std::vector<std::size_t> partial_clique;
+            find_cliques_by_brute_force(flat_matrix, partitions, partial_clique, expected_cliques);
+
+            std::vector<std::vector<std::size_t>> cliques;
+            ASSERT_TRUE(enumerator.enumerate(no_time_limit,
+                                             flat_matrix,
+                                             [&cliques](const std::vector<std::size_t>& clique)
+                                             {
+                                                 cliques.push_back(clique);
+                                                 return true;
+                                             }));
+
+            ASSERT_EQ(sort_cliques(cliques), sort_cliques(expected_cliques));
+
+            // Stopping the enumeration from the callback
+
+            if (cliques.size() > 1)
+            {
+                std::size_t num_streamed = 0;
+                ASSERT_FALSE(enumerator.enumerate(no_time_limit,
+                                                  flat_matrix,
+                                                  [&num_streamed](const std::vector<std::size_t>&)
+                                                  {
+                                                      ++num_streamed;
+                                                      return false;
+                                                  }));
+                ASSERT_EQ(num_streamed, 1);
+            }
+        }
+    }
+
+    INSTANTIATE_TEST_SUITE_P(ParamTest,
+                             KPKCTest,
+                             testing::Values(std::make_tuple(2, 5, 0.5),
+                                             std::make_tuple(2, 70, 0.1),
+                                             std::make_tuple(3, 10, 0.4),
+                                             std::make_tuple(3, 50, 0.1),
+                                             std::make_tuple(4, 17, 0.4),
+                                             std::make_tuple(5, 9, 0.6)));
+}  // namespace test
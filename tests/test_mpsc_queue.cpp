@@ -0,0 +1,51 @@
+#include "../include/mimir/algorithms/mpsc_queue.hpp"
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+namespace test
+{
+    TEST(MpscQueueTest, ConcurrentProducers)
+    {
+        const int32_t num_producers = 4;
+        const int32_t num_values = 10000;
+        mimir::algorithms::MpscQueue<std::vector<int32_t>> queue;
+        std::vector<std::thread> producers;
+
+        for (int32_t producer = 0; producer < num_producers; ++producer)
+        {
+            producers.emplace_back(
+                [&queue, producer]()
+                {
+                    for (int32_t value = 0; value < num_values; ++value)
+                    {
+                        queue.push(std::vector<int32_t> { producer, value });
+                    }
+                });
+        }
+
+        // The values of every producer arrive in the order in which they were pushed
+
+        std::vector<int32_t> next_values(num_producers, 0);
+        std::vector<int32_t> entry;
+        int32_t num_popped = 0;
+
+        while (num_popped < num_producers * num_values)
+        {
+            if (queue.pop(entry))
+            {
+                ASSERT_EQ(entry.size(), 2);
+                ASSERT_EQ(entry[1], next_values[entry[0]]++);
+                ++num_popped;
+            }
+        }
+
+        for (auto& producer : producers)
+        {
+            producer.join();
+        }
+
+        ASSERT_FALSE(queue.pop(entry));
+    }
+}  // namespace test
@@ -0,0 +1,285 @@
+#include "../include/mimir/search/openlists/alternation_open_list.hpp"
+#include "../include/mimir/search/openlists/bucket_open_list.hpp"
+#include "../include/mimir/search/openlists/epsilon_greedy_open_list.hpp"
+#include "../include/mimir/search/openlists/indexed_heap_open_list.hpp"
+#include "../include/mimir/search/openlists/priority_queue_open_list.hpp"
+#include "../include/mimir/search/openlists/tie_breaking_open_list.hpp"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace test
+{
+    TEST(OpenListTest, BucketOpenList)
+    {
+        const auto open_list = mimir::planners::create_bucket_open_list();
+        std::multiset<std::pair<int32_t, int32_t>> reference;
+        std::vector<std::pair<int32_t, int32_t>> keys;
+        std::mt19937 random_generator(0);
+
+        // Items are popped in the order of their priority and tie-breaker, even if lower priorities are inserted after higher ones were popped
+
+        for (int32_t step = 0; step < 10000; ++step)
+        {
+            if ((reference.size() > 0) && (random_generator() % 3 == 0))
+            {
+                const auto item = open_list->pop();
+                ASSERT_EQ(keys[item], *reference.begin());
+                reference.erase(reference.begin());
+            }
+            else
+            {
+                const auto priority = static_cast<int32_t>(random_generator() % 50);
+                const auto tie_breaker = static_cast<int32_t>(random_generator() % 10);
+                const auto item = static_cast<int32_t>(keys.size());
+                keys.emplace_back(priority, tie_breaker);
+                reference.emplace(priority, tie_breaker);
+                open_list->insert(item, priority, tie_breaker);
+            }
+
+            ASSERT_EQ(open_list->size(), reference.size());
+        }
+
+        while (reference.size() > 0)
+        {
+            ASSERT_EQ(keys[open_list->pop()], *reference.begin());
+            reference.erase(reference.begin());
+        }
+
+        ASSERT_EQ(open_list->size(), 0);
+        ASSERT_THROW(open_list->pop(), std::runtime_error);
+        ASSERT_THROW(open_list->insert(0, 1.5), std::invalid_argument);
+        ASSERT_THROW(open_list->insert(0, -1.0), std::invalid_argument);
+    }
+
+    TEST(OpenListTest, BucketOpenListLargePriorities)
+    {
+        const auto open_list = mimir::planners::create_bucket_open_list();
+
+        // Only the ranges of the priorities and tie-breakers take memory, so values near the largest integer are cheap
+
+        const auto max_value = static_cast<double>(std::numeric_limits<int32_t>::max());
+        open_list->insert(0, max_value, max_value);
+        open_list->insert(1, max_value - 2.0, max_value - 3.0);
+        open_list->insert(2, max_value, max_value - 1.0);
+        open_list->insert(3, max_value - 2.0, max_value - 2.0);
+        open_list->insert(5, max_value - 2.0, max_value - 5.0);
+
+        ASSERT_EQ(open_list->pop(), 5);
+        ASSERT_EQ(open_list->pop(), 1);
+        ASSERT_EQ(open_list->pop(), 3);
+        open_list->insert(4, max_value - 1.0, max_value);
+        ASSERT_EQ(open_list->pop(), 4);
+        ASSERT_EQ(open_list->pop(), 2);
+        ASSERT_EQ(open_list->pop(), 0);
+        ASSERT_EQ(open_list->size(), 0);
+        ASSERT_THROW(open_list->insert(0, max_value + 1.0), std::invalid_argument);
+    }
+
+    TEST(OpenListTest, PriorityQueueOpenList)
+    {
+        const auto open_list = mimir::planners::create_priority_queue_open_list();
+
+        // The tie-breaker is ignored
+
+        open_list->insert(0, 2.0, 0.0);
+        open_list->insert(1, 1.0, 5.0);
+        open_list->insert(2, 1.5);
+
+        ASSERT_EQ(open_list->pop(), 1);
+        ASSERT_EQ(open_list->pop(), 2);
+        ASSERT_EQ(open_list->pop(), 0);
+        ASSERT_EQ(open_list->size(), 0);
+    }
+
+    TEST(OpenListTest, TieBreakingOpenList)
+    {
+        const auto open_list = mimir::planners::create_tie_breaking_open_list(3);
+        std::set<std::tuple<int32_t, int32_t, int32_t, int32_t>> reference;
+        std::vector<std::tuple<int32_t, int32_t, int32_t>> keys;
+        std::mt19937 random_generator(0);
+
+        // Items are popped in lexicographic order of their keys, and first in, first out on equal keys
+
+        for (int32_t step = 0; step < 10000; ++step)
+        {
+            if ((reference.size() > 0) && (random_generator() % 3 == 0))
+            {
+                const auto item = open_list->pop();
+                const auto& expected = *reference.begin();
+                ASSERT_EQ(item, std::get<3>(expected));
+                reference.erase(reference.begin());
+            }
+            else
+            {
+                const auto item = static_cast<int32_t>(keys.size());
+                keys.emplace_back(random_generator() % 10, random_generator() % 5, random_generator() % 3);
+                const auto [first, second, third] = keys.back();
+                reference.emplace(first, second, third, item);
+
+                if (third == 0)
+                {
+                    open_list->insert(item, first, second);
+                }
+                else
+                {
+                    open_list->insert(item, std::vector<double> { static_cast<double>(first), static_cast<double>(second), static_cast<double>(third) });
+                }
+            }
+
+            ASSERT_EQ(open_list->size(), reference.size());
+        }
+
+        ASSERT_THROW(open_list->insert(0, std::vector<double> { 0.0, 0.0, 0.0, 0.0 }), std::invalid_argument);
+    }
+
+    TEST(OpenListTest, AlternationOpenList)
+    {
+        const auto first_open_list = mimir::planners::create_priority_queue_open_list();
+        const auto second_open_list = mimir::planners::create_priority_queue_open_list();
+        const auto open_list = mimir::planners::create_alternation_open_list({ first_open_list, second_open_list });
+
+        // Items inserted into every sub-list are popped once per sub-list, alternating between them
+
+        open_list->insert(0, 1.0);
+        open_list->insert(1, 2.0);
+        open_list->insert_into(1, 2, 0.0);
+        ASSERT_EQ(open_list->size(), 5);
+
+        ASSERT_EQ(open_list->pop(), 0);
+        ASSERT_EQ(open_list->pop(), 2);
+        ASSERT_EQ(open_list->pop(), 1);
+        ASSERT_EQ(open_list->pop(), 0);
+        ASSERT_EQ(open_list->pop(), 1);
+        ASSERT_EQ(open_list->size(), 0);
+
+        ASSERT_THROW(open_list->pop(), std::runtime_error);
+
+        // A boosted sub-list is popped that many more times in a row, and empty sub-lists are skipped
+
+        const auto boosted_open_list = mimir::planners::create_alternation_open_list({ mimir::planners::create_priority_queue_open_list(),
+                                                                                       mimir::planners::create_priority_queue_open_list() });
+
+        for (int32_t item = 0; item < 4; ++item)
+        {
+            boosted_open_list->insert_into(0, item, item);
+            boosted_open_list->insert_into(1, 4 + item, item);
+        }
+
+        boosted_open_list->boost(1, 2);
+
+        for (const auto expected_item : { 4, 5, 0, 6, 1, 7, 2, 3 })
+        {
+            ASSERT_EQ(boosted_open_list->pop(), expected_item);
+        }
+    }
+
+    TEST(OpenListTest, EpsilonGreedyOpenList)
+    {
+        // Without random choices, the list pops by priority and tie-breaker
+
+        const auto greedy_open_list = mimir::planners::create_epsilon_greedy_open_list(0.0);
+        greedy_open_list->insert(0, 1.0, 1.0);
+        greedy_open_list->insert(1, 1.0, 0.0);
+        greedy_open_list->insert(2, 0.0, 5.0);
+
+        ASSERT_EQ(greedy_open_list->pop(), 2);
+        ASSERT_EQ(greedy_open_list->pop(), 1);
+        ASSERT_EQ(greedy_open_list->pop(), 0);
+
+        // With random choices, every item is still popped exactly once, and some are popped out of order
+
+        const auto open_list = mimir::planners::create_epsilon_greedy_open_list(0.5, 1);
+        const int32_t num_items = 1000;
+
+        for (int32_t item = 0; item < num_items; ++item)
+        {
+            open_list->insert(item, item);
+        }
+
+        std::vector<int32_t> popped_items;
+
+        while (open_list->size() > 0)
+        {
+            popped_items.emplace_back(open_list->pop());
+        }
+
+        ASSERT_FALSE(std::is_sorted(popped_items.begin(), popped_items.end()));
+        std::sort(popped_items.begin(), popped_items.end());
+
+        for (int32_t item = 0; item < num_items; ++item)
+        {
+            ASSERT_EQ(popped_items[item], item);
+        }
+
+        ASSERT_THROW(mimir::planners::create_epsilon_greedy_open_list(1.5), std::invalid_argument);
+    }
+    TEST(OpenListTest, IndexedHeapOpenList)
+    {
+        for (const std::size_t arity : { 2, 4, 7 })
+        {
+            const auto open_list = mimir::planners::create_indexed_heap_open_list(arity);
+            std::set<std::tuple<int32_t, int32_t, int32_t>> reference;
+            std::vector<std::pair<int32_t, int32_t>> keys(500, std::make_pair(-1, -1));
+            std::mt19937 random_generator(0);
+
+            // Every item is in the heap at most once, and lowering its key moves it forward
+
+            for (int32_t step = 0; step < 20000; ++step)
+            {
+                const auto item = static_cast<int32_t>(random_generator() % keys.size());
+                const auto priority = static_cast<int32_t>(random_generator() % 100);
+                const auto tie_breaker = static_cast<int32_t>(random_generator() % 10);
+                auto& [item_priority, item_tie_breaker] = keys[item];
+
+                if ((reference.size() > 0) && (random_generator() % 3 == 0))
+                {
+                    const auto popped_item = open_list->pop();
+                    const auto [expected_priority, expected_tie_breaker, expected_item] = *reference.begin();
+                    ASSERT_EQ(popped_item, expected_item);
+                    ASSERT_FALSE(open_list->contains(popped_item));
+                    reference.erase(reference.begin());
+
+                    // Popped items may be inserted again
+
+                    keys[popped_item] = std::make_pair(-1, -1);
+                }
+                else if (!open_list->contains(item))
+                {
+                    ASSERT_EQ(item_priority, -1);
+                    open_list->insert(item, priority, tie_breaker);
+                    reference.emplace(priority, tie_breaker, item);
+                    item_priority = priority;
+                    item_tie_breaker = tie_breaker;
+                }
+                else if (std::make_pair(priority, tie_breaker) <= std::make_pair(item_priority, item_tie_breaker))
+                {
+                    open_list->decrease_key(item, priority, tie_breaker);
+                    reference.erase(std::make_tuple(item_priority, item_tie_breaker, item));
+                    reference.emplace(priority, tie_breaker, item);
+                    item_priority = priority;
+                    item_tie_breaker = tie_breaker;
+                }
+                else
+                {
+                    ASSERT_THROW(open_list->decrease_key(item, priority, tie_breaker), std::invalid_argument);
+                    ASSERT_THROW(open_list->insert(item, priority, tie_breaker), std::invalid_argument);
+                }
+
+                ASSERT_EQ(open_list->size(), reference.size());
+            }
+        }
+
+        ASSERT_TRUE(mimir::planners::create_indexed_heap_open_list()->supports_decrease_key());
+        ASSERT_FALSE(mimir::planners::create_priority_queue_open_list()->supports_decrease_key());
+        ASSERT_THROW(mimir::planners::create_priority_queue_open_list()->decrease_key(0, 0.0, 0.0), std::logic_error);
+    }
+}  // namespace test
@@ -0,0 +1,186 @@
+#include "../include/mimir/formalism/domain.hpp"
+#include "../include/mimir/formalism/problem.hpp"
+#include "../include/mimir/generators/complete_state_space.hpp"
+#include "../include/mimir/generators/successor_generator_factory.hpp"
+#include "../include/mimir/pddl/parsers.hpp"
+#include "../include/mimir/search/heuristics/pdb_heuristic.hpp"
+
+// Test instances
+
+#include "instances/blocks/domain.hpp"
+#include "instances/blocks/problem.hpp"
+#include "instances/gripper/domain.hpp"
+#include "instances/gripper/problem.hpp"
+#include "instances/spanner/domain.hpp"
+#include "instances/spanner/problem.hpp"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace test
+{
+    class PDBHeuristicTest : public testing::TestWithParam<std::tuple<std::string, std::string>>
+    {
+    };
+
+    TEST_P(PDBHeuristicTest, Parameterized)
+    {
+        const auto domain_text = std::get<0>(GetParam());
+        const auto problem_text = std::get<1>(GetParam());
+
+        std::istringstream domain_stream(domain_text);
+        std::istringstream problem_stream(problem_text);
+
+        const auto domain = mimir::parsers::DomainParser::parse(domain_stream);
+        const auto problem = mimir::parsers::ProblemParser::parse(domain, "", problem_stream);
+
+        const auto successor_generator = mimir::planners::create_sucessor_generator(problem, mimir::planners::SuccessorGeneratorType::GROUNDED);
+        const auto state_space = mimir::planners::create_complete_state_space(problem, successor_generator);
+
+        // One pattern with all dynamic goal atoms, and the goal atoms in separate patterns
+
+        std::vector<int32_t> goal_pattern;
+
+        for (const auto& literal : problem->goal)
+        {
+            const auto rank = problem->get_rank(literal->atom);
+
+            if (!problem->is_static(rank))
+            {
+                goal_pattern.emplace_back(static_cast<int32_t>(rank));
+            }
+        }
+
+        std::vector<std::vector<int32_t>> goal_patterns;
+
+        for (const auto rank : goal_pattern)
+        {
+            goal_patterns.push_back({ rank });
+        }
+
+        const auto goal_pdb = mimir::planners::create_pdb_heuristic(problem, successor_generator, { goal_pattern });
+        const auto canonical_pdb = mimir::planners::create_pdb_heuristic(problem, successor_generator, goal_patterns);
+        const auto hill_climbing_pdb = mimir::planners::create_hill_climbing_pdb_heuristic(problem, successor_generator, 1 << 10, 1 << 12, 50);
+
+        std::size_t num_abstract_states = 0;
+
+        for (const auto& pattern : hill_climbing_pdb->get_patterns())
+        {
+            ASSERT_LE(1 << pattern.size(), 1 << 10);
+            num_abstract_states += 1 << pattern.size();
+        }
+
+        ASSERT_LE(num_abstract_states, 1 << 12);
+        ASSERT_GE(hill_climbing_pdb->get_patterns().size(), goal_patterns.size());
+
+        for (const auto& state : state_space->get_states())
+        {
+            const auto distance = state_space->get_distance_to_goal_state(state);
+            const auto goal_value = goal_pdb->evaluate(state);
+            const auto canonical_value = canonical_pdb->evaluate(state);
+            const auto hill_climbing_value = hill_climbing_pdb->evaluate(state);
+
+            if (state_space->is_goal_state(state))
+            {
+                ASSERT_EQ(goal_value, 0.0);
+                ASSERT_EQ(canonical_value, 0.0);
+                ASSERT_EQ(hill_climbing_value, 0.0);
+            }
+
+            if (distance >= 0)
+            {
+                ASSERT_LE(goal_value, distance);
+                ASSERT_LE(canonical_value, distance);
+                ASSERT_LE(hill_climbing_value, distance);
+            }
+
+            ASSERT_LE(canonical_value, hill_climbing_value);
+        }
+    }
+
+    TEST_P(PDBHeuristicTest, Builder)
+    {
+        const auto domain_text = std::get<0>(GetParam());
+        const auto problem_text = std::get<1>(GetParam());
+
+        std::istringstream domain_stream(domain_text);
+        std::istringstream problem_stream(problem_text);
+
+        const auto domain = mimir::parsers::DomainParser::parse(domain_stream);
+        const auto problem = mimir::parsers::ProblemParser::parse(domain, "", problem_stream);
+
+        const auto successor_generator = mimir::planners::create_sucessor_generator(problem, mimir::planners::SuccessorGeneratorType::GROUNDED);
+        const auto state_space = mimir::planners::create_complete_state_space(problem, successor_generator);
+
+        // Patterns of two consecutive dynamic atoms
+
+        std::vector<std::vector<int32_t>> patterns;
+
+        for (uint32_t rank = 0; rank + 1 < problem->num_ranks(); rank += 2)
+        {
+            if (!problem->is_static(rank))
+            {
+                patterns.push_back({ static_cast<int32_t>(rank), static_cast<int32_t>(rank + 1) });
+            }
+        }
+
+        const auto sequential_pdb = mimir::planners::create_pdb_heuristic(problem, successor_generator, patterns);
+
+        // Patterns with too many abstract states are errors without a builder
+
+        ASSERT_THROW(mimir::planners::create_pdb_heuristic(problem, successor_generator, { std::vector<int32_t>(32, patterns.front().front()) }),
+                     std::invalid_argument);
+
+        std::size_t num_notifications = 0;
+        const auto cache_directory = testing::TempDir();
+        mimir::planners::PDBBuilder parallel_builder(4, std::numeric_limits<std::size_t>::max(), cache_directory);
+        parallel_builder.register_handler([&num_notifications]() { ++num_notifications; });
+        const auto parallel_pdb = mimir::planners::create_pdb_heuristic(problem, successor_generator, patterns, parallel_builder);
+
+        ASSERT_EQ(num_notifications, (patterns.size() + 3) / 4);
+        ASSERT_EQ(std::get<int32_t>(parallel_builder.get_statistics().at("rejected")), 0);
+        ASSERT_EQ(parallel_pdb->get_patterns(), patterns);
+
+        // A second builder loads the tables that the first one persisted
+
+        mimir::planners::PDBBuilder cached_builder(2, std::numeric_limits<std::size_t>::max(), cache_directory);
+        const auto cached_pdb = mimir::planners::create_pdb_heuristic(problem, successor_generator, patterns, cached_builder);
+
+        ASSERT_EQ(std::get<int32_t>(cached_builder.get_statistics().at("loaded")), static_cast<int32_t>(patterns.size()));
+        ASSERT_EQ(std::get<int32_t>(cached_builder.get_statistics().at("built")), 0);
+
+        // The search of two atoms reserves 24 bytes per abstract state and leaves a table of four bytes, so a budget of 100 bytes fits two tables
+
+        mimir::planners::PDBBuilder budget_builder(1, 100);
+        const auto budget_pdb = mimir::planners::create_pdb_heuristic(problem, successor_generator, patterns, budget_builder);
+
+        ASSERT_EQ(budget_pdb->get_patterns().size(), std::min<std::size_t>(2, patterns.size()));
+        ASSERT_LE(budget_pdb->get_memory_usage(), 100);
+
+        // A budget that fits the table but not the search rejects the pattern before it is built
+
+        mimir::planners::PDBBuilder small_builder(1, 95);
+        const auto tables = small_builder.build(*budget_pdb, { patterns.front() });
+
+        ASSERT_FALSE(tables.front().has_value());
+        ASSERT_EQ(std::get<int32_t>(small_builder.get_statistics().at("built")), 0);
+
+        for (const auto& state : state_space->get_states())
+        {
+            const auto value = sequential_pdb->evaluate(state);
+            ASSERT_EQ(value, parallel_pdb->evaluate(state));
+            ASSERT_EQ(value, cached_pdb->evaluate(state));
+            ASSERT_LE(budget_pdb->evaluate(state), value);
+        }
+    }
+
+    INSTANTIATE_TEST_SUITE_P(ParamTest,
+                             PDBHeuristicTest,
+                             testing::Values(std::make_tuple(blocks::domain, blocks::problem),
+                                             std::make_tuple(gripper::domain, gripper::problem),
+                                             std::make_tuple(spanner::domain, spanner::problem)));
+}  // namespace test
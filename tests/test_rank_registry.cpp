@@ -0,0 +1,185 @@
+#include "../include/mimir/formalism/domain.hpp"
+#include "../include/mimir/formalism/problem.hpp"
+#include "../include/mimir/formalism/type.hpp"
+#include "../include/mimir/pddl/parsers.hpp"
+
+// Test instances
+
+#include "instances/spider/domain.hpp"
+#include "instances/spider/problem.hpp"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace test
+{
+    using AtomKey = std::pair<mimir::formalism::Predicate, std::vector<uint32_t>>;
+
+    // All atoms of predicates with at most two parameters whose arguments are among the first type-compatible objects of every position
+
+    std::vector<AtomKey> get_atom_keys(const mimir::formalism::ProblemDescription& problem, std::size_t num_objects)
+    {
+        std::vector<AtomKey> keys;
+
+        for (const auto& predicate : problem->domain->predicates)
+        {
+            if (predicate->arity > 2)
+            {
+                continue;
+            }
+
+            std::vector<std::vector<uint32_t>> compatible_object_ids;
+
+            for (const auto& parameter : predicate->parameters)
+            {
+                auto& object_ids = compatible_object_ids.emplace_back();
+
+                for (const auto& object : problem->objects)
+                {
+                    if ((object_ids.size() < num_objects) && mimir::formalism::is_subtype_of(object->type, parameter->type))
+                    {
+                        object_ids.emplace_back(object->id);
+                    }
+                }
+            }
+
+            if (predicate->arity == 0)
+            {
+                keys.emplace_back(predicate, std::vector<uint32_t>());
+            }
+            else if (predicate->arity == 1)
+            {
+                for (const auto object_id : compatible_object_ids[0])
+                {
+                    keys.emplace_back(predicate, std::vector<uint32_t> { object_id });
+                }
+            }
+            else
+            {
+                for (const auto first_object_id : compatible_object_ids[0])
+                {
+                    for (const auto second_object_id : compatible_object_ids[1])
+                    {
+                        keys.emplace_back(predicate, std::vector<uint32_t> { first_object_id, second_object_id });
+                    }
+                }
+            }
+        }
+
+        return keys;
+    }
+
+    // Create, rank and look up the given atoms from several threads at once, every thread in another order
+
+    void rank_concurrently(const mimir::formalism::ProblemDescription& problem, const std::vector<AtomKey>& keys, std::size_t num_threads)
+    {
+        std::vector<std::thread> threads;
+
+        for (std::size_t thread_index = 0; thread_index < num_threads; ++thread_index)
+        {
+            threads.emplace_back(
+                [&problem, &keys, thread_index]()
+                {
+                    std::vector<std::size_t> order(keys.size());
+                    std::iota(order.begin(), order.end(), 0);
+                    std::shuffle(order.begin(), order.end(), std::mt19937(static_cast<uint32_t>(thread_index)));
+
+                    for (const auto key_index : order)
+                    {
+                        const auto& [predicate, argument_ids] = keys[key_index];
+                        mimir::formalism::ObjectList arguments;
+
+                        for (const auto object_id : argument_ids)
+                        {
+                            arguments.emplace_back(problem->get_object(object_id));
+                        }
+
+                        const auto atom = problem->create_atom(predicate, std::move(arguments));
+                        problem->create_literal(atom, (key_index + thread_index) % 2 == 0);
+
+                        // Atoms that are not created by the problem are looked up by hashing them
+                        const auto copy = mimir::formalism::create_atom(atom->predicate, atom->arguments);
+                        problem->get_rank(copy);
+                    }
+                });
+        }
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    void expect_unique_ranks(const mimir::formalism::ProblemDescription& problem, const std::vector<AtomKey>& keys)
+    {
+        std::vector<bool> is_ranked(problem->num_ranks(), false);
+
+        for (const auto& [predicate, argument_ids] : keys)
+        {
+            mimir::formalism::ObjectList arguments;
+
+            for (const auto object_id : argument_ids)
+            {
+                arguments.emplace_back(problem->get_object(object_id));
+            }
+
+            const auto atom = problem->create_atom(predicate, std::move(arguments));
+            const auto rank = problem->get_rank(atom);
+            ASSERT_LT(rank, problem->num_ranks());
+            ASSERT_FALSE(is_ranked[rank]);
+            is_ranked[rank] = true;
+
+            ASSERT_EQ(problem->get_atom(rank), atom);
+            ASSERT_EQ(problem->get_predicate_id(rank), predicate->id);
+            ASSERT_EQ(problem->get_arity(rank), argument_ids.size());
+            ASSERT_EQ(problem->get_argument_ids(rank), argument_ids);
+
+            // Every polarity has exactly one literal
+            const auto positive = problem->create_literal(atom, false);
+            const auto negative = problem->create_literal(atom, true);
+            ASSERT_EQ(problem->create_literal(atom, false), positive);
+            ASSERT_EQ(problem->create_literal(atom, true), negative);
+            ASSERT_NE(positive, negative);
+            ASSERT_EQ(positive->atom, atom);
+            ASSERT_TRUE(negative->negated);
+        }
+
+        // The atoms of the problem itself were ranked while parsing, so ranks are contiguous but not all of them belong to the keys
+        ASSERT_EQ(problem->get_encountered_atoms().size(), problem->num_ranks());
+    }
+
+    TEST(RankRegistry, Concurrent)
+    {
+        std::istringstream domain_stream(spider::domain);
+        std::istringstream problem_stream(spider::problem);
+
+        const auto domain = mimir::parsers::DomainParser::parse(domain_stream);
+        const auto problem = mimir::parsers::ProblemParser::parse(domain, "", problem_stream);
+        const auto num_initial_ranks = problem->num_ranks();
+
+        const auto keys = get_atom_keys(problem, std::min(static_cast<std::size_t>(24), problem->objects.size()));
+        rank_concurrently(problem, keys, 8);
+        expect_unique_ranks(problem, keys);
+        ASSERT_GE(problem->num_ranks(), keys.size());
+        ASSERT_LE(problem->num_ranks(), num_initial_ranks + keys.size());
+
+        // Freezing keeps all ranks, and atoms that are seen afterwards are still ranked uniquely
+
+        const auto num_ranks = problem->num_ranks();
+        problem->freeze_ranks();
+        ASSERT_EQ(problem->num_frozen_ranks(), num_ranks);
+        ASSERT_EQ(problem->num_ranks(), num_ranks);
+
+        const auto more_keys = get_atom_keys(problem, std::min(static_cast<std::size_t>(48), problem->objects.size()));
+        rank_concurrently(problem, more_keys, 8);
+        expect_unique_ranks(problem, more_keys);
+        ASSERT_EQ(problem->num_frozen_ranks(), num_ranks);
+        ASSERT_GE(problem->num_ranks(), num_ranks);
+    }
+}  // namespace test
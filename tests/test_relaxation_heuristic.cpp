@@ -0,0 +1,206 @@
+#include "../include/mimir/formalism/domain.hpp"
+#include "../include/mimir/formalism/problem.hpp"
+#include "../include/mimir/generators/complete_state_space.hpp"
+#include "../include/mimir/generators/grounded_successor_generator.hpp"
+#include "../include/mimir/generators/successor_generator_factory.hpp"
+#include "../include/mimir/pddl/parsers.hpp"
+#include "../include/mimir/search/heuristics/relaxation_heuristic.hpp"
+
+// Test instances
+
+#include "instances/blocks/domain.hpp"
+#include "instances/blocks/problem.hpp"
+#include "instances/gripper/domain.hpp"
+#include "instances/gripper/problem.hpp"
+#include "instances/spanner/domain.hpp"
+#include "instances/spanner/problem.hpp"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <limits>
+#include <sstream>
+#include <string>
+
+namespace test
+{
+    class RelaxationHeuristicTest : public testing::TestWithParam<std::tuple<std::string, std::string>>
+    {
+    };
+
+    // Computes h_max or h_add by applying all actions until the costs of the atoms no longer change
+
+    double get_reference_value(const mimir::formalism::ActionList& actions, const mimir::formalism::State& state, bool is_additive)
+    {
+        const auto problem = state->get_problem();
+        const auto infinity = std::numeric_limits<double>::infinity();
+        std::vector<double> costs(problem->num_ranks(), infinity);
+
+        for (const auto rank : state->get_ranks())
+        {
+            costs[rank] = 0.0;
+        }
+
+        const auto get_cost = [&problem, &costs, is_additive](const mimir::formalism::LiteralList& literals)
+        {
+            double cost = 0.0;
+
+            for (const auto& literal : literals)
+            {
+                if (!literal->negated)
+                {
+                    const auto literal_cost = costs[problem->get_rank(literal->atom)];
+                    cost = is_additive ? (cost + literal_cost) : std::max(cost, literal_cost);
+                }
+            }
+
+            return cost;
+        };
+
+        bool changed = true;
+
+        const auto update = [&problem, &costs, &changed](const mimir::formalism::LiteralList& literals, double cost)
+        {
+            for (const auto& literal : literals)
+            {
+                const auto rank = problem->get_rank(literal->atom);
+
+                if (!literal->negated && (cost < costs[rank]))
+                {
+                    costs[rank] = cost;
+                    changed = true;
+                }
+            }
+        };
+
+        while (changed)
+        {
+            changed = false;
+
+            for (const auto& action : actions)
+            {
+                const auto precondition_cost = get_cost(action->get_precondition());
+                update(action->get_unconditional_effect(), precondition_cost + action->cost);
+
+                for (const auto& [antecedent, consequence] : action->get_conditional_effect())
+                {
+                    const auto antecedent_cost = get_cost(antecedent);
+                    update(consequence, (is_additive ? (precondition_cost + antecedent_cost) : std::max(precondition_cost, antecedent_cost)) + action->cost);
+                }
+            }
+        }
+
+        mimir::formalism::LiteralList goal(problem->goal.begin(), problem->goal.end());
+        return get_cost(goal);
+    }
+
+    TEST_P(RelaxationHeuristicTest, Parameterized)
+    {
+        const auto domain_text = std::get<0>(GetParam());
+        const auto problem_text = std::get<1>(GetParam());
+
+        std::istringstream domain_stream(domain_text);
+        std::istringstream problem_stream(problem_text);
+
+        const auto domain = mimir::parsers::DomainParser::parse(domain_stream);
+        const auto problem = mimir::parsers::ProblemParser::parse(domain, "", problem_stream);
+
+        const auto successor_generator = mimir::planners::create_sucessor_generator(problem, mimir::planners::SuccessorGeneratorType::GROUNDED);
+        const auto grounded_generator = std::dynamic_pointer_cast<mimir::planners::GroundedSuccessorGenerator>(successor_generator);
+        const auto& actions = grounded_generator->get_actions();
+        const auto state_space = mimir::planners::create_complete_state_space(problem, successor_generator);
+
+        const auto hmax = mimir::planners::create_relaxation_heuristic(problem, successor_generator, mimir::planners::RelaxationType::MAX);
+        const auto hadd = mimir::planners::create_relaxation_heuristic(problem, successor_generator, mimir::planners::RelaxationType::ADD);
+        const auto hff = mimir::planners::create_relaxation_heuristic(problem, successor_generator, mimir::planners::RelaxationType::FF);
+
+        for (const auto& state : state_space->get_states())
+        {
+            const auto max_value = hmax->evaluate(state);
+            const auto add_value = hadd->evaluate(state);
+            const auto ff_value = hff->evaluate(state);
+
+            ASSERT_EQ(max_value, get_reference_value(actions, state, false));
+            ASSERT_EQ(add_value, get_reference_value(actions, state, true));
+
+            if (mimir::planners::HeuristicBase::is_dead_end(max_value))
+            {
+                ASSERT_TRUE(mimir::planners::HeuristicBase::is_dead_end(ff_value));
+                continue;
+            }
+
+            ASSERT_LE(max_value, ff_value);
+            ASSERT_LE(ff_value, add_value);
+
+            // The relaxed plan reaches the goal when its actions are applied without their delete effects
+
+            const auto& relaxed_plan = hff->get_relaxed_plan();
+            auto relaxed_state = state;
+            bool changed = true;
+
+            while (changed)
+            {
+                changed = false;
+
+                for (const auto action_index : relaxed_plan)
+                {
+                    const auto& action = actions[action_index];
+                    bool is_applicable = true;
+
+                    for (const auto& literal : action->get_precondition())
+                    {
+                        is_applicable &= literal->negated || mimir::formalism::is_in_state(problem->get_rank(literal->atom), relaxed_state);
+                    }
+
+                    if (is_applicable)
+                    {
+                        auto ranks = relaxed_state->get_ranks();
+                        const auto successor_ranks = mimir::formalism::apply(action, relaxed_state)->get_ranks();
+                        const auto num_ranks = ranks.size();
+                        ranks.insert(ranks.end(), successor_ranks.begin(), successor_ranks.end());
+                        std::sort(ranks.begin(), ranks.end());
+                        ranks.erase(std::unique(ranks.begin(), ranks.end()), ranks.end());
+
+                        if (ranks.size() > num_ranks)
+                        {
+                            mimir::formalism::AtomList atoms;
+
+                            for (const auto rank : ranks)
+                            {
+                                atoms.emplace_back(problem->get_atom(rank));
+                            }
+
+                            relaxed_state = mimir::formalism::create_state(atoms, problem);
+                            changed = true;
+                        }
+                    }
+                }
+            }
+
+            for (const auto& literal : problem->goal)
+            {
+                ASSERT_TRUE(mimir::formalism::is_in_state(problem->get_rank(literal->atom), relaxed_state));
+            }
+        }
+
+        // Batched evaluation yields the same values as evaluating the states one by one
+
+        const auto& states = state_space->get_states();
+
+        for (const auto& heuristic : { hmax, hadd, hff })
+        {
+            const auto values = heuristic->evaluate(states);
+            ASSERT_EQ(values.size(), states.size());
+
+            for (std::size_t index = 0; index < states.size(); ++index)
+            {
+                ASSERT_EQ(values[index], heuristic->evaluate(states[index]));
+            }
+        }
+    }
+
+    INSTANTIATE_TEST_SUITE_P(ParamTest,
+                             RelaxationHeuristicTest,
+                             testing::Values(std::make_tuple(blocks::domain, blocks::problem),
+                                             std::make_tuple(gripper::domain, gripper::problem),
+                                             std::make_tuple(spanner::domain, spanner::problem)));
+}  // namespace test
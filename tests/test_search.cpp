@@ -4,7 +4,18 @@
 #include "../include/mimir/generators/successor_generator.hpp"
 #include "../include/mimir/generators/successor_generator_factory.hpp"
 #include "../include/mimir/pddl/parsers.hpp"
+#include "../include/mimir/search/batched_astar_search.hpp"
+#include "../include/mimir/search/eager_astar_search.hpp"
 #include "../include/mimir/search/breadth_first_search.hpp"
+#include "../include/mimir/search/hda_star_search.hpp"
+#include "../include/mimir/search/heuristics/h1_heuristic.hpp"
+#include "../include/mimir/search/heuristics/relaxation_heuristic.hpp"
+#include "../include/mimir/search/lazy_best_first_search.hpp"
+#include "../include/mimir/search/openlists/alternation_open_list.hpp"
+#include "../include/mimir/search/openlists/bucket_open_list.hpp"
+#include "../include/mimir/search/openlists/indexed_heap_open_list.hpp"
+#include "../include/mimir/search/openlists/priority_queue_open_list.hpp"
+#include "../include/mimir/search/openlists/tie_breaking_open_list.hpp"
 
 // Test instances
 
@@ -19,7 +30,10 @@
 
 #include <gtest/gtest.h>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace test
 {
@@ -71,6 +85,199 @@ namespace test
         ASSERT_EQ(plan.size(), plan_length);
     }
 
+    TEST_P(SearchTest, EagerAStar)
+    {
+        const auto domain_text = std::get<0>(GetParam());
+        const auto problem_text = std::get<1>(GetParam());
+        const auto plan_length = std::get<4>(GetParam());
+
+        std::istringstream domain_stream(domain_text);
+        std::istringstream problem_stream(problem_text);
+
+        const auto domain = mimir::parsers::DomainParser::parse(domain_stream);
+        const auto problem = mimir::parsers::ProblemParser::parse(domain, "", problem_stream);
+
+        const auto successor_generator = mimir::planners::create_sucessor_generator(problem, mimir::planners::SuccessorGeneratorType::GROUNDED);
+        const auto heuristic = mimir::planners::create_h1_heuristic(problem, successor_generator);
+
+        // Updating open states in place must find plans that are as cheap as with duplicate entries
+
+        for (const auto use_decrease_key : { false, true })
+        {
+            const auto open_list = use_decrease_key ? mimir::planners::OpenList(mimir::planners::create_indexed_heap_open_list()) :
+                                                      mimir::planners::OpenList(mimir::planners::create_priority_queue_open_list());
+            const auto search = mimir::planners::create_eager_astar(problem, successor_generator, heuristic, open_list);
+
+            mimir::formalism::ActionList plan;
+            const auto result = search->plan(plan);
+            ASSERT_EQ(result, mimir::planners::SearchResult::SOLVED);
+            ASSERT_EQ(plan.size(), plan_length);
+            ASSERT_EQ(open_list->supports_decrease_key(), use_decrease_key);
+        }
+
+        // An alternation leaves popped items in the other sub-lists, so it only takes sub-lists that allow duplicates
+
+        ASSERT_THROW(mimir::planners::create_alternation_open_list(
+                         { mimir::planners::create_priority_queue_open_list(), mimir::planners::create_indexed_heap_open_list() }),
+                     std::invalid_argument);
+
+        const auto alternation_open_list = mimir::planners::create_alternation_open_list(
+            { mimir::planners::create_priority_queue_open_list(), mimir::planners::create_bucket_open_list() });
+        const auto search = mimir::planners::create_eager_astar(problem, successor_generator, heuristic, alternation_open_list);
+
+        mimir::formalism::ActionList plan;
+        ASSERT_EQ(search->plan(plan), mimir::planners::SearchResult::SOLVED);
+        ASSERT_EQ(plan.size(), plan_length);
+    }
+
+    TEST_P(SearchTest, BatchedAStar)
+    {
+        const auto domain_text = std::get<0>(GetParam());
+        const auto problem_text = std::get<1>(GetParam());
+        const auto plan_length = std::get<4>(GetParam());
+
+        std::istringstream domain_stream(domain_text);
+        std::istringstream problem_stream(problem_text);
+
+        const auto domain = mimir::parsers::DomainParser::parse(domain_stream);
+        const auto problem = mimir::parsers::ProblemParser::parse(domain, "", problem_stream);
+
+        const auto successor_generator = mimir::planners::create_sucessor_generator(problem, mimir::planners::SuccessorGeneratorType::GROUNDED);
+        const auto heuristic = mimir::planners::create_h1_heuristic(problem, successor_generator);
+
+        // Pipelined searches expand states before all successors are evaluated, the plan must still be optimal
+
+        for (const std::size_t batch_size : { 0, 1, 4, 64 })
+        {
+            const auto open_list = (batch_size == 1) ? mimir::planners::OpenList(mimir::planners::create_bucket_open_list()) :
+                                   (batch_size == 4) ? mimir::planners::OpenList(mimir::planners::create_tie_breaking_open_list()) :
+                                   (batch_size == 64) ? mimir::planners::OpenList(mimir::planners::create_indexed_heap_open_list()) :
+                                                        mimir::planners::OpenList(mimir::planners::create_priority_queue_open_list());
+            const auto search = mimir::planners::create_batched_astar(problem, successor_generator, heuristic, open_list, batch_size);
+
+            mimir::formalism::ActionList plan;
+            const auto result = search->plan(plan);
+            ASSERT_EQ(result, mimir::planners::SearchResult::SOLVED);
+            ASSERT_EQ(plan.size(), plan_length);
+
+            const auto statistics = search->get_statistics();
+            ASSERT_LE(std::get<int32_t>(statistics.at("batches")), std::get<int32_t>(statistics.at("evaluated")));
+        }
+    }
+
+    TEST_P(SearchTest, HDAStar)
+    {
+        const auto domain_text = std::get<0>(GetParam());
+        const auto problem_text = std::get<1>(GetParam());
+        const auto plan_length = std::get<4>(GetParam());
+
+        std::istringstream domain_stream(domain_text);
+        std::istringstream problem_stream(problem_text);
+
+        const auto domain = mimir::parsers::DomainParser::parse(domain_stream);
+        const auto problem = mimir::parsers::ProblemParser::parse(domain, "", problem_stream);
+
+        const auto successor_generator = mimir::planners::create_sucessor_generator(problem, mimir::planners::SuccessorGeneratorType::GROUNDED);
+
+        // States are expanded out of order across the workers, the plan must still be optimal
+
+        for (const std::size_t num_workers : { 1, 2, 4 })
+        {
+            std::vector<mimir::planners::Heuristic> heuristics;
+
+            for (std::size_t worker_index = 0; worker_index < num_workers; ++worker_index)
+            {
+                heuristics.emplace_back(mimir::planners::create_h1_heuristic(problem, successor_generator));
+            }
+
+            const auto search = mimir::planners::create_hda_star(problem, successor_generator, heuristics);
+
+            mimir::formalism::ActionList plan;
+            const auto result = search->plan(plan);
+            ASSERT_EQ(result, mimir::planners::SearchResult::SOLVED);
+            ASSERT_EQ(plan.size(), plan_length);
+
+            auto state = mimir::formalism::create_state(problem->initial, problem);
+
+            for (const auto& action : plan)
+            {
+                ASSERT_TRUE(mimir::formalism::is_applicable(action, state));
+                state = mimir::formalism::apply(action, state);
+            }
+
+            ASSERT_TRUE(mimir::formalism::literals_hold(problem->goal, state));
+
+            const auto statistics = search->get_statistics();
+            ASSERT_EQ(std::get<int32_t>(statistics.at("workers")), static_cast<int32_t>(num_workers));
+            ASSERT_EQ(std::get<int32_t>(statistics.at("sent")) > 0, num_workers > 1);
+        }
+
+        // Handlers run on the calling thread, which stops the search when they abort it
+
+        const auto search =
+            mimir::planners::create_hda_star(problem, successor_generator, { mimir::planners::create_h1_heuristic(problem, successor_generator) });
+        search->register_handler([&search]() { search->abort(); });
+
+        mimir::formalism::ActionList plan;
+        ASSERT_EQ(search->plan(plan), mimir::planners::SearchResult::ABORTED);
+    }
+
+    TEST_P(SearchTest, LazyBestFirstSearch)
+    {
+        const auto domain_text = std::get<0>(GetParam());
+        const auto problem_text = std::get<1>(GetParam());
+
+        std::istringstream domain_stream(domain_text);
+        std::istringstream problem_stream(problem_text);
+
+        const auto domain = mimir::parsers::DomainParser::parse(domain_stream);
+        const auto problem = mimir::parsers::ProblemParser::parse(domain, "", problem_stream);
+
+        const auto successor_generator = mimir::planners::create_sucessor_generator(problem, mimir::planners::SuccessorGeneratorType::GROUNDED);
+        const auto heuristic = mimir::planners::create_relaxation_heuristic(problem, successor_generator, mimir::planners::RelaxationType::FF);
+
+        // Without preferred operators every transition is inserted once, so an indexed heap can be the open list
+
+        const std::vector<std::pair<bool, bool>> configurations { { false, false }, { true, false }, { false, true } };
+
+        for (const auto& [use_decrease_key, use_preferred_actions] : configurations)
+        {
+            const auto open_list = use_decrease_key ? mimir::planners::OpenList(mimir::planners::create_indexed_heap_open_list()) :
+                                                      mimir::planners::OpenList(mimir::planners::create_priority_queue_open_list());
+            const auto preferred_open_list = use_preferred_actions ? mimir::planners::create_priority_queue_open_list() : nullptr;
+            const auto search = mimir::planners::create_lazy_best_first_search(problem, successor_generator, heuristic, open_list, preferred_open_list);
+
+            mimir::formalism::ActionList plan;
+            const auto result = search->plan(plan);
+            ASSERT_EQ(result, mimir::planners::SearchResult::SOLVED);
+
+            // Every action of the plan is applicable, and the last state is a goal state
+
+            auto state = mimir::formalism::create_state(problem->initial, problem);
+
+            for (const auto& action : plan)
+            {
+                ASSERT_TRUE(mimir::formalism::is_applicable(action, state));
+                state = mimir::formalism::apply(action, state);
+            }
+
+            ASSERT_TRUE(mimir::formalism::literals_hold(problem->goal, state));
+
+            const auto statistics = search->get_statistics();
+            ASSERT_LE(std::get<int32_t>(statistics.at("evaluated")), std::get<int32_t>(statistics.at("generated")) + 1);
+            ASSERT_EQ(std::get<int32_t>(statistics.at("preferred")) > 0, use_preferred_actions);
+        }
+
+        // Transitions by preferred operators are popped from both lists
+
+        ASSERT_THROW(mimir::planners::create_lazy_best_first_search(problem,
+                                                                    successor_generator,
+                                                                    heuristic,
+                                                                    mimir::planners::create_indexed_heap_open_list(),
+                                                                    mimir::planners::create_priority_queue_open_list()),
+                     std::invalid_argument);
+    }
+
     INSTANTIATE_TEST_SUITE_P(
         ParamTest,
         SearchTest,
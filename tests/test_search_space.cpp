@@ -0,0 +1,118 @@
+#include "../include/mimir/formalism/domain.hpp"
+#include "../include/mimir/formalism/problem.hpp"
+#include "../include/mimir/formalism/state_repository.hpp"
+#include "../include/mimir/generators/grounded_successor_generator.hpp"
+#include "../include/mimir/generators/successor_generator.hpp"
+#include "../include/mimir/generators/successor_generator_factory.hpp"
+#include "../include/mimir/pddl/parsers.hpp"
+#include "../include/mimir/search/search_space.hpp"
+
+// Test instances
+
+#include "instances/blocks/domain.hpp"
+#include "instances/blocks/problem.hpp"
+#include "instances/gripper/domain.hpp"
+#include "instances/gripper/problem.hpp"
+#include "instances/spanner/domain.hpp"
+#include "instances/spanner/problem.hpp"
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+
+namespace test
+{
+    class SearchSpaceTest : public testing::TestWithParam<std::tuple<std::string, std::string>>
+    {
+    };
+
+    TEST_P(SearchSpaceTest, Parameterized)
+    {
+        const auto domain_text = std::get<0>(GetParam());
+        const auto problem_text = std::get<1>(GetParam());
+
+        std::istringstream domain_stream(domain_text);
+        std::istringstream problem_stream(problem_text);
+
+        const auto domain = mimir::parsers::DomainParser::parse(domain_stream);
+        const auto problem = mimir::parsers::ProblemParser::parse(domain, "", problem_stream);
+
+        const auto successor_generator = mimir::planners::create_sucessor_generator(problem, mimir::planners::SuccessorGeneratorType::GROUNDED);
+        const auto grounded_generator = std::dynamic_pointer_cast<mimir::planners::GroundedSuccessorGenerator>(successor_generator);
+        const auto state_repository = mimir::formalism::create_state_repository(problem);
+        const auto search_space = mimir::planners::create_search_space();
+
+        // Build the breadth-first search tree of the state space
+
+        const auto initial_state = mimir::formalism::create_state(problem->initial, problem);
+        mimir::formalism::StateId initial_id;
+        state_repository->insert(initial_state, initial_id);
+        search_space->add_root_node(initial_id);
+
+        for (mimir::formalism::StateId id = 0; id < state_repository->size(); ++id)
+        {
+            const auto state = state_repository->get_state(id);
+            search_space->set_closed(id, true);
+
+            for (const auto& action : successor_generator->get_applicable_actions(state))
+            {
+                mimir::formalism::StateId successor_id;
+
+                if (state_repository->insert(mimir::formalism::apply(action, state), successor_id))
+                {
+                    search_space->add_node(successor_id, id, action, search_space->get_g_value(id) + static_cast<float>(action->cost));
+                }
+            }
+        }
+
+        ASSERT_EQ(search_space->size(), state_repository->size());
+        ASSERT_GT(search_space->memory_usage(), 0);
+
+        // The plan of every node leads from the initial state to the state of the node
+
+        for (mimir::formalism::StateId id = 0; id < search_space->size(); ++id)
+        {
+            ASSERT_TRUE(search_space->is_closed(id));
+            ASSERT_FALSE(search_space->is_evaluated(id));
+
+            const auto plan = search_space->get_plan(id);
+            ASSERT_EQ(plan.size(), search_space->get_depth(id));
+            ASSERT_EQ((id == initial_id), (search_space->get_parent_id(id) == mimir::planners::SearchSpaceImpl::no_id));
+            ASSERT_EQ((id == initial_id), (search_space->get_action(id) == nullptr));
+
+            auto state = initial_state;
+
+            for (const auto& action : plan)
+            {
+                ASSERT_TRUE(mimir::formalism::is_applicable(action, state));
+                state = mimir::formalism::apply(action, state);
+            }
+
+            ASSERT_TRUE(std::equal_to<mimir::formalism::State>()(state, state_repository->get_state(id)));
+        }
+
+        // Actions are interned once
+
+        for (const auto& action : grounded_generator->get_actions())
+        {
+            const auto action_id = search_space->get_action_id(action);
+            ASSERT_LT(action_id, grounded_generator->get_actions().size());
+            ASSERT_EQ(search_space->get_action_id(action), action_id);
+            ASSERT_EQ(search_space->get_action_by_id(action_id), action);
+        }
+
+        search_space->set_h_value(initial_id, 2.0);
+        ASSERT_TRUE(search_space->is_evaluated(initial_id));
+        ASSERT_TRUE(search_space->is_closed(initial_id));
+        ASSERT_EQ(search_space->get_h_value(initial_id), 2.0f);
+
+        search_space->clear();
+        ASSERT_EQ(search_space->size(), 0);
+    }
+
+    INSTANTIATE_TEST_SUITE_P(ParamTest,
+                             SearchSpaceTest,
+                             testing::Values(std::make_tuple(blocks::domain, blocks::problem),
+                                             std::make_tuple(gripper::domain, gripper::problem),
+                                             std::make_tuple(spanner::domain, spanner::problem)));
+}  // namespace test
@@ -0,0 +1,92 @@
+#include "../include/mimir/formalism/domain.hpp"
+#include "../include/mimir/formalism/problem.hpp"
+#include "../include/mimir/formalism/state_repository.hpp"
+#include "../include/mimir/generators/complete_state_space.hpp"
+#include "../include/mimir/generators/successor_generator.hpp"
+#include "../include/mimir/generators/successor_generator_factory.hpp"
+#include "../include/mimir/pddl/parsers.hpp"
+
+// Test instances
+
+#include "instances/blocks/domain.hpp"
+#include "instances/blocks/problem.hpp"
+#include "instances/gripper/domain.hpp"
+#include "instances/gripper/problem.hpp"
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+
+namespace test
+{
+    class StateRepositoryTest : public testing::TestWithParam<std::tuple<std::string, std::string>>
+    {
+    };
+
+    TEST_P(StateRepositoryTest, Parameterized)
+    {
+        const auto domain_text = std::get<0>(GetParam());
+        const auto problem_text = std::get<1>(GetParam());
+
+        std::istringstream domain_stream(domain_text);
+        std::istringstream problem_stream(problem_text);
+
+        const auto domain = mimir::parsers::DomainParser::parse(domain_stream);
+        const auto problem = mimir::parsers::ProblemParser::parse(domain, "", problem_stream);
+
+        const auto successor_generator = mimir::planners::create_sucessor_generator(problem, mimir::planners::SuccessorGeneratorType::GROUNDED);
+        const auto state_space = mimir::planners::create_complete_state_space(problem, successor_generator);
+        const auto& states = state_space->get_states();
+
+        // A chunk size of one block forces the states to be spread over many chunks
+        mimir::formalism::StateRepositoryImpl state_repository(problem, 1);
+
+        for (std::size_t index = 0; index < states.size(); ++index)
+        {
+            mimir::formalism::StateId state_id;
+            ASSERT_TRUE(state_repository.insert(states[index], state_id));
+            ASSERT_EQ(state_id, index);
+        }
+
+        ASSERT_EQ(state_repository.size(), states.size());
+
+        // States larger than the chunk size get chunks of their own, which must be counted as well
+
+        std::size_t num_blocks = 0;
+
+        for (std::size_t index = 0; index < states.size(); ++index)
+        {
+            num_blocks += state_repository.get_num_blocks(static_cast<mimir::formalism::StateId>(index));
+        }
+
+        ASSERT_GE(state_repository.memory_usage(), num_blocks * sizeof(std::size_t));
+
+        for (std::size_t index = 0; index < states.size(); ++index)
+        {
+            mimir::formalism::StateId state_id;
+            ASSERT_FALSE(state_repository.insert(states[index], state_id));
+            ASSERT_EQ(state_id, index);
+            ASSERT_TRUE(state_repository.find(states[index], state_id));
+            ASSERT_EQ(state_id, index);
+
+            const auto state = state_repository.get_state(state_id);
+            ASSERT_TRUE(std::equal_to<mimir::formalism::State>()(state, states[index]));
+            ASSERT_EQ(std::hash<mimir::formalism::State>()(state), std::hash<mimir::formalism::State>()(states[index]));
+            ASSERT_EQ(mimir::formalism::StateRepositoryImpl::hash(state_repository.get_blocks(state_id), state_repository.get_num_blocks(state_id)),
+                      states[index]->hash());
+            ASSERT_EQ(state_space->get_unique_index_of_state(state), index);
+        }
+
+        ASSERT_EQ(state_repository.size(), states.size());
+
+        state_repository.clear();
+        ASSERT_EQ(state_repository.size(), 0);
+
+        mimir::formalism::StateId state_id;
+        ASSERT_FALSE(state_repository.find(states.front(), state_id));
+    }
+
+    INSTANTIATE_TEST_SUITE_P(ParamTest,
+                             StateRepositoryTest,
+                             testing::Values(std::make_tuple(blocks::domain, blocks::problem), std::make_tuple(gripper::domain, gripper::problem)));
+}  // namespace test